@@ -8,6 +8,9 @@ endif()
 if (VI_BINDINGS)
     target_compile_definitions(vitex PUBLIC -DVI_BINDINGS)
 endif()
+if (VI_URING AND CMAKE_SYSTEM_NAME STREQUAL "Linux")
+    target_compile_definitions(vitex PUBLIC -DVI_URING)
+endif()
 if (VI_BACKWARDCPP)
     target_compile_definitions(vitex PUBLIC -DVI_BACKWARDCPP)
     target_include_directories(vitex PRIVATE ${CMAKE_CURRENT_LIST_DIR}/backward-cpp)
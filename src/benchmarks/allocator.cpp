@@ -0,0 +1,103 @@
+#include <vitex/vitex.h>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace vitex::core;
+using namespace vitex::core::allocators;
+
+struct workload
+{
+	std::mutex mutex;
+	std::vector<std::vector<void*>> exchange;
+	size_t operations = 0;
+	size_t slots = 0;
+	size_t round = 0;
+};
+
+static uint64_t next_random(uint64_t& seed)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+static void run_storm(global_allocator* allocator, workload* data, size_t seed_index)
+{
+	uint64_t seed = 0x9E3779B97F4A7C15ull * (seed_index + 1);
+	std::vector<void*> slots(data->slots, nullptr);
+	for (size_t i = 0; i < data->operations; i++)
+	{
+		void*& slot = slots[next_random(seed) % slots.size()];
+		if (slot != nullptr)
+			allocator->free(slot);
+
+		size_t size = 16 + next_random(seed) % 496;
+		slot = allocator->allocate(size);
+		memset(slot, (int)i, std::min<size_t>(size, 64));
+		if ((i + 1) % data->round != 0)
+			continue;
+
+		std::unique_lock<std::mutex> unique(data->mutex);
+		data->exchange.push_back(std::move(slots));
+		size_t index = next_random(seed) % data->exchange.size();
+		slots = std::move(data->exchange[index]);
+		data->exchange[index] = std::move(data->exchange.back());
+		data->exchange.pop_back();
+	}
+
+	for (auto* slot : slots)
+	{
+		if (slot != nullptr)
+			allocator->free(slot);
+	}
+}
+static double run_mode(global_allocator* allocator, size_t threads, size_t operations, size_t slots, size_t round)
+{
+	workload data;
+	data.operations = operations / threads;
+	data.slots = slots;
+	data.round = round;
+
+	std::vector<std::thread> workers;
+	workers.reserve(threads);
+	auto time = std::chrono::high_resolution_clock::now();
+	for (size_t i = 0; i < threads; i++)
+		workers.emplace_back(run_storm, allocator, &data, i);
+	for (auto& worker : workers)
+		worker.join();
+
+	double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - time).count();
+	for (auto& items : data.exchange)
+	{
+		for (auto* slot : items)
+		{
+			if (slot != nullptr)
+				allocator->free(slot);
+		}
+	}
+	return milliseconds;
+}
+
+int main(int argc, char* argv[])
+{
+	size_t max_threads = argc > 1 ? (size_t)std::atoll(argv[1]) : 64;
+	size_t operations = argc > 2 ? (size_t)std::atoll(argv[2]) : 4000000;
+	size_t slots = argc > 3 ? (size_t)std::atoll(argv[3]) : 1024;
+	size_t round = argc > 4 ? (size_t)std::atoll(argv[4]) : 4096;
+	vitex::runtime scope(0);
+	printf("operations: %zu, live blocks per thread: %zu, exchange every: %zu\n", operations, slots, round);
+
+	default_allocator standard;
+	cached_allocator cached;
+	slab_allocator slab;
+	std::pair<const char*, global_allocator*> allocators[] = { { "default", &standard }, { "cached", &cached }, { "slab", &slab } };
+	for (size_t threads = 1; threads <= max_threads; threads *= 2)
+	{
+		for (auto& [name, allocator] : allocators)
+		{
+			double milliseconds = run_mode(allocator, threads, operations, slots, std::max<size_t>(1, round));
+			printf("%-8s %3zu threads %9.2f ms %12.0f ops/s\n", name, threads, milliseconds, (operations / threads) * threads * 1000.0 / std::max(milliseconds, 0.001));
+		}
+	}
+	return 0;
+}
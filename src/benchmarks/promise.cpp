@@ -0,0 +1,110 @@
+#include <vitex/vitex.h>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace vitex::core;
+
+template <typename f>
+static void measure(const char* name, size_t count, f&& callback)
+{
+	auto time = std::chrono::high_resolution_clock::now();
+	size_t checksum = callback(count);
+	double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - time).count();
+	printf("%-24s %10zu ops %10.1f ns/op (checksum %zu)\n", name, count, nanoseconds / std::max<size_t>(1, count), checksum);
+}
+static size_t run_ready(size_t count)
+{
+	size_t checksum = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		promise<size_t> value(i);
+		checksum += value.get();
+	}
+	return checksum;
+}
+static size_t run_resolve(size_t count)
+{
+	size_t checksum = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		promise<size_t> value;
+		value.set(i);
+		checksum += value.get();
+	}
+	return checksum;
+}
+static size_t run_then(size_t count)
+{
+	size_t checksum = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		promise<size_t> value;
+		auto next = value.then<size_t>([](size_t&& result) { return result + 1; });
+		value.set(i);
+		checksum += next.get();
+	}
+	return checksum;
+}
+#ifdef VI_CXX20
+static promise<size_t> await_value(promise<size_t>* value)
+{
+	size_t result = co_await *value;
+	co_return result + 1;
+}
+static size_t run_await(size_t count)
+{
+	size_t checksum = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		promise<size_t> value;
+		auto next = await_value(&value);
+		value.set(i);
+		checksum += next.get();
+	}
+	return checksum;
+}
+#endif
+static size_t run_blocking(size_t count)
+{
+	std::atomic<promise<size_t>*> pending = nullptr;
+	std::atomic<bool> active = true;
+	std::thread resolver([&pending, &active]()
+	{
+		size_t index = 0;
+		while (active.load())
+		{
+			auto* value = pending.exchange(nullptr);
+			if (value != nullptr)
+				value->set(index++);
+			else
+				std::this_thread::yield();
+		}
+	});
+
+	size_t checksum = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		promise<size_t> value;
+		value.when([](size_t&&) { });
+		pending = &value;
+		checksum += value.get();
+	}
+
+	active = false;
+	resolver.join();
+	return checksum;
+}
+
+int main(int argc, char* argv[])
+{
+	size_t count = argc > 1 ? (size_t)std::atoll(argv[1]) : 1000000;
+	vitex::runtime scope(0);
+	measure("ready + get", count, run_ready);
+	measure("create + set + get", count, run_resolve);
+	measure("then + set + get", count, run_then);
+#ifdef VI_CXX20
+	measure("co_await + set + get", count, run_await);
+#endif
+	measure("when + cross-thread get", std::max<size_t>(1, count / 100), run_blocking);
+	return 0;
+}
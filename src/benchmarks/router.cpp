@@ -0,0 +1,127 @@
+#include <vitex/vitex.h>
+#include <vitex/network/http.h>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace vitex::core;
+using namespace vitex::network;
+using namespace vitex::compute;
+
+static http::router_group* build_routes(http::map_router* router, size_t count, size_t wildcard_step)
+{
+	auto* group = router->group("", http::route_mode::start);
+	for (size_t i = 0; i < count; i++)
+	{
+		if (wildcard_step > 0 && i % wildcard_step == wildcard_step - 1)
+		{
+			router->route(stringify::text("(admin|root)%i", (int)i), group, nullptr);
+			continue;
+		}
+
+		switch (i % 4)
+		{
+			case 0:
+				router->route(stringify::text("^/api/v%i/users%i/(\\d+)$", (int)(i % 3 + 1), (int)i), group, nullptr);
+				break;
+			case 1:
+				router->route(stringify::text("^/static/bundle%i/", (int)i), group, nullptr);
+				break;
+			case 2:
+				router->route(stringify::text("/report%i\\.json$", (int)i), group, nullptr);
+				break;
+			default:
+				router->route(stringify::text("^/files%i/(upload|download)$", (int)i), group, nullptr);
+				break;
+		}
+	}
+
+	router->sort();
+	return group;
+}
+static vector<string> build_locations(size_t count, size_t wildcard_step)
+{
+	vector<string> locations;
+	locations.reserve(count + count / 4);
+	for (size_t i = 0; i < count; i++)
+	{
+		if (wildcard_step > 0 && i % wildcard_step == wildcard_step - 1)
+		{
+			locations.push_back(stringify::text("/panel/admin%i", (int)i));
+			continue;
+		}
+
+		switch (i % 4)
+		{
+			case 0:
+				locations.push_back(stringify::text("/api/v%i/users%i/%i", (int)(i % 3 + 1), (int)i, (int)(i * 7)));
+				break;
+			case 1:
+				locations.push_back(stringify::text("/static/bundle%i/app.js", (int)i));
+				break;
+			case 2:
+				locations.push_back(stringify::text("/data/report%i.json", (int)i));
+				break;
+			default:
+				locations.push_back(stringify::text("/files%i/upload", (int)i));
+				break;
+		}
+	}
+
+	for (size_t i = 0; i < count / 4; i++)
+		locations.push_back(stringify::text("/missing/path%i/index.html", (int)i));
+	return locations;
+}
+static http::router_entry* find_linear(http::router_group* group, regex_result& result, const std::string_view& location)
+{
+	for (auto* next : group->routes)
+	{
+		if (regex::match(&next->location, result, location))
+			return next;
+	}
+
+	return nullptr;
+}
+
+int main(int argc, char* argv[])
+{
+	size_t count = argc > 1 ? (size_t)std::atoll(argv[1]) : 1000;
+	size_t passes = argc > 2 ? (size_t)std::atoll(argv[2]) : 5;
+	size_t wildcard_step = argc > 3 ? (size_t)std::atoll(argv[3]) : 0;
+	vitex::runtime scope(0);
+
+	auto* router = new http::map_router();
+	auto* group = build_routes(router, count, wildcard_step);
+	auto locations = build_locations(count, wildcard_step);
+
+	regex_result result;
+	size_t mismatches = 0;
+	for (auto& location : locations)
+	{
+		if (group->find(result, location) != find_linear(group, result, location))
+			++mismatches;
+	}
+
+	size_t linear_hits = 0, trie_hits = 0;
+	auto time = std::chrono::high_resolution_clock::now();
+	for (size_t pass = 0; pass < passes; pass++)
+	{
+		for (auto& location : locations)
+			linear_hits += find_linear(group, result, location) != nullptr;
+	}
+	double linear_time = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - time).count();
+
+	time = std::chrono::high_resolution_clock::now();
+	for (size_t pass = 0; pass < passes; pass++)
+	{
+		for (auto& location : locations)
+			trie_hits += group->find(result, location) != nullptr;
+	}
+	double trie_time = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - time).count();
+
+	size_t lookups = locations.size() * passes;
+	printf("routes: %zu, unindexed routes: %zu, locations: %zu, passes: %zu, mismatches: %zu\n", group->routes.size(), wildcard_step > 0 ? count / wildcard_step : 0, locations.size(), passes, mismatches);
+	printf("%-12s %9.2f ms %10.0f ns/lookup (hits %zu)\n", "linear-scan", linear_time, linear_time * 1000000.0 / std::max<size_t>(1, lookups), linear_hits);
+	printf("%-12s %9.2f ms %10.0f ns/lookup (hits %zu)\n", "radix-trie", trie_time, trie_time * 1000000.0 / std::max<size_t>(1, lookups), trie_hits);
+	memory::release(router);
+	return mismatches > 0 ? 1 : 0;
+}
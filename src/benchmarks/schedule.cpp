@@ -0,0 +1,82 @@
+#include <vitex/vitex.h>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace vitex::core;
+
+struct workload
+{
+	std::atomic<size_t> completed = 0;
+	size_t total = 0;
+	size_t fanout = 0;
+};
+
+static void spawn_tree(workload* data, size_t depth)
+{
+	if (depth > 0)
+	{
+		for (size_t i = 0; i < data->fanout; i++)
+			schedule::get()->set_task([data, depth]() { spawn_tree(data, depth - 1); });
+	}
+	++data->completed;
+}
+static double run_fanout(size_t depth, size_t fanout)
+{
+	workload data;
+	data.fanout = fanout;
+	for (size_t i = 0, level = 1; i <= depth; i++, level *= fanout)
+		data.total += level;
+
+	auto time = std::chrono::high_resolution_clock::now();
+	schedule::get()->set_task([&data, depth]() { spawn_tree(&data, depth); });
+	while (data.completed.load() < data.total)
+		std::this_thread::yield();
+
+	return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - time).count();
+}
+static double run_submit(size_t count)
+{
+	workload data;
+	data.total = count;
+
+	auto time = std::chrono::high_resolution_clock::now();
+	for (size_t i = 0; i < count; i++)
+		schedule::get()->set_task([&data]() { ++data.completed; });
+	while (data.completed.load() < data.total)
+		std::this_thread::yield();
+
+	return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - time).count();
+}
+static void run_mode(bool work_stealing, size_t threads, size_t depth, size_t fanout, size_t count)
+{
+	schedule::desc policy(threads);
+	policy.work_stealing = work_stealing;
+
+	auto* queue = schedule::get();
+	queue->start(policy);
+	double fanout_time = run_fanout(depth, fanout);
+	double submit_time = run_submit(count);
+	queue->stop();
+
+	size_t total = 0;
+	for (size_t i = 0, level = 1; i <= depth; i++, level *= fanout)
+		total += level;
+
+	printf("%-14s fanout: %8zu tasks %9.2f ms %10.0f tasks/s | submit: %8zu tasks %9.2f ms %10.0f tasks/s\n",
+		work_stealing ? "work-stealing" : "shared-queue",
+		total, fanout_time, total * 1000.0 / std::max(fanout_time, 0.001),
+		count, submit_time, count * 1000.0 / std::max(submit_time, 0.001));
+}
+
+int main(int argc, char* argv[])
+{
+	size_t threads = argc > 1 ? (size_t)std::atoll(argv[1]) : std::max<size_t>(2, std::thread::hardware_concurrency());
+	size_t depth = argc > 2 ? (size_t)std::atoll(argv[2]) : 6;
+	size_t fanout = argc > 3 ? (size_t)std::atoll(argv[3]) : 8;
+	size_t count = argc > 4 ? (size_t)std::atoll(argv[4]) : 1000000;
+	vitex::runtime scope(0);
+	printf("threads: %zu, fanout depth: %zu, fanout width: %zu\n", threads, depth, fanout);
+	run_mode(false, threads, depth, fanout, count);
+	run_mode(true, threads, depth, fanout, count);
+	return 0;
+}
@@ -0,0 +1,148 @@
+#include <vitex/vitex.h>
+#include <vitex/network.h>
+#include <cstdio>
+#include <cstdlib>
+#ifdef VI_LINUX
+#include <sys/socket.h>
+#include <dlfcn.h>
+#endif
+
+using namespace vitex::core;
+using namespace vitex::network;
+
+static std::atomic<size_t> receives = 0;
+#ifdef VI_LINUX
+extern "C" ssize_t recv(int fd, void* buffer, size_t size, int flags)
+{
+	typedef ssize_t(*recv_function)(int, void*, size_t, int);
+	static recv_function next = (recv_function)dlsym(RTLD_NEXT, "recv");
+	receives.fetch_add(1, std::memory_order_relaxed);
+	return next(fd, buffer, size, flags);
+}
+#endif
+
+struct workload
+{
+	string payload;
+	size_t blocks = 0;
+};
+
+static workload build_payload(size_t blocks)
+{
+	workload data;
+	data.blocks = blocks;
+	for (size_t i = 0; i < blocks; i++)
+	{
+		data.payload.append(stringify::text("GET /api/v1/items/%i?page=%i HTTP/1.1\r\n", (int)i, (int)(i % 17)));
+		data.payload.append("Host: benchmark.local\r\nUser-Agent: vitex-benchmark/1.0\r\nAccept: application/json\r\nAccept-Encoding: gzip, deflate\r\nConnection: keep-alive\r\n\r\n");
+	}
+	return data;
+}
+static std::thread spawn_writer(socket_t fd, const workload& data)
+{
+	return std::thread([fd, &data]()
+	{
+		const char* buffer = data.payload.data();
+		size_t size = data.payload.size();
+		while (size > 0)
+		{
+			int written = (int)send(fd, buffer, size > 65536 ? 65536 : (int)size, 0);
+			if (written <= 0)
+				break;
+
+			buffer += written;
+			size -= (size_t)written;
+		}
+	});
+}
+static bool read_bytewise(socket_t fd, const std::string_view& match, size_t& bytes)
+{
+	size_t index = 0;
+	while (index < match.size())
+	{
+		char next;
+		if (recv(fd, &next, 1, 0) != 1)
+			return false;
+
+		++bytes;
+		index = (next == match[index] ? index + 1 : (next == match[0] ? 1 : 0));
+	}
+	return true;
+}
+static void report(const char* name, const workload& data, size_t parsed, size_t calls, double milliseconds)
+{
+	printf("%-10s %8zu blocks %9.2f ms %9.1f MB/s %10zu recv calls (%.3f per block)\n", name, parsed, milliseconds, data.payload.size() / 1048576.0 / std::max(milliseconds / 1000.0, 0.000001), calls, (double)calls / std::max<size_t>(1, parsed));
+}
+static bool open_pair(vitex::network::socket*& reader, vitex::network::socket*& writer)
+{
+	socket_t pair[2];
+	if (!utils::create_socket_pair(pair))
+		return false;
+
+	reader = new vitex::network::socket(pair[0]);
+	reader->set_blocking(true);
+	writer = new vitex::network::socket(pair[1]);
+	writer->set_blocking(true);
+	return true;
+}
+static void run_bytewise(const workload& data)
+{
+	vitex::network::socket* stream, *peer;
+	if (!open_pair(stream, peer))
+		return;
+
+	auto writer = spawn_writer(peer->get_fd(), data);
+	size_t bytes = 0, parsed = 0, calls = receives.load();
+	auto time = std::chrono::high_resolution_clock::now();
+	while (parsed < data.blocks && read_bytewise(stream->get_fd(), "\r\n\r\n", bytes))
+		++parsed;
+
+	double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - time).count();
+	writer.join();
+	report("bytewise", data, parsed, receives.load() - calls, milliseconds);
+	memory::release(stream);
+	memory::release(peer);
+}
+static void run_buffered(const workload& data)
+{
+	vitex::network::socket* stream, *peer;
+	if (!open_pair(stream, peer))
+		return;
+
+	auto writer = spawn_writer(peer->get_fd(), data);
+	size_t bytes = 0, parsed = 0, calls = receives.load();
+	auto time = std::chrono::high_resolution_clock::now();
+	while (parsed < data.blocks)
+	{
+		bool done = false;
+		auto status = stream->read_until("\r\n\r\n", [&bytes, &done](socket_poll event, const uint8_t*, size_t size)
+		{
+			bytes += size;
+			done = packet::is_done(event);
+			return true;
+		});
+		if (!status || !done)
+			break;
+		++parsed;
+	}
+
+	double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - time).count();
+	writer.join();
+	report("buffered", data, parsed, receives.load() - calls, milliseconds);
+	memory::release(stream);
+	memory::release(peer);
+}
+
+int main(int argc, char* argv[])
+{
+	size_t blocks = argc > 1 ? (size_t)std::atoll(argv[1]) : 20000;
+	vitex::runtime scope(0);
+	auto data = build_payload(blocks);
+	printf("header blocks: %zu, payload: %.2f MB\n", blocks, data.payload.size() / 1048576.0);
+#ifndef VI_LINUX
+	printf("recv calls are only counted on linux\n");
+#endif
+	run_bytewise(data);
+	run_buffered(data);
+	return 0;
+}
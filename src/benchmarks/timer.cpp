@@ -0,0 +1,84 @@
+#include <vitex/vitex.h>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace vitex::core;
+
+static double elapsed(const std::chrono::high_resolution_clock::time_point& time)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - time).count();
+}
+static void report(const char* name, size_t count, double milliseconds)
+{
+	printf("%-8s %9zu timers %10.2f ms %10.1f ns/op %12.0f ops/s\n", name, count, milliseconds, milliseconds * 1000000.0 / std::max<size_t>(1, count), count * 1000.0 / std::max(milliseconds, 0.001));
+}
+static double run_insert_cancel(size_t count)
+{
+	vector<task_id> timers;
+	timers.reserve(count);
+
+	uint64_t seed = 0x9e3779b97f4a7c15;
+	auto time = std::chrono::high_resolution_clock::now();
+	for (size_t i = 0; i < count; i++)
+	{
+		seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+		uint64_t delay = 60000 + (seed >> 33) % 3540000;
+		timers.push_back(schedule::get()->set_timeout(delay, []() { }));
+	}
+
+	double insertion = elapsed(time);
+	report("insert", count, insertion);
+
+	size_t cancelled = 0;
+	time = std::chrono::high_resolution_clock::now();
+	for (auto id : timers)
+		cancelled += schedule::get()->clear_timeout(id) ? 1 : 0;
+	report("cancel", cancelled, elapsed(time));
+	return insertion;
+}
+static void run_fire(size_t count, uint64_t window, double insertion)
+{
+	std::atomic<size_t> fired = 0;
+	std::atomic<int64_t> lateness = 0;
+	uint64_t base = (uint64_t)(insertion * 2.0) + 100;
+	auto start = schedule::get_clock();
+	for (size_t i = 0; i < count; i++)
+	{
+		uint64_t delay = base + (window > 0 ? i % window : 0);
+		auto deadline = start + std::chrono::milliseconds(delay);
+		schedule::get()->set_timeout(delay, [&fired, &lateness, deadline]()
+		{
+			int64_t late = (int64_t)(schedule::get_clock() - deadline).count();
+			int64_t last = lateness.load(std::memory_order_relaxed);
+			while (late > last && !lateness.compare_exchange_weak(last, late, std::memory_order_relaxed));
+			fired.fetch_add(1, std::memory_order_release);
+		});
+	}
+
+	auto armed = schedule::get_clock();
+	if (armed >= start + std::chrono::milliseconds(base))
+		printf("fire phase was armed after its first deadline, results are skewed\n");
+
+	while (fired.load(std::memory_order_acquire) < count)
+		std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+	double total = (double)(schedule::get_clock() - start - std::chrono::milliseconds(base)).count() / 1000.0;
+	report("fire", count, total);
+	printf("%-8s %9s first deadline after %" PRIu64 " ms, spread over %" PRIu64 " ms, max lateness %.2f ms\n", "", "", base, window, lateness.load() / 1000.0);
+}
+
+int main(int argc, char* argv[])
+{
+	size_t count = argc > 1 ? (size_t)std::atoll(argv[1]) : 1000000;
+	uint64_t window = argc > 2 ? (uint64_t)std::atoll(argv[2]) : 0;
+	size_t threads = argc > 3 ? (size_t)std::atoll(argv[3]) : std::max<size_t>(2, std::thread::hardware_concurrency());
+	vitex::runtime scope(0);
+
+	auto* queue = schedule::get();
+	queue->start(schedule::desc(threads));
+	printf("threads: %zu, pending timers: %zu\n", threads, count);
+	double insertion = run_insert_cancel(count);
+	run_fire(count, window, insertion);
+	queue->stop();
+	return 0;
+}
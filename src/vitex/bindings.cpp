@@ -10313,11 +10313,17 @@ namespace vitex
 				vdifficulty->set_value("sync", (int)core::difficulty::sync);
 				vdifficulty->set_value("timeout", (int)core::difficulty::timeout);
 
+				auto vaffinity = vm->set_enum("thread_affinity");
+				vaffinity->set_value("none", (int)core::schedule::thread_affinity::none);
+				vaffinity->set_value("per_core", (int)core::schedule::thread_affinity::per_core);
+				vaffinity->set_value("per_socket", (int)core::schedule::thread_affinity::per_socket);
+
 				auto vdesc = vm->set_struct_trivial<core::schedule::desc>("schedule_policy");
 				vdesc->set_property("usize preallocated_size", &core::schedule::desc::preallocated_size);
 				vdesc->set_property("usize stack_size", &core::schedule::desc::stack_size);
 				vdesc->set_property("usize max_coroutines", &core::schedule::desc::max_coroutines);
 				vdesc->set_property("usize max_recycles", &core::schedule::desc::max_recycles);
+				vdesc->set_property("thread_affinity affinity", &core::schedule::desc::affinity);
 				vdesc->set_property("bool parallel", &core::schedule::desc::parallel);
 				vdesc->set_constructor<core::schedule::desc>("void f()");
 				vdesc->set_constructor<core::schedule::desc, size_t>("void f(usize)");
@@ -10826,6 +10832,7 @@ namespace vitex
 				vsecure_layer_options->set_value("tls_v1_1", (int)network::secure_layer_options::no_tlsv11);
 				vsecure_layer_options->set_value("tls_v1_2", (int)network::secure_layer_options::no_tlsv11);
 				vsecure_layer_options->set_value("tls_v1_3", (int)network::secure_layer_options::no_tlsv11);
+				vsecure_layer_options->set_value("ktls", (int)network::secure_layer_options::ktls);
 
 				auto vserver_state = vm->set_enum("server_state");
 				vserver_state->set_value("working", (int)network::server_state::working);
@@ -10924,6 +10931,9 @@ namespace vitex
 				vsocket_certificate->set_property<network::socket_certificate>("string ciphers", &network::socket_certificate::ciphers);
 				vsocket_certificate->set_property<network::socket_certificate>("uptr@ context", &network::socket_certificate::context);
 				vsocket_certificate->set_property<network::socket_certificate>("secure_layer_options options", &network::socket_certificate::options);
+				vsocket_certificate->set_property<network::socket_certificate>("usize session_cache_size", &network::socket_certificate::session_cache_size);
+				vsocket_certificate->set_property<network::socket_certificate>("uint64 session_timeout", &network::socket_certificate::session_timeout);
+				vsocket_certificate->set_property<network::socket_certificate>("uint64 ticket_rotation", &network::socket_certificate::ticket_rotation);
 				vsocket_certificate->set_property<network::socket_certificate>("uint32 verify_peers", &network::socket_certificate::verify_peers);
 				vsocket_certificate->set_constructor<network::socket_certificate>("void f()");
 
@@ -10971,7 +10981,11 @@ namespace vitex
 				vsocket->set_method("bool is_awaiting_writeable() const", &network::socket::is_awaiting_writeable);
 				vsocket->set_method("bool is_awaiting_events() const", &network::socket::is_awaiting_events);
 				vsocket->set_method("bool is_valid() const", &network::socket::is_valid);
+				vsocket->set_method("bool is_reusable() const", &network::socket::is_reusable);
 				vsocket->set_method("bool is_secure() const", &network::socket::is_secure);
+				vsocket->set_method("bool is_send_offloaded() const", &network::socket::is_send_offloaded);
+				vsocket->set_method("bool is_receive_offloaded() const", &network::socket::is_receive_offloaded);
+				vsocket->set_method("string_view get_application_protocol() const", &network::socket::get_application_protocol);
 				vsocket->set_method("void set_io_timeout(uint64)", &network::socket::set_io_timeout);
 				vsocket->set_method_ex("promise<socket_accept>@ accept_deferred()", &VI_SPROMISIFY_REF(socket_accept_deferred, socket_accept));
 				vsocket->set_method_ex("promise<bool>@ connect_deferred(const socket_address&in)", &VI_SPROMISIFY(socket_connect_deferred, type_id::boolf));
@@ -11000,6 +11014,7 @@ namespace vitex
 				vsocket->set_method_ex("bool set_blocking(bool)", VI_EXPECTIFY_VOID(network::socket::set_blocking));
 				vsocket->set_method_ex("bool set_no_delay(bool)", VI_EXPECTIFY_VOID(network::socket::set_no_delay));
 				vsocket->set_method_ex("bool set_keep_alive(bool)", VI_EXPECTIFY_VOID(network::socket::set_keep_alive));
+				vsocket->set_method_ex("bool set_reuse_port(bool)", VI_EXPECTIFY_VOID(network::socket::set_reuse_port));
 				vsocket->set_method_ex("bool set_timeout(int)", VI_EXPECTIFY_VOID(network::socket::set_timeout));
 				vsocket->set_method_ex("bool shutdown(bool = false)", &VI_EXPECTIFY_VOID(network::socket::shutdown));
 				vsocket->set_method_ex("bool open(const socket_address&in)", &VI_EXPECTIFY_VOID(network::socket::open));
@@ -11028,13 +11043,14 @@ namespace vitex
 				VDNS->set_method_ex("promise<string>@ reverse_address_lookup_deferred(const socket_address&in)", &VI_SPROMISIFY_REF(dns_reverse_address_lookup_deferred, string));
 				VDNS->set_method_ex("socket_address lookup(const string_view&in, const string_view&in, dns_type, socket_protocol = socket_protocol::tcp, socket_type = socket_type::stream)", &VI_EXPECTIFY(network::dns::lookup));
 				VDNS->set_method_ex("promise<socket_address>@ lookup_deferred(const string_view&in, const string_view&in, dns_type, socket_protocol = socket_protocol::tcp, socket_type = socket_type::stream)", &VI_SPROMISIFY_REF(dns_lookup_deferred, socket_address));
+				VDNS->set_method("void clear_cache()", &network::dns::clear_cache);
 				VDNS->set_method_static("dns@+ get()", &network::dns::get);
 
 				auto vmultiplexer = vm->set_class<network::multiplexer>("multiplexer", false);
 				vmultiplexer->set_function_def("void poll_async(socket@+, socket_poll)");
 				vmultiplexer->set_constructor<network::multiplexer>("multiplexer@ f()");
-				vmultiplexer->set_constructor<network::multiplexer, uint64_t, size_t>("multiplexer@ f(uint64, usize)");
-				vmultiplexer->set_method("void rescale(uint64, usize)", &network::multiplexer::rescale);
+				vmultiplexer->set_constructor<network::multiplexer, uint64_t, size_t, size_t>("multiplexer@ f(uint64, usize, usize = 1)");
+				vmultiplexer->set_method("void rescale(uint64, usize, usize = 1)", &network::multiplexer::rescale);
 				vmultiplexer->set_method("void activate()", &network::multiplexer::activate);
 				vmultiplexer->set_method("void deactivate()", &network::multiplexer::deactivate);
 				vmultiplexer->set_method("int dispatch(uint64)", &network::multiplexer::dispatch);
@@ -11044,15 +11060,21 @@ namespace vitex
 				vmultiplexer->set_method("bool cancel_events(socket@+, socket_poll = socket_poll::cancel, bool = true)", &network::multiplexer::cancel_events);
 				vmultiplexer->set_method("bool clear_events(socket@+)", &network::multiplexer::clear_events);
 				vmultiplexer->set_method("bool is_listening()", &network::multiplexer::is_listening);
+				vmultiplexer->set_method("bool is_sharded() const", &network::multiplexer::is_sharded);
 				vmultiplexer->set_method("usize get_activations()", &network::multiplexer::get_activations);
+				vmultiplexer->set_method("usize get_shards() const", &network::multiplexer::get_shards);
 				vmultiplexer->set_method_static("multiplexer@+ get()", &network::multiplexer::get);
 
 				auto vuplinks = vm->set_class<network::uplinks>("uplinks", false);
 				vuplinks->set_constructor<network::uplinks>("uplinks@ f()");
 				vuplinks->set_method("void set_max_duplicates(usize)", &network::uplinks::set_max_duplicates);
+				vuplinks->set_method("void set_max_idle(usize)", &network::uplinks::set_max_idle);
+				vuplinks->set_method("void set_idle_timeout(uint64)", &network::uplinks::set_idle_timeout);
 				vuplinks->set_method("bool push_connection(const socket_address&in, socket@+)", &network::uplinks::push_connection);
 				vuplinks->set_method_ex("promise<socket@>@ pop_connection(const socket_address&in)", &VI_PROMISIFY_REF(network::uplinks::pop_connection, socket));
 				vuplinks->set_method("usize max_duplicates() const", &network::uplinks::get_max_duplicates);
+				vuplinks->set_method("usize max_idle() const", &network::uplinks::get_max_idle);
+				vuplinks->set_method("uint64 idle_timeout() const", &network::uplinks::get_idle_timeout);
 				vuplinks->set_method("usize size() const", &network::uplinks::get_size);
 				vuplinks->set_method_static("uplinks@+ get()", &network::uplinks::get);
 
@@ -11074,6 +11096,7 @@ namespace vitex
 				vsocket_router->set_property<network::socket_router>("usize max_heap_buffer", &network::socket_router::max_heap_buffer);
 				vsocket_router->set_property<network::socket_router>("usize max_net_buffer", &network::socket_router::max_net_buffer);
 				vsocket_router->set_property<network::socket_router>("usize backlog_queue", &network::socket_router::backlog_queue);
+				vsocket_router->set_property<network::socket_router>("usize accept_shards", &network::socket_router::accept_shards);
 				vsocket_router->set_property<network::socket_router>("usize socket_timeout", &network::socket_router::socket_timeout);
 				vsocket_router->set_property<network::socket_router>("usize max_connections", &network::socket_router::max_connections);
 				vsocket_router->set_property<network::socket_router>("int64 keep_alive_max_count", &network::socket_router::keep_alive_max_count);
@@ -11336,6 +11359,8 @@ namespace vitex
 				vroute_compression->set_property<network::http::router_entry::entry_compression>("int32 quality_level", &network::http::router_entry::entry_compression::quality_level);
 				vroute_compression->set_property<network::http::router_entry::entry_compression>("int32 memory_level", &network::http::router_entry::entry_compression::memory_level);
 				vroute_compression->set_property<network::http::router_entry::entry_compression>("usize min_length", &network::http::router_entry::entry_compression::min_length);
+				vroute_compression->set_property<network::http::router_entry::entry_compression>("bool precompressed", &network::http::router_entry::entry_compression::precompressed);
+				vroute_compression->set_property<network::http::router_entry::entry_compression>("bool cache", &network::http::router_entry::entry_compression::cache);
 				vroute_compression->set_property<network::http::router_entry::entry_compression>("bool enabled", &network::http::router_entry::entry_compression::enabled);
 				vroute_compression->set_constructor<network::http::router_entry::entry_compression>("void f()");
 				vroute_compression->set_method_ex("void set_files(array<regex_source>@+)", &route_compression_set_files);
@@ -11353,6 +11378,8 @@ namespace vitex
 				vrouter_entry->set_property<network::http::router_entry>("string alias", &network::http::router_entry::alias);
 				vrouter_entry->set_property<network::http::router_entry>("usize websocket_timeout", &network::http::router_entry::web_socket_timeout);
 				vrouter_entry->set_property<network::http::router_entry>("usize static_file_max_age", &network::http::router_entry::static_file_max_age);
+				vrouter_entry->set_property<network::http::router_entry>("usize file_cache_size", &network::http::router_entry::file_cache_size);
+				vrouter_entry->set_property<network::http::router_entry>("usize file_cache_ttl", &network::http::router_entry::file_cache_ttl);
 				vrouter_entry->set_property<network::http::router_entry>("usize level", &network::http::router_entry::level);
 				vrouter_entry->set_property<network::http::router_entry>("bool allow_directory_listing", &network::http::router_entry::allow_directory_listing);
 				vrouter_entry->set_property<network::http::router_entry>("bool allow_websocket", &network::http::router_entry::allow_web_socket);
@@ -11396,6 +11423,14 @@ namespace vitex
 				vrouter_session->set_property<network::http::map_router::router_session>("uint64 expires", &network::http::map_router::router_session::expires);
 				vrouter_session->set_constructor<network::http::map_router::router_session>("void f()");
 
+				auto vrouter_http2 = vm->set_struct_trivial<network::http::map_router::router_http2>("router_http2");
+				vrouter_http2->set_property<network::http::map_router::router_http2>("usize max_concurrent_streams", &network::http::map_router::router_http2::max_concurrent_streams);
+				vrouter_http2->set_property<network::http::map_router::router_http2>("usize initial_window_size", &network::http::map_router::router_http2::initial_window_size);
+				vrouter_http2->set_property<network::http::map_router::router_http2>("usize max_frame_size", &network::http::map_router::router_http2::max_frame_size);
+				vrouter_http2->set_property<network::http::map_router::router_http2>("usize header_table_size", &network::http::map_router::router_http2::header_table_size);
+				vrouter_http2->set_property<network::http::map_router::router_http2>("bool enabled", &network::http::map_router::router_http2::enabled);
+				vrouter_http2->set_constructor<network::http::map_router::router_http2>("void f()");
+
 				auto vconnection = vm->set_class<network::http::connection>("connection", false);
 				auto vweb_socket_frame = vm->set_class<network::http::web_socket_frame>("websocket_frame", false);
 				vweb_socket_frame->set_function_def("void status_async(websocket_frame@+)");
@@ -11415,12 +11450,14 @@ namespace vitex
 				vmap_router->set_property<network::socket_router>("usize max_heap_buffer", &network::socket_router::max_heap_buffer);
 				vmap_router->set_property<network::socket_router>("usize max_net_buffer", &network::socket_router::max_net_buffer);
 				vmap_router->set_property<network::socket_router>("usize backlog_queue", &network::socket_router::backlog_queue);
+				vmap_router->set_property<network::socket_router>("usize accept_shards", &network::socket_router::accept_shards);
 				vmap_router->set_property<network::socket_router>("usize socket_timeout", &network::socket_router::socket_timeout);
 				vmap_router->set_property<network::socket_router>("usize max_connections", &network::socket_router::max_connections);
 				vmap_router->set_property<network::socket_router>("int64 keep_alive_max_count", &network::socket_router::keep_alive_max_count);
 				vmap_router->set_property<network::socket_router>("int64 graceful_time_wait", &network::socket_router::graceful_time_wait);
 				vmap_router->set_property<network::socket_router>("bool enable_no_delay", &network::socket_router::enable_no_delay);
 				vmap_router->set_property<network::http::map_router>("router_session session", &network::http::map_router::session);
+				vmap_router->set_property<network::http::map_router>("router_http2 http2", &network::http::map_router::http2);
 				vmap_router->set_property<network::http::map_router>("string temporary_directory", &network::http::map_router::temporary_directory);
 				vmap_router->set_property<network::http::map_router>("usize max_uploadable_resources", &network::http::map_router::max_uploadable_resources);
 				vmap_router->set_gc_constructor<network::http::map_router, map_router>("map_router@ f()");
@@ -11496,6 +11533,8 @@ namespace vitex
 				vconnection->set_method_ex("bool abort(int32, const string_view&in)", &socket_connection_abort);
 				vconnection->set_method("void reset(bool)", &network::http::connection::reset);
 				vconnection->set_method("bool is_skip_required() const", &network::http::connection::is_skip_required);
+				vconnection->set_method("usize get_arena_allocations() const", &network::http::connection::get_arena_allocations);
+				vconnection->set_method("usize get_arena_reservations() const", &network::http::connection::get_arena_reservations);
 				vconnection->set_method_ex("promise<bool>@ send_headers(int32, bool = true) const", &VI_SPROMISIFY(connection_send_headers, type_id::boolf));
 				vconnection->set_method_ex("promise<bool>@ send_chunk(const string_view&in) const", &VI_SPROMISIFY(connection_send_chunk, type_id::boolf));
 				vconnection->set_method_ex("promise<array<resource_info>@>@ store(bool = false) const", &VI_SPROMISIFY_REF(connection_store, array_resource_info));
@@ -12565,6 +12604,7 @@ namespace vitex
 				vapplication_desc->set_property<application::desc>("string directory", &application::desc::directory);
 				vapplication_desc->set_property<application::desc>("usize polling_timeout", &application::desc::polling_timeout);
 				vapplication_desc->set_property<application::desc>("usize polling_events", &application::desc::polling_events);
+				vapplication_desc->set_property<application::desc>("usize polling_shards", &application::desc::polling_shards);
 				vapplication_desc->set_property<application::desc>("usize threads", &application::desc::threads);
 				vapplication_desc->set_property<application::desc>("usize usage", &application::desc::usage);
 				vapplication_desc->set_property<application::desc>("bool daemon", &application::desc::daemon);
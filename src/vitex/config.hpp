@@ -108,7 +108,9 @@ typedef socklen_t socket_size_t;
 #else
 #define VI_ASSERT(condition, format, ...) ((void)0)
 #endif
-#define VI_MEASURE(threshold) ((void)0)
+#define VI_MEASURE_START(x) _measure_line_##x
+#define VI_MEASURE_PREPARE(x) VI_MEASURE_START(x)
+#define VI_MEASURE(threshold) vitex::core::tracing::scope VI_MEASURE_PREPARE(__LINE__)(__FILE__, __func__, __LINE__)
 #define VI_MEASURE_LOOP() ((void)0)
 #define VI_WATCH(ptr, label) ((void)0)
 #define VI_WATCH_AT(ptr, function, label) ((void)0)
@@ -44,6 +44,7 @@
 #include <dirent.h>
 #include <sys/types.h>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
 #ifdef VI_SOLARIS
 #include <stdlib.h>
 #endif
@@ -53,6 +54,9 @@
 #include <sys/uio.h>
 #include <mach-o/dyld.h>
 #endif
+#ifdef VI_LINUX
+#include <sched.h>
+#endif
 #include <sys/utsname.h>
 #include <sys/wait.h>
 #include <termios.h>
@@ -77,6 +81,8 @@ extern "C"
 #define EPOCH_DIFF (MAKEUQUAD(0xd53e8000, 0x019db1de))
 #define SYS2UNIX_TIME(l, h) ((int64_t)((MAKEUQUAD((l), (h)) - EPOCH_DIFF) / RATE_DIFF))
 #define LEAP_YEAR(x) (((x) % 4 == 0) && (((x) % 100) != 0 || ((x) % 400) == 0))
+#define SCHEDULE_SPIN_COUNT 64
+#define TRACE_RING_SIZE 4096
 #ifdef VI_MICROSOFT
 namespace
 {
@@ -244,6 +250,85 @@ namespace
 				v = '\?';
 		}
 	}
+	void* map_pages(size_t size)
+	{
+#ifdef VI_MICROSOFT
+		return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+		void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		return address != MAP_FAILED ? address : nullptr;
+#endif
+	}
+	void unmap_pages(void* address, size_t size)
+	{
+#ifdef VI_MICROSOFT
+		VirtualFree(address, 0, MEM_RELEASE);
+#else
+		munmap(address, size);
+#endif
+	}
+	size_t get_page_size()
+	{
+#ifdef VI_MICROSOFT
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		return (size_t)info.dwPageSize;
+#else
+		long size = sysconf(_SC_PAGESIZE);
+		return size > 0 ? (size_t)size : 4096;
+#endif
+	}
+	char* map_stack(size_t size, size_t guard)
+	{
+#ifdef VI_MICROSOFT
+		char* base = (char*)VirtualAlloc(nullptr, size + guard, MEM_RESERVE, PAGE_NOACCESS);
+		if (!base)
+			return nullptr;
+
+		size_t commit = std::min(size, guard * 2);
+		char* top = base + guard + size;
+		if (!VirtualAlloc(top - commit, commit, MEM_COMMIT, PAGE_READWRITE))
+		{
+			VirtualFree(base, 0, MEM_RELEASE);
+			return nullptr;
+		}
+
+		if (size > commit && !VirtualAlloc(top - commit - guard, guard, MEM_COMMIT, PAGE_READWRITE | PAGE_GUARD))
+		{
+			VirtualFree(base, 0, MEM_RELEASE);
+			return nullptr;
+		}
+
+		return base + guard;
+#else
+		int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+		flags |= MAP_NORESERVE;
+#endif
+#ifdef MAP_STACK
+		flags |= MAP_STACK;
+#endif
+		void* base = mmap(nullptr, size + guard, PROT_NONE, flags, -1, 0);
+		if (base == MAP_FAILED)
+			return nullptr;
+
+		if (mprotect((char*)base + guard, size, PROT_READ | PROT_WRITE) != 0)
+		{
+			munmap(base, size + guard);
+			return nullptr;
+		}
+
+		return (char*)base + guard;
+#endif
+	}
+	void unmap_stack(char* stack, size_t size, size_t guard)
+	{
+#ifdef VI_MICROSOFT
+		VirtualFree(stack - guard, 0, MEM_RELEASE);
+#else
+		munmap(stack - guard, size + guard);
+#endif
+	}
 #ifdef VI_APPLE
 #define SYSCTL(fname, ...) std::size_t size{};if(fname(__VA_ARGS__,nullptr,&size,nullptr,0))return{};vitex::core::vector<char> result(size);if(fname(__VA_ARGS__,result.data(),&size,nullptr,0))return{};return result
 	template <class t>
@@ -289,6 +374,54 @@ namespace
 		return buffer;
 	}
 #endif
+	static vitex::core::vector<vitex::core::vector<size_t>> cpu_package_groups(const vitex::core::vector<size_t>& processors)
+	{
+		vitex::core::vector<size_t> packages(processors.size(), 0);
+#ifdef VI_MICROSOFT
+		DWORD byte_count = 0;
+		GetLogicalProcessorInformationEx(RelationProcessorPackage, nullptr, &byte_count);
+		vitex::core::vector<uint8_t> buffer(byte_count);
+		if (byte_count > 0 && GetLogicalProcessorInformationEx(RelationProcessorPackage, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buffer.data(), &byte_count))
+		{
+			size_t package = 0;
+			for (DWORD offset = 0; offset < byte_count; ++package)
+			{
+				auto* info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buffer.data() + offset);
+				for (WORD group = 0; group < info->Processor.GroupCount; group++)
+				{
+					const GROUP_AFFINITY& affinity = info->Processor.GroupMask[group];
+					for (size_t i = 0; i < processors.size(); i++)
+					{
+						if (!affinity.Group && processors[i] < sizeof(KAFFINITY) * 8 && (affinity.Mask & ((KAFFINITY)1 << processors[i])))
+							packages[i] = package;
+					}
+				}
+				offset += info->Size;
+			}
+		}
+#elif defined(VI_LINUX)
+		for (size_t i = 0; i < processors.size(); i++)
+		{
+			std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(processors[i]) + "/topology/physical_package_id");
+			size_t package = 0;
+			if (file >> package)
+				packages[i] = package;
+		}
+#endif
+		vitex::core::vector<size_t> identifiers;
+		vitex::core::vector<vitex::core::vector<size_t>> groups;
+		for (size_t i = 0; i < processors.size(); i++)
+		{
+			size_t index = std::find(identifiers.begin(), identifiers.end(), packages[i]) - identifiers.begin();
+			if (index == identifiers.size())
+			{
+				identifiers.push_back(packages[i]);
+				groups.emplace_back();
+			}
+			groups[index].push_back(processors[i]);
+		}
+		return groups;
+	}
 }
 
 namespace vitex
@@ -561,7 +694,7 @@ namespace vitex
 					for (auto* cache : page.second)
 					{
 						cache->~page_cache();
-						free(cache);
+						::free(cache);
 					}
 				}
 				pages.clear();
@@ -587,7 +720,7 @@ namespace vitex
 				page_address* source = (page_address*)((char*)address - sizeof(page_address));
 				memcpy(&source_address, (char*)source + sizeof(void*), sizeof(void*));
 				if (source_address != address)
-					return free(address);
+					return ::free(address);
 
 				page_cache* cache = nullptr;
 				memcpy(&cache, source, sizeof(void*));
@@ -599,7 +732,7 @@ namespace vitex
 				{
 					cache->page.erase(std::find(cache->page.begin(), cache->page.end(), cache));
 					cache->~page_cache();
-					free(cache);
+					::free(cache);
 				}
 			}
 			void cached_allocator::transfer(void* address, size_t size) noexcept
@@ -695,7 +828,439 @@ namespace vitex
 				return (size_t)total;
 			}
 
-			linear_allocator::linear_allocator(size_t size) : top(nullptr), bottom(nullptr), latest_size(0), sizing(size)
+			enum
+			{
+				SLAB_CLASSES = 40,
+				SLAB_MAX_SIZE = 32768,
+				SLAB_HEADER_SIZE = 16,
+				SLAB_MIN_BLOCKS = 8
+			};
+
+			struct slab_block
+			{
+				slab_allocator::page* owner;
+				void* address;
+			};
+
+			struct slab_allocator::page
+			{
+				std::atomic<void*> remote_free = nullptr;
+				std::atomic<thread_cache*> owner = nullptr;
+				void* local_free = nullptr;
+				page* prev = nullptr;
+				page* next = nullptr;
+				int64_t timing = 0;
+				size_t index = 0;
+				size_t capacity = 0;
+				size_t used = 0;
+				size_t size = 0;
+			};
+
+			struct slab_allocator::thread_cache
+			{
+				page* classes[SLAB_CLASSES] = { };
+				shared_state* state = nullptr;
+			};
+
+			struct slab_allocator::shared_state
+			{
+				std::mutex mutex;
+				std::atomic<size_t> references = 1;
+				std::atomic<bool> orphaned = false;
+				page* orphans = nullptr;
+				uint64_t minimal_life_time;
+				size_t page_size;
+				bool alive = true;
+
+				shared_state(uint64_t new_minimal_life_time, size_t new_page_size) : minimal_life_time(new_minimal_life_time), page_size(new_page_size)
+				{
+				}
+				void acquire()
+				{
+					++references;
+				}
+				void update()
+				{
+					orphaned.store(orphans != nullptr, std::memory_order_relaxed);
+				}
+				void release()
+				{
+					if (--references > 0)
+						return;
+
+					page* next = orphans;
+					while (next != nullptr)
+					{
+						page* target = next;
+						next = next->next;
+						unmap_pages(target, target->size);
+					}
+					delete this;
+				}
+			};
+
+			struct slab_registry
+			{
+				std::vector<std::pair<slab_allocator::shared_state*, slab_allocator::thread_cache*>> caches;
+				slab_allocator::shared_state* last_state = nullptr;
+				slab_allocator::thread_cache* last_cache = nullptr;
+
+				~slab_registry();
+			};
+
+			static thread_local bool slab_registry_active = true;
+			static int64_t slab_clock()
+			{
+				return (int64_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+			}
+			static size_t slab_collect(slab_allocator::page* target)
+			{
+				void* next = target->remote_free.exchange(nullptr, std::memory_order_acquire);
+				size_t count = 0;
+				while (next != nullptr)
+				{
+					void* address = next;
+					memcpy(&next, address, sizeof(void*));
+					memcpy(address, &target->local_free, sizeof(void*));
+					target->local_free = address;
+					++count;
+				}
+
+				target->used -= count;
+				return count;
+			}
+			static void slab_unlink(slab_allocator::page*& head, slab_allocator::page* target)
+			{
+				if (target->prev != nullptr)
+					target->prev->next = target->next;
+				else
+					head = target->next;
+				if (target->next != nullptr)
+					target->next->prev = target->prev;
+				target->prev = target->next = nullptr;
+			}
+			static void slab_push(slab_allocator::page*& head, slab_allocator::page* target)
+			{
+				target->prev = nullptr;
+				target->next = head;
+				if (head != nullptr)
+					head->prev = target;
+				head = target;
+			}
+			static void slab_orphan(slab_allocator::shared_state* state, slab_allocator::thread_cache* cache)
+			{
+				umutex<std::mutex> unique(state->mutex);
+				for (auto*& head : cache->classes)
+				{
+					slab_allocator::page* next = head;
+					head = nullptr;
+					while (next != nullptr)
+					{
+						slab_allocator::page* target = next;
+						next = next->next;
+						target->owner.store(nullptr, std::memory_order_release);
+						slab_collect(target);
+						if (!state->alive || !target->used)
+							unmap_pages(target, target->size);
+						else
+							slab_push(state->orphans, target);
+					}
+				}
+				state->update();
+			}
+			slab_registry::~slab_registry()
+			{
+				slab_registry_active = false;
+				last_state = nullptr;
+				last_cache = nullptr;
+				for (auto& item : caches)
+				{
+					slab_orphan(item.first, item.second);
+					item.first->release();
+					delete item.second;
+				}
+				caches.clear();
+			}
+
+			slab_allocator::slab_allocator(uint64_t minimal_life_time_ms, size_t page_size_bytes) : state(new shared_state(minimal_life_time_ms, page_size_bytes))
+			{
+				VI_ASSERT(page_size_bytes > 0, "page size should be greater then zero");
+			}
+			slab_allocator::~slab_allocator() noexcept
+			{
+				{
+					umutex<std::mutex> unique(state->mutex);
+					state->alive = false;
+					page* next = state->orphans;
+					state->orphans = nullptr;
+					while (next != nullptr)
+					{
+						page* target = next;
+						next = next->next;
+						unmap_pages(target, target->size);
+					}
+					state->update();
+				}
+				state->release();
+			}
+			void* slab_allocator::allocate(size_t size) noexcept
+			{
+				thread_cache* cache = size <= SLAB_MAX_SIZE ? get_thread_cache(true) : nullptr;
+				if (!cache)
+				{
+					slab_block* block = (slab_block*)malloc(SLAB_HEADER_SIZE + size);
+					if (!block)
+						return nullptr;
+
+					block->owner = nullptr;
+					block->address = (char*)block + SLAB_HEADER_SIZE;
+					return block->address;
+				}
+
+				size_t index = get_size_class(size);
+				page* target = cache->classes[index];
+				if (!target || !target->local_free)
+				{
+					target = reserve_page(cache, index);
+					if (!target)
+						return nullptr;
+				}
+
+				void* address = target->local_free;
+				memcpy(&target->local_free, address, sizeof(void*));
+				++target->used;
+				return address;
+			}
+			void* slab_allocator::allocate(memory_location&&, size_t size) noexcept
+			{
+				return allocate(size);
+			}
+			void slab_allocator::free(void* address) noexcept
+			{
+				slab_block* block = (slab_block*)((char*)address - SLAB_HEADER_SIZE);
+				if (block->address != address)
+					return ::free(address);
+
+				page* target = block->owner;
+				if (!target)
+					return ::free(block);
+
+				thread_cache* cache = get_thread_cache(false);
+				if (cache != nullptr && target->owner.load(std::memory_order_relaxed) == cache)
+				{
+					memcpy(address, &target->local_free, sizeof(void*));
+					target->local_free = address;
+					if (!--target->used)
+						release_page(cache, target);
+					return;
+				}
+
+				if (!target->owner.load(std::memory_order_acquire))
+				{
+					umutex<std::mutex> unique(state->mutex);
+					if (!target->owner.load(std::memory_order_relaxed))
+					{
+						memcpy(address, &target->local_free, sizeof(void*));
+						target->local_free = address;
+						--target->used;
+						slab_collect(target);
+						if (!target->used)
+						{
+							slab_unlink(state->orphans, target);
+							unmap_pages(target, target->size);
+							state->update();
+						}
+						return;
+					}
+				}
+
+				void* next = target->remote_free.load(std::memory_order_relaxed);
+				do
+				{
+					memcpy(address, &next, sizeof(void*));
+				} while (!target->remote_free.compare_exchange_weak(next, address, std::memory_order_release, std::memory_order_relaxed));
+			}
+			void slab_allocator::transfer(void* address, size_t size) noexcept
+			{
+			}
+			void slab_allocator::transfer(void* address, memory_location&& location, size_t size) noexcept
+			{
+			}
+			void slab_allocator::watch(memory_location&& location, void* address) noexcept
+			{
+			}
+			void slab_allocator::unwatch(void* address) noexcept
+			{
+			}
+			void slab_allocator::finalize() noexcept
+			{
+			}
+			bool slab_allocator::is_valid(void* address) noexcept
+			{
+				return true;
+			}
+			bool slab_allocator::is_finalizable() noexcept
+			{
+				return false;
+			}
+			slab_allocator::thread_cache* slab_allocator::get_thread_cache(bool initialize) noexcept
+			{
+				static thread_local slab_registry* registry = nullptr;
+				if (!slab_registry_active)
+					return nullptr;
+				else if (registry != nullptr && registry->last_state == state)
+					return registry->last_cache;
+
+				if (!registry)
+				{
+					if (!initialize)
+						return nullptr;
+
+					static thread_local slab_registry local_registry;
+					registry = &local_registry;
+				}
+
+				for (auto& item : registry->caches)
+				{
+					if (item.first == state)
+					{
+						registry->last_state = item.first;
+						registry->last_cache = item.second;
+						return item.second;
+					}
+				}
+
+				if (!initialize)
+					return nullptr;
+
+				thread_cache* cache = new thread_cache();
+				cache->state = state;
+				state->acquire();
+				registry->caches.emplace_back(state, cache);
+				registry->last_state = state;
+				registry->last_cache = cache;
+				return cache;
+			}
+			slab_allocator::page* slab_allocator::reserve_page(thread_cache* cache, size_t index) noexcept
+			{
+				page*& head = cache->classes[index];
+				for (page* next = head; next != nullptr; next = next->next)
+				{
+					if (!next->local_free && !slab_collect(next))
+						continue;
+
+					if (next != head)
+					{
+						slab_unlink(head, next);
+						slab_push(head, next);
+					}
+					return next;
+				}
+
+				if (state->orphaned.load(std::memory_order_relaxed) && state->mutex.try_lock())
+				{
+					page* next = state->orphans;
+					while (next != nullptr)
+					{
+						page* target = next;
+						next = next->next;
+						slab_collect(target);
+						if (!target->used)
+						{
+							slab_unlink(state->orphans, target);
+							unmap_pages(target, target->size);
+						}
+						else if (target->index == index && target->local_free != nullptr)
+						{
+							slab_unlink(state->orphans, target);
+							target->owner.store(cache, std::memory_order_release);
+							slab_push(head, target);
+							state->update();
+							state->mutex.unlock();
+							return target;
+						}
+					}
+					state->update();
+					state->mutex.unlock();
+				}
+
+				for (auto* other : cache->classes)
+				{
+					page* next = other;
+					while (next != nullptr)
+					{
+						page* target = next;
+						next = next->next;
+						if (target->remote_free.load(std::memory_order_relaxed) != nullptr)
+							slab_collect(target);
+						if (!target->used)
+							release_page(cache, target);
+					}
+				}
+
+				size_t stride = SLAB_HEADER_SIZE + get_class_size(index);
+				size_t offset = (sizeof(page) + SLAB_HEADER_SIZE - 1) & ~((size_t)SLAB_HEADER_SIZE - 1);
+				size_t capacity = std::max<size_t>(SLAB_MIN_BLOCKS, (state->page_size - offset) / stride);
+				size_t size = offset + stride * capacity;
+				void* base = map_pages(size);
+				if (!base)
+					return nullptr;
+
+				page* target = new(base) page();
+				target->owner.store(cache, std::memory_order_relaxed);
+				target->timing = slab_clock();
+				target->index = index;
+				target->capacity = capacity;
+				target->size = size;
+
+				char* address = (char*)base + offset + stride * capacity;
+				for (size_t i = 0; i < capacity; i++)
+				{
+					address -= stride;
+					slab_block* block = (slab_block*)address;
+					block->owner = target;
+					block->address = address + SLAB_HEADER_SIZE;
+					memcpy(block->address, &target->local_free, sizeof(void*));
+					target->local_free = block->address;
+				}
+
+				slab_push(head, target);
+				return target;
+			}
+			void slab_allocator::release_page(thread_cache* cache, page* target) noexcept
+			{
+				page*& head = cache->classes[target->index];
+				if (head == target && !target->next)
+					return;
+
+				if (slab_clock() - target->timing <= (int64_t)state->minimal_life_time)
+					return;
+
+				slab_unlink(head, target);
+				unmap_pages(target, target->size);
+			}
+			size_t slab_allocator::get_size_class(size_t size) noexcept
+			{
+				if (size <= 128)
+					return size > 0 ? (size + 15) / 16 - 1 : 0;
+
+				size_t value = size - 1, power = 7;
+				while (value >> (power + 1))
+					++power;
+
+				return 8 + (power - 7) * 4 + ((value >> (power - 2)) & 3);
+			}
+			size_t slab_allocator::get_class_size(size_t index) noexcept
+			{
+				if (index < 8)
+					return (index + 1) * 16;
+
+				size_t power = 7 + (index - 8) / 4;
+				size_t step = (index - 8) % 4;
+				return (5 + step) << (power - 2);
+			}
+
+			linear_allocator::linear_allocator(size_t size) : top(nullptr), bottom(nullptr), latest_size(0), sizing(size), allocations(0), reservations(0)
 			{
 				if (sizing > 0)
 					next_region(sizing);
@@ -721,6 +1286,7 @@ namespace vitex
 				char* address = offset_address;
 				bottom->free_address = address + size;
 				latest_size = size;
+				++allocations;
 				return address;
 			}
 			void linear_allocator::free(void* address) noexcept
@@ -783,6 +1349,7 @@ namespace vitex
 					bottom->lower_address = next;
 
 				bottom = next;
+				++reservations;
 				memory::set_local_allocator(current);
 			}
 			void linear_allocator::flush_regions() noexcept
@@ -812,6 +1379,14 @@ namespace vitex
 				char* offset_address = bottom->free_address;
 				return max_address - offset_address;
 			}
+			size_t linear_allocator::get_allocations() const noexcept
+			{
+				return allocations;
+			}
+			size_t linear_allocator::get_reservations() const noexcept
+			{
+				return reservations;
+			}
 
 			stack_allocator::stack_allocator(size_t size) : top(nullptr), bottom(nullptr), sizing(size)
 			{
@@ -959,17 +1534,158 @@ namespace vitex
 #endif
 		};
 
+		struct trace_ring
+		{
+			struct slot
+			{
+				std::atomic<uint64_t> sequence { 0 };
+				std::atomic<uint64_t> thread { 0 };
+				std::atomic<uint64_t> start { 0 };
+				std::atomic<uint64_t> duration { 0 };
+				std::atomic<const char*> file { nullptr };
+				std::atomic<const char*> function { nullptr };
+				std::atomic<int> line { 0 };
+			};
+
+			slot spans[TRACE_RING_SIZE];
+			std::atomic<uint64_t> head { 0 };
+			std::atomic<uint64_t> tail { 0 };
+			uint64_t thread = 0;
+			bool owned = true;
+		};
+
+		struct trace_registry
+		{
+			std::vector<trace_ring*> rings;
+			std::mutex update;
+			uint64_t threads = 0;
+
+			trace_ring* acquire()
+			{
+				umutex<std::mutex> unique(update);
+				for (auto* ring : rings)
+				{
+					if (ring->owned)
+						continue;
+
+					ring->owned = true;
+					ring->thread = ++threads;
+					return ring;
+				}
+
+				auto* ring = new trace_ring();
+				ring->thread = ++threads;
+				rings.push_back(ring);
+				return ring;
+			}
+			void release(trace_ring* ring)
+			{
+				umutex<std::mutex> unique(update);
+				ring->owned = false;
+			}
+			static trace_registry* get()
+			{
+				static trace_registry* base = new trace_registry();
+				return base;
+			}
+		};
+
+		struct trace_owner
+		{
+			trace_ring* ring = nullptr;
+
+			~trace_owner()
+			{
+				if (ring != nullptr)
+					trace_registry::get()->release(ring);
+			}
+		};
+
+		struct costack_pool
+		{
+			std::vector<std::pair<char*, size_t>> stacks;
+			size_t guard = get_page_size();
+
+			~costack_pool()
+			{
+				for (auto& item : stacks)
+					unmap_stack(item.first, item.second, guard);
+				exited() = true;
+			}
+			char* acquire(size_t& size)
+			{
+				size = (size + guard - 1) / guard * guard;
+				for (size_t i = stacks.size(); i-- > 0;)
+				{
+					if (stacks[i].second != size)
+						continue;
+
+					char* stack = stacks[i].first;
+					stacks[i] = stacks.back();
+					stacks.pop_back();
+					return stack;
+				}
+
+				char* stack = map_stack(size, guard);
+				VI_PANIC(stack != nullptr, "application is out of memory allocating %" PRIu64 " bytes of coroutine stack", (uint64_t)size);
+				return stack;
+			}
+			void release(char* stack, size_t size)
+			{
+				size_t capacity = schedule::has_instance() ? schedule::get()->get_policy().max_recycles : 64;
+				if (stacks.size() < capacity)
+					stacks.emplace_back(stack, size);
+				else
+					unmap_stack(stack, size, guard);
+			}
+			static bool& exited()
+			{
+				static thread_local bool value = false;
+				return value;
+			}
+			static costack_pool* get()
+			{
+				if (exited())
+					return nullptr;
+
+				static thread_local costack_pool pool;
+				return &pool;
+			}
+			static char* allocate(size_t& size)
+			{
+				auto* pool = get();
+				if (pool != nullptr)
+					return pool->acquire(size);
+
+				size_t guard = get_page_size();
+				size = (size + guard - 1) / guard * guard;
+				char* stack = map_stack(size, guard);
+				VI_PANIC(stack != nullptr, "application is out of memory allocating %" PRIu64 " bytes of coroutine stack", (uint64_t)size);
+				return stack;
+			}
+			static void deallocate(char* stack, size_t size)
+			{
+				auto* pool = get();
+				if (pool != nullptr)
+					pool->release(stack, size);
+				else
+					unmap_stack(stack, size, get_page_size());
+			}
+		};
+
 		struct cocontext
 		{
 #ifdef VI_FCONTEXT
 			fcontext_t context = nullptr;
 			char* stack = nullptr;
+			size_t size = 0;
 #elif VI_MICROSOFT
 			LPVOID context = nullptr;
 			bool main = false;
 #else
 			ucontext_t context = nullptr;
 			char* stack = nullptr;
+			size_t size = 0;
 #endif
 			cocontext()
 			{
@@ -983,18 +1699,20 @@ namespace vitex
 			cocontext(costate* state)
 			{
 #ifdef VI_FCONTEXT
-				stack = memory::allocate<char>(sizeof(char) * state->size);
-				context = make_fcontext(stack + state->size, state->size, [](transfer_t transfer)
+				size = state->size;
+				stack = costack_pool::allocate(size);
+				context = make_fcontext(stack + size, size, [](transfer_t transfer)
 				{
 					costate::execution_entry(&transfer);
 				});
 #elif VI_MICROSOFT
-				context = CreateFiber(state->size, &costate::execution_entry, (LPVOID)state);
+				context = CreateFiberEx(get_page_size(), state->size, 0, &costate::execution_entry, (LPVOID)state);
 #else
 				getcontext(&context);
-				stack = memory::allocate<char>(sizeof(char) * state->size);
+				size = state->size;
+				stack = costack_pool::allocate(size);
 				context.uc_stack.ss_sp = stack;
-				context.uc_stack.ss_size = state->size;
+				context.uc_stack.ss_size = size;
 				context.uc_stack.ss_flags = 0;
 				context.uc_link = &state->master->context;
 
@@ -1006,14 +1724,16 @@ namespace vitex
 			~cocontext()
 			{
 #ifdef VI_FCONTEXT
-				memory::deallocate(stack);
+				if (stack != nullptr)
+					costack_pool::deallocate(stack, size);
 #elif VI_MICROSOFT
 				if (main)
 					ConvertFiberToThread();
 				else if (context != nullptr)
 					DeleteFiber(context);
 #else
-				memory::deallocate(stack);
+				if (stack != nullptr)
+					costack_pool::deallocate(stack, size);
 #endif
 			}
 		};
@@ -1021,15 +1741,355 @@ namespace vitex
 		struct concurrent_sync_queue
 		{
 			fast_queue queue;
+			std::atomic<size_t> idle = 0;
 		};
 
 		struct concurrent_async_queue : concurrent_sync_queue
 		{
+			vector<schedule::thread_data*> parked;
 			std::condition_variable notify;
 			std::mutex update;
 			std::atomic<bool> resync = true;
 		};
 
+		struct concurrent_task_queue
+		{
+			struct buffer
+			{
+				vector<std::atomic<task_callback*>> items;
+				int64_t mask;
+
+				buffer(int64_t capacity) : items((size_t)capacity), mask(capacity - 1)
+				{
+				}
+				task_callback* load(int64_t index) const
+				{
+					return items[(size_t)(index & mask)].load(std::memory_order_relaxed);
+				}
+				void store(int64_t index, task_callback* value)
+				{
+					items[(size_t)(index & mask)].store(value, std::memory_order_relaxed);
+				}
+				int64_t capacity() const
+				{
+					return mask + 1;
+				}
+			};
+
+			alignas(64) std::atomic<int64_t> top = 0;
+			alignas(64) std::atomic<int64_t> bottom = 0;
+			alignas(64) std::atomic<buffer*> storage;
+			vector<buffer*> retired;
+
+			concurrent_task_queue(size_t capacity)
+			{
+				int64_t size = 64;
+				while (size < (int64_t)capacity)
+					size <<= 1;
+				storage = memory::init<buffer>(size);
+			}
+			~concurrent_task_queue()
+			{
+				task_callback* callback = take();
+				while (callback != nullptr)
+				{
+					memory::deinit(callback);
+					callback = take();
+				}
+
+				for (auto* item : retired)
+					memory::deinit(item);
+				memory::deinit(storage.load());
+			}
+			void push(task_callback&& callback)
+			{
+				int64_t b = bottom.load(std::memory_order_relaxed);
+				int64_t t = top.load(std::memory_order_acquire);
+				buffer* target = storage.load(std::memory_order_relaxed);
+				if (b - t > target->capacity() - 1)
+				{
+					buffer* resized = memory::init<buffer>(target->capacity() << 1);
+					for (int64_t i = t; i < b; i++)
+						resized->store(i, target->load(i));
+					retired.push_back(target);
+					storage.store(resized, std::memory_order_release);
+					target = resized;
+				}
+
+				target->store(b, memory::init<task_callback>(std::move(callback)));
+				std::atomic_thread_fence(std::memory_order_release);
+				bottom.store(b + 1, std::memory_order_relaxed);
+			}
+			task_callback* take()
+			{
+				int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+				buffer* target = storage.load(std::memory_order_relaxed);
+				bottom.store(b, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				int64_t t = top.load(std::memory_order_relaxed);
+				if (t > b)
+				{
+					bottom.store(b + 1, std::memory_order_relaxed);
+					return nullptr;
+				}
+
+				task_callback* callback = target->load(b);
+				if (t != b)
+					return callback;
+
+				if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					callback = nullptr;
+				bottom.store(b + 1, std::memory_order_relaxed);
+				return callback;
+			}
+			task_callback* steal()
+			{
+				int64_t t = top.load(std::memory_order_acquire);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				int64_t b = bottom.load(std::memory_order_acquire);
+				if (t >= b)
+					return nullptr;
+
+				buffer* target = storage.load(std::memory_order_acquire);
+				task_callback* callback = target->load(t);
+				if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					return nullptr;
+
+				return callback;
+			}
+			size_t size() const
+			{
+				int64_t b = bottom.load(std::memory_order_relaxed);
+				int64_t t = top.load(std::memory_order_relaxed);
+				return b > t ? (size_t)(b - t) : 0;
+			}
+		};
+
+		struct concurrent_timeout_queue
+		{
+			enum
+			{
+				ROOT_BITS = 8,
+				LEVEL_BITS = 6,
+				ROOT_SIZE = 1 << ROOT_BITS,
+				LEVEL_SIZE = 1 << LEVEL_BITS,
+				LEVELS = 5
+			};
+
+			struct entry
+			{
+				timeout data;
+				uint64_t tick;
+				entry* prev = nullptr;
+				entry* next = nullptr;
+				entry** slot = nullptr;
+
+				entry(timeout&& new_data) : data(std::move(new_data)), tick(0)
+				{
+				}
+			};
+
+			entry* wheel[LEVELS][ROOT_SIZE] = { };
+			unordered_map<task_id, entry*> index;
+			std::condition_variable notify;
+			std::mutex update;
+			uint64_t deadline = std::numeric_limits<uint64_t>::max();
+			uint64_t current = 0;
+			size_t pending = 0;
+			bool resync = true;
+
+			~concurrent_timeout_queue()
+			{
+				clear();
+			}
+			uint64_t insert(timeout&& data, std::chrono::microseconds clock)
+			{
+				auto* target = memory::init<entry>(std::move(data));
+				index[target->data.id] = target;
+				link(target, clock);
+				return target->tick;
+			}
+			uint64_t reinsert(timeout&& data, std::chrono::microseconds clock)
+			{
+				auto it = index.find(data.id);
+				if (it == index.end() || it->second->slot != nullptr)
+					return std::numeric_limits<uint64_t>::max();
+
+				it->second->data = std::move(data);
+				link(it->second, clock);
+				return it->second->tick;
+			}
+			bool wakes(uint64_t tick) const
+			{
+				return tick < deadline;
+			}
+			void sleep(std::chrono::microseconds clock, std::chrono::microseconds when)
+			{
+				deadline = to_tick(clock + when);
+			}
+			void awake()
+			{
+				deadline = std::numeric_limits<uint64_t>::max();
+			}
+			bool remove(task_id id)
+			{
+				auto it = index.find(id);
+				if (it == index.end())
+					return false;
+
+				auto* target = it->second;
+				index.erase(it);
+				unlink(target);
+				memory::deinit(target);
+				return true;
+			}
+			void expire(std::chrono::microseconds clock, vector<timeout>& expired)
+			{
+				uint64_t target = to_tick(clock);
+				if (!pending)
+				{
+					current = target + 1;
+					return;
+				}
+
+				while (current <= target && pending > 0)
+				{
+					size_t root = (size_t)(current & (ROOT_SIZE - 1));
+					if (!root)
+					{
+						for (size_t level = 1; level < LEVELS; level++)
+						{
+							size_t slot = (size_t)((current >> (ROOT_BITS + (level - 1) * LEVEL_BITS)) & (LEVEL_SIZE - 1));
+							cascade(wheel[level][slot]);
+							if (slot != 0)
+								break;
+						}
+					}
+
+					entry* next = wheel[0][root];
+					while (next != nullptr)
+					{
+						entry* item = next;
+						next = next->next;
+						unlink(item);
+						if (item->data.alive)
+						{
+							expired.emplace_back(std::move(item->data));
+							continue;
+						}
+
+						index.erase(item->data.id);
+						expired.emplace_back(std::move(item->data));
+						memory::deinit(item);
+					}
+					++current;
+				}
+
+				if (!pending && current <= target)
+					current = target + 1;
+			}
+			void clear()
+			{
+				for (auto& item : index)
+					memory::deinit(item.second);
+				for (auto& level : wheel)
+					std::fill(std::begin(level), std::end(level), nullptr);
+				index.clear();
+				pending = 0;
+			}
+			std::chrono::microseconds next_timeout(std::chrono::microseconds clock) const
+			{
+				if (!pending)
+					return std::chrono::microseconds::max();
+
+				uint64_t target = current;
+				size_t root = (size_t)(current & (ROOT_SIZE - 1));
+				for (size_t i = root; i < ROOT_SIZE; i++, target++)
+				{
+					if (wheel[0][i] != nullptr)
+						break;
+				}
+
+				auto expires = std::chrono::microseconds(target * 1000);
+				return expires > clock ? expires - clock : std::chrono::microseconds(0);
+			}
+			size_t size() const
+			{
+				return index.size();
+			}
+			bool empty() const
+			{
+				return index.empty();
+			}
+
+		private:
+			void link(entry* target, std::chrono::microseconds clock)
+			{
+				if (!pending)
+					current = to_tick(clock);
+
+				auto expires = clock + target->data.expires;
+				target->tick = std::max(current, to_tick(expires + std::chrono::microseconds(999)));
+				place(target);
+				++pending;
+			}
+			void place(entry* target)
+			{
+				uint64_t delta = target->tick - current;
+				entry** slot;
+				if (delta < ROOT_SIZE)
+					slot = &wheel[0][target->tick & (ROOT_SIZE - 1)];
+				else
+				{
+					size_t level = 1;
+					while (level < LEVELS - 1 && delta >= ((uint64_t)1 << (ROOT_BITS + level * LEVEL_BITS)))
+						++level;
+
+					uint64_t limit = ((uint64_t)1 << (ROOT_BITS + level * LEVEL_BITS)) - 1;
+					uint64_t tick = std::min(target->tick, current + limit);
+					slot = &wheel[level][(tick >> (ROOT_BITS + (level - 1) * LEVEL_BITS)) & (LEVEL_SIZE - 1)];
+				}
+
+				target->slot = slot;
+				target->prev = nullptr;
+				target->next = *slot;
+				if (target->next != nullptr)
+					target->next->prev = target;
+				*slot = target;
+			}
+			void unlink(entry* target)
+			{
+				if (!target->slot)
+					return;
+
+				if (target->prev != nullptr)
+					target->prev->next = target->next;
+				else
+					*target->slot = target->next;
+				if (target->next != nullptr)
+					target->next->prev = target->prev;
+
+				target->slot = nullptr;
+				target->prev = target->next = nullptr;
+				--pending;
+			}
+			void cascade(entry*& head)
+			{
+				entry* next = head;
+				head = nullptr;
+				while (next != nullptr)
+				{
+					entry* item = next;
+					next = next->next;
+					place(item);
+				}
+			}
+			static uint64_t to_tick(std::chrono::microseconds clock)
+			{
+				return (uint64_t)std::max<int64_t>(0, (int64_t)clock.count()) / 1000;
+			}
+		};
+
 		basic_exception::basic_exception(const std::string_view& new_message) noexcept : error_message(new_message)
 		{
 		}
@@ -1336,7 +2396,7 @@ namespace vitex
 			if (!address)
 				return;
 
-			if (internal_allocator != nullptr)
+			if (internal_allocator != nullptr && internal_allocator->is_valid(address))
 				return internal_allocator->free(address);
 			else if (global != nullptr)
 				return global->free(address);
@@ -1532,6 +2592,124 @@ namespace vitex
 		static thread_local std::stack<measurement> internal_stacktrace;
 #endif
 		static thread_local bool internal_logging = false;
+		std::atomic<bool> tracing::active = false;
+		void tracing::set_active(bool enabled) noexcept
+		{
+			active = enabled;
+		}
+		void tracing::record(const char* file, const char* function, int line, uint64_t start, uint64_t end) noexcept
+		{
+			static thread_local trace_owner owner;
+			if (!owner.ring)
+				owner.ring = trace_registry::get()->acquire();
+
+			auto* ring = owner.ring;
+			uint64_t index = ring->head.load(std::memory_order_relaxed);
+			auto& next = ring->spans[index % TRACE_RING_SIZE];
+			next.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			next.thread.store(ring->thread, std::memory_order_relaxed);
+			next.start.store(start, std::memory_order_relaxed);
+			next.duration.store(end > start ? end - start : 0, std::memory_order_relaxed);
+			next.file.store(file, std::memory_order_relaxed);
+			next.function.store(function, std::memory_order_relaxed);
+			next.line.store(line, std::memory_order_relaxed);
+			next.sequence.store(index * 2 + 2, std::memory_order_release);
+			ring->head.store(index + 1, std::memory_order_release);
+		}
+		void tracing::clear() noexcept
+		{
+			auto* registry = trace_registry::get();
+			umutex<std::mutex> unique(registry->update);
+			for (auto* ring : registry->rings)
+				ring->tail = ring->head.load();
+		}
+		bool tracing::is_active() noexcept
+		{
+			return active.load(std::memory_order_relaxed);
+		}
+		uint64_t tracing::get_clock() noexcept
+		{
+			return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		}
+		vector<tracing::span> tracing::get_spans() noexcept
+		{
+			vector<span> result;
+			auto* registry = trace_registry::get();
+			umutex<std::mutex> unique(registry->update);
+			for (auto* ring : registry->rings)
+			{
+				uint64_t head = ring->head.load(std::memory_order_acquire);
+				uint64_t tail = std::max<uint64_t>(ring->tail.load(), head > TRACE_RING_SIZE ? head - TRACE_RING_SIZE : 0);
+				for (uint64_t index = tail; index < head; index++)
+				{
+					auto& next = ring->spans[index % TRACE_RING_SIZE];
+					uint64_t sequence = next.sequence.load(std::memory_order_acquire);
+					if (sequence != index * 2 + 2)
+						continue;
+
+					span item;
+					item.id = index;
+					item.thread = next.thread.load(std::memory_order_relaxed);
+					item.start = next.start.load(std::memory_order_relaxed);
+					item.duration = next.duration.load(std::memory_order_relaxed);
+					item.file = next.file.load(std::memory_order_relaxed);
+					item.function = next.function.load(std::memory_order_relaxed);
+					item.line = next.line.load(std::memory_order_relaxed);
+					std::atomic_thread_fence(std::memory_order_acquire);
+					if (next.sequence.load(std::memory_order_relaxed) == sequence)
+						result.push_back(item);
+				}
+			}
+
+			std::sort(result.begin(), result.end(), [](const span& a, const span& b) { return a.start < b.start; });
+			return result;
+		}
+		string tracing::get_chrome_trace() noexcept
+		{
+			auto escape = [](string& result, const char* value)
+			{
+				for (const char* next = value ? value : "?"; *next != '\0'; next++)
+				{
+					if (*next == '"' || *next == '\\')
+						result.push_back('\\');
+					result.push_back(*next);
+				}
+			};
+#ifdef VI_MICROSOFT
+			uint64_t process = (uint64_t)GetCurrentProcessId();
+#else
+			uint64_t process = (uint64_t)getpid();
+#endif
+			auto spans = get_spans();
+			string result = "{\"traceEvents\":[";
+			result.reserve(result.size() + spans.size() * 160);
+			for (auto& item : spans)
+			{
+				if (result.back() != '[')
+					result.push_back(',');
+				result.append("{\"name\":\"");
+				escape(result, item.function);
+				result.append("\",\"cat\":\"measure\",\"ph\":\"X\",\"ts\":");
+				result.append(core::to_string(item.start));
+				result.append(",\"dur\":");
+				result.append(core::to_string(item.duration));
+				result.append(",\"pid\":");
+				result.append(core::to_string(process));
+				result.append(",\"tid\":");
+				result.append(core::to_string(item.thread));
+				result.append(",\"args\":{\"file\":\"");
+				escape(result, item.file);
+				result.append("\",\"line\":");
+				result.append(core::to_string(item.line));
+				result.append(",\"id\":");
+				result.append(core::to_string(item.id));
+				result.append("}}");
+			}
+
+			result.append("],\"displayTimeUnit\":\"ms\"}");
+			return result;
+		}
 		error_handling::tick::tick(bool active) noexcept : is_counting(active)
 		{
 		}
@@ -1548,6 +2726,8 @@ namespace vitex
 			VI_ASSERT(!internal_stacktrace.empty(), "debug frame should be set");
 			auto& next = internal_stacktrace.top();
 			next.notify_of_over_consumption();
+			if (tracing::is_active())
+				tracing::record(next.file, next.function, next.line, next.time, tracing::get_clock());
 			internal_stacktrace.pop();
 #endif
 		}
@@ -8636,7 +9816,7 @@ namespace vitex
 				}
 			}
 
-			result.packages = packages.size();
+			result.packages = std::max<uint32_t>(1, (uint32_t)packages.size());
 			result.physical = result.logical / result.packages;
 #endif
 			return result;
@@ -10893,7 +12073,7 @@ namespace vitex
 		schedule::desc::desc() : desc(std::max<uint32_t>(2, os::hw::get_quantity_info().logical) - 1)
 		{
 		}
-		schedule::desc::desc(size_t size) : preallocated_size(0), stack_size(STACK_SIZE), max_coroutines(96), max_recycles(64), idle_timeout(std::chrono::milliseconds(2000)), clock_timeout(std::chrono::milliseconds((uint64_t)timings::intensive)), parallel(true)
+		schedule::desc::desc(size_t size) : preallocated_size(0), stack_size(STACK_SIZE), max_coroutines(96), max_recycles(64), idle_timeout(std::chrono::milliseconds(2000)), clock_timeout(std::chrono::milliseconds((uint64_t)timings::intensive)), affinity(thread_affinity::none), parallel(true), work_stealing(false)
 		{
 			if (!size)
 				size = 1;
@@ -10910,7 +12090,7 @@ namespace vitex
 			max_coroutines = std::min<size_t>(size * 8, 256);
 		}
 
-		schedule::schedule() noexcept : generation(0), debug(nullptr), terminate(false), enqueue(true), suspended(false), active(false)
+		schedule::schedule() noexcept : generation(0), debug(nullptr), topology({ }), terminate(false), enqueue(true), suspended(false), active(false)
 		{
 			timeouts = memory::init<concurrent_timeout_queue>();
 			async = memory::init<concurrent_async_queue>();
@@ -10942,13 +12122,14 @@ namespace vitex
 #endif
 			VI_MEASURE(timings::atomic);
 			auto duration = std::chrono::microseconds(milliseconds * 1000);
-			auto expires = get_clock() + duration;
 			auto id = get_task_id();
 
 			umutex<std::mutex> unique(timeouts->update);
-			timeouts->queue.emplace(std::make_pair(get_timeout(expires), timeout(std::move(callback), duration, id, true)));
-			timeouts->resync = true;
-			timeouts->notify.notify_all();
+			if (timeouts->wakes(timeouts->insert(timeout(std::move(callback), duration, id, true), get_clock())))
+			{
+				timeouts->resync = true;
+				timeouts->notify.notify_all();
+			}
 			return id;
 		}
 		task_id schedule::set_timeout(uint64_t milliseconds, task_callback&& callback)
@@ -10961,13 +12142,14 @@ namespace vitex
 #endif
 			VI_MEASURE(timings::atomic);
 			auto duration = std::chrono::microseconds(milliseconds * 1000);
-			auto expires = get_clock() + duration;
 			auto id = get_task_id();
 
 			umutex<std::mutex> unique(timeouts->update);
-			timeouts->queue.emplace(std::make_pair(get_timeout(expires), timeout(std::move(callback), duration, id, false)));
-			timeouts->resync = true;
-			timeouts->notify.notify_all();
+			if (timeouts->wakes(timeouts->insert(timeout(std::move(callback), duration, id, false), get_clock())))
+			{
+				timeouts->resync = true;
+				timeouts->notify.notify_all();
+			}
 			return id;
 		}
 		bool schedule::set_task(task_callback&& callback, bool recyclable)
@@ -10996,10 +12178,45 @@ namespace vitex
 				return true;
 
 			async->queue.enqueue(std::move(callback));
-			umutex<std::mutex> unique(async->update);
-			for (auto* thread : threads[(size_t)difficulty::async])
-				thread->notify.notify_all();
+			unpark_threads(1);
+			return true;
+		}
+		bool schedule::set_tasks(task_callback* callbacks, size_t count)
+		{
+			VI_ASSERT(callbacks != nullptr || !count, "callbacks should be set");
+			if (!enqueue)
+				return false;
+			else if (!count)
+				return true;
+#ifndef NDEBUG
+			report_thread(thread_task::enqueue_task, count, get_thread());
+#endif
+			VI_MEASURE(timings::atomic);
+			auto* thread = (thread_data*)initialize_thread(nullptr, false);
+			if (policy.affinity == thread_affinity::none || !thread || !thread->local || thread->type != difficulty::sync || !has_parallel_threads(difficulty::sync))
+				return sync->queue.enqueue_bulk(std::make_move_iterator(callbacks), count);
 
+			for (size_t i = 0; i < count; i++)
+				thread->local->push(std::move(callbacks[i]));
+
+			unpark_stealers(difficulty::sync, count);
+			return true;
+		}
+		bool schedule::set_coroutines(task_callback* callbacks, size_t count)
+		{
+			VI_ASSERT(callbacks != nullptr || !count, "callbacks should be set");
+			if (!enqueue)
+				return false;
+			else if (!count)
+				return true;
+#ifndef NDEBUG
+			report_thread(thread_task::enqueue_coroutine, count, get_thread());
+#endif
+			VI_MEASURE(timings::atomic);
+			if (!async->queue.enqueue_bulk(std::make_move_iterator(callbacks), count))
+				return false;
+
+			unpark_threads(count);
 			return true;
 		}
 		bool schedule::set_debug_callback(thread_debug_callback&& callback)
@@ -11018,29 +12235,25 @@ namespace vitex
 				return false;
 
 			umutex<std::mutex> unique(timeouts->update);
-			for (auto it = timeouts->queue.begin(); it != timeouts->queue.end(); ++it)
-			{
-				if (it->second.id == target)
-				{
-					timeouts->resync = true;
-					timeouts->queue.erase(it);
-					timeouts->notify.notify_all();
-					return true;
-				}
-			}
-			return false;
+			return timeouts->remove(target);
 		}
 		bool schedule::trigger_timers()
 		{
 			VI_MEASURE(timings::pass);
 			umutex<std::mutex> unique(timeouts->update);
-			for (auto& item : timeouts->queue)
-				set_task(std::move(item.second.callback));
+			vector<task_callback> batch;
+			batch.reserve(timeouts->size());
+			for (auto& item : timeouts->index)
+			{
+				if (item.second->data.callback)
+					batch.emplace_back(std::move(item.second->data.callback));
+			}
 
-			size_t size = timeouts->queue.size();
 			timeouts->resync = true;
-			timeouts->queue.clear();
-			return size > 0;
+			timeouts->clear();
+			if (!batch.empty())
+				sync->queue.enqueue_bulk(std::make_move_iterator(batch.begin()), batch.size());
+			return !batch.empty();
 		}
 		bool schedule::trigger(difficulty type)
 		{
@@ -11049,40 +12262,13 @@ namespace vitex
 			{
 				case difficulty::timeout:
 				{
-					if (timeouts->queue.empty())
+					umutex<std::mutex> unique(timeouts->update);
+					if (timeouts->empty())
 						return false;
 					else if (suspended)
 						return true;
 
-					auto clock = get_clock();
-					auto it = timeouts->queue.begin();
-					if (it->first >= clock)
-						return true;
-#ifndef NDEBUG
-					report_thread(thread_task::process_timer, 1, nullptr);
-#endif
-					if (it->second.alive && active)
-					{
-						timeout next(std::move(it->second));
-						timeouts->queue.erase(it);
-
-						set_task([this, next = std::move(next)]() mutable
-						{
-							next.callback();
-							umutex<std::mutex> unique(timeouts->update);
-							timeouts->queue.emplace(std::make_pair(get_timeout(get_clock() + next.expires), std::move(next)));
-							timeouts->resync = true;
-							timeouts->notify.notify_all();
-						});
-					}
-					else
-					{
-						set_task(std::move(it->second.callback));
-						timeouts->queue.erase(it);
-					}
-#ifndef NDEBUG
-					report_thread(thread_task::awake, 0, nullptr);
-#endif
+					dispatch_timers(get_clock());
 					return true;
 				}
 				case difficulty::async:
@@ -11153,6 +12339,47 @@ namespace vitex
 				return true;
 			}
 
+			for (size_t i = 0; i < (size_t)difficulty::count; i++)
+				threads[i].reserve(policy.threads[i] + 1);
+
+			if (policy.affinity != thread_affinity::none)
+			{
+				topology = os::hw::get_quantity_info();
+				processors.clear();
+#ifdef VI_MICROSOFT
+				DWORD_PTR process_mask = 0, system_mask = 0;
+				if (GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask))
+				{
+					for (size_t i = 0; i < sizeof(DWORD_PTR) * 8; i++)
+					{
+						if (process_mask & ((DWORD_PTR)1 << i))
+							processors.push_back(i);
+					}
+				}
+#elif defined(VI_LINUX)
+				cpu_set_t set;
+				CPU_ZERO(&set);
+				if (sched_getaffinity(0, sizeof(set), &set) == 0)
+				{
+					for (size_t i = 0; i < CPU_SETSIZE; i++)
+					{
+						if (CPU_ISSET(i, &set))
+							processors.push_back(i);
+					}
+				}
+#endif
+				if (processors.empty())
+				{
+					for (size_t i = 0; i < std::max<size_t>(1, topology.logical); i++)
+						processors.push_back(i);
+				}
+
+				nodes = cpu_package_groups(processors);
+				processors.clear();
+				for (auto& node : nodes)
+					processors.insert(processors.end(), node.begin(), node.end());
+			}
+
 			size_t index = 0;
 			for (size_t j = 0; j < policy.threads[(size_t)difficulty::async]; j++)
 				push_thread(difficulty::async, index++, j, false);
@@ -11192,7 +12419,7 @@ namespace vitex
 				}
 			}
 
-			timeouts->queue.clear();
+			timeouts->clear();
 			terminate = false;
 			enqueue = true;
 			chunk_cleanup();
@@ -11242,6 +12469,7 @@ namespace vitex
 		{
 			string thread_id = os::process::get_thread_id(thread->id);
 			initialize_thread(thread, true);
+			pin_thread(thread);
 			if (!thread_active(thread))
 				goto exit_thread;
 
@@ -11262,56 +12490,22 @@ namespace vitex
 							continue;
 
 						std::unique_lock<std::mutex> unique(timeouts->update);
-					retry:
 #ifndef NDEBUG
 						report_thread(thread_task::awake, 0, thread);
 #endif
-						std::chrono::microseconds when = std::chrono::microseconds(0);
-						if (!timeouts->queue.empty())
-						{
-							auto clock = get_clock();
-							auto it = timeouts->queue.begin();
-							if (it->first <= clock)
-							{
-#ifndef NDEBUG
-								report_thread(thread_task::process_timer, 1, thread);
-#endif
-								if (it->second.alive)
-								{
-									timeout next(std::move(it->second));
-									timeouts->queue.erase(it);
-
-									set_task([this, next = std::move(next)]() mutable
-									{
-										next.callback();
-										umutex<std::mutex> unique(timeouts->update);
-										timeouts->queue.emplace(std::make_pair(get_timeout(get_clock() + next.expires), std::move(next)));
-										timeouts->resync = true;
-										timeouts->notify.notify_all();
-									});
-								}
-								else
-								{
-									set_task(std::move(it->second.callback));
-									timeouts->queue.erase(it);
-								}
-
-								goto retry;
-							}
-							else
-							{
-								when = it->first - clock;
-								if (when > policy.idle_timeout)
-									when = policy.idle_timeout;
-							}
-						}
-						else
+						auto clock = get_clock();
+						dispatch_timers(clock);
+
+						std::chrono::microseconds when = timeouts->next_timeout(clock);
+						if (when > policy.idle_timeout)
 							when = policy.idle_timeout;
 #ifndef NDEBUG
 						report_thread(thread_task::sleep, 0, thread);
 #endif
+						timeouts->sleep(clock, when);
 						timeouts->notify.wait_for(unique, when, [this, thread]() { return !thread_active(thread) || timeouts->resync || sync->queue.size_approx() > 0; });
 						timeouts->resync = false;
+						timeouts->awake();
 						unique.unlock();
 
 						if (!sync->queue.try_dequeue(token, event))
@@ -11337,6 +12531,7 @@ namespace vitex
 					uptr<costate> state = new costate(policy.stack_size);
 					state->external_condition = &thread->notify;
 					state->external_mutex = &thread->update;
+					size_t processed = 0;
 
 					do
 					{
@@ -11348,15 +12543,11 @@ namespace vitex
 						size_t cache = policy.max_coroutines - state->get_count();
 						while (cache > 0)
 						{
-							if (!thread->queue.empty())
-							{
-								event = std::move(thread->queue.front());
-								thread->queue.pop();
-							}
-							else if (!async->queue.try_dequeue(token, event))
+							if (!fast_bypass_dequeue(thread, event) && !async->queue.try_dequeue(token, event) && !steal_dequeue(type, thread, event))
 								break;
 
 							--cache;
+							++processed;
 							state->pop(std::move(event));
 #ifndef NDEBUG
 							report_thread(thread_task::enqueue_coroutine, 1, thread);
@@ -11372,18 +12563,53 @@ namespace vitex
 #ifndef NDEBUG
 						report_thread(thread_task::sleep, 0, thread);
 #endif
-						std::unique_lock<std::mutex> unique(thread->update);
-						thread->notify.wait_for(unique, policy.idle_timeout, [this, &state, thread]()
+						auto is_ready = [this, &state, thread]()
+						{
+							return !thread_active(thread) || state->has_resumable_coroutines() || async->resync.load() || ((async->queue.size_approx() > 0 || !thread->queue.empty() || (thread->local != nullptr && thread->local->size() > 0) || steal_ready(difficulty::async, thread)) && state->get_count() + 1 < policy.max_coroutines);
+						};
+
+						bool ready = is_ready();
+						for (size_t i = 0; i < SCHEDULE_SPIN_COUNT && !ready; i++)
+						{
+							std::this_thread::yield();
+							ready = is_ready();
+						}
+
+						if (!ready)
 						{
-							return !thread_active(thread) || state->has_resumable_coroutines() || async->resync.load() || (async->queue.size_approx() > 0 && state->get_count() + 1 < policy.max_coroutines);
-						});
+							{
+								umutex<std::mutex> unique(async->update);
+								async->parked.push_back(thread);
+							}
+
+							std::unique_lock<std::mutex> unique(thread->update);
+							++async->idle;
+#ifndef NDEBUG
+							report_thread(thread_task::park, processed, thread);
+#endif
+							thread->notify.wait_for(unique, policy.idle_timeout, [thread, &is_ready]()
+							{
+								return thread->signal || is_ready();
+							});
+							--async->idle;
+							bool signaled = thread->signal;
+							thread->signal = false;
+							unique.unlock();
+							if (!signaled)
+							{
+								umutex<std::mutex> unique(async->update);
+								auto it = std::find(async->parked.begin(), async->parked.end(), thread);
+								if (it != async->parked.end())
+									async->parked.erase(it);
+							}
+#ifndef NDEBUG
+							report_thread(thread_task::unpark, signaled ? 1 : 0, thread);
+#endif
+							processed = 0;
+						}
 						async->resync = false;
 					} while (thread_active(thread));
-					while (!thread->queue.empty())
-					{
-						async->queue.enqueue(std::move(thread->queue.front()));
-						thread->queue.pop();
-					}
+					fast_bypass_flush(thread);
 					break;
 				}
 				case difficulty::sync:
@@ -11402,13 +12628,14 @@ namespace vitex
 #ifndef NDEBUG
 						report_thread(thread_task::sleep, 0, thread);
 #endif
-						if (!thread->queue.empty())
+						if (!fast_bypass_dequeue(thread, event) && !sync->queue.try_dequeue(token, event) && !steal_dequeue(type, thread, event))
 						{
-							event = std::move(thread->queue.front());
-							thread->queue.pop();
+							++sync->idle;
+							bool dequeued = steal_dequeue(type, thread, event) || sync->queue.wait_dequeue_timed(token, event, policy.idle_timeout);
+							--sync->idle;
+							if (!dequeued)
+								continue;
 						}
-						else if (!sync->queue.wait_dequeue_timed(token, event, policy.idle_timeout))
-							continue;
 #ifndef NDEBUG
 						report_thread(thread_task::awake, 0, thread);
 						report_thread(thread_task::process_task, 1, thread);
@@ -11416,11 +12643,7 @@ namespace vitex
 						VI_MEASURE(timings::intensive);
 						event();
 					} while (thread_active(thread));
-					while (!thread->queue.empty())
-					{
-						sync->queue.enqueue(std::move(thread->queue.front()));
-						thread->queue.pop();
-					}
+					fast_bypass_flush(thread);
 					break;
 				}
 				default:
@@ -11455,6 +12678,47 @@ namespace vitex
 #endif
 			return true;
 		}
+		bool schedule::pin_thread(thread_data* thread)
+		{
+			if (policy.affinity == thread_affinity::none || thread->daemon || processors.empty() || nodes.empty())
+				return false;
+
+			vector<size_t> targets;
+			if (policy.affinity == thread_affinity::per_core)
+				targets.push_back(processors[thread->global_index % processors.size()]);
+			else
+				targets = nodes[thread->node_index % nodes.size()];
+#ifdef VI_MICROSOFT
+			DWORD_PTR mask = 0;
+			for (size_t target : targets)
+			{
+				if (target < sizeof(DWORD_PTR) * 8)
+					mask |= (DWORD_PTR)1 << target;
+			}
+
+			if (mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0)
+				return true;
+
+			VI_WARN("[schedule] cannot pin thread %s to %i cpus of package %i: %s", os::process::get_thread_id(std::this_thread::get_id()).c_str(), (int)targets.size(), (int)thread->node_index, os::error::get_condition_or().message().c_str());
+			return false;
+#elif defined(VI_LINUX)
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			for (size_t target : targets)
+			{
+				if (target < CPU_SETSIZE)
+					CPU_SET(target, &set);
+			}
+
+			if (CPU_COUNT(&set) > 0 && sched_setaffinity(0, sizeof(set), &set) == 0)
+				return true;
+
+			VI_WARN("[schedule] cannot pin thread %s to %i cpus of package %i: %s", os::process::get_thread_id(std::this_thread::get_id()).c_str(), (int)targets.size(), (int)thread->node_index, os::error::get_condition_or().message().c_str());
+			return false;
+#else
+			return false;
+#endif
+		}
 		bool schedule::thread_active(thread_data* thread)
 		{
 			if (thread->daemon)
@@ -11467,7 +12731,10 @@ namespace vitex
 			for (size_t i = 0; i < (size_t)difficulty::count; i++)
 			{
 				for (auto* thread : threads[i])
+				{
+					memory::deinit(thread->local);
 					memory::deinit(thread);
+				}
 				threads[i].clear();
 			}
 
@@ -11476,6 +12743,21 @@ namespace vitex
 		bool schedule::push_thread(difficulty type, size_t global_index, size_t local_index, bool is_daemon)
 		{
 			thread_data* thread = memory::init<thread_data>(type, policy.preallocated_size, global_index, local_index, is_daemon);
+			if (policy.work_stealing && type != difficulty::timeout)
+				thread->local = memory::init<concurrent_task_queue>(policy.max_recycles);
+
+			if (policy.affinity != thread_affinity::none && !is_daemon && !nodes.empty())
+			{
+				if (policy.affinity == thread_affinity::per_core)
+				{
+					size_t index = global_index % processors.size();
+					while (thread->node_index + 1 < nodes.size() && index >= nodes[thread->node_index].size())
+						index -= nodes[thread->node_index++].size();
+				}
+				else
+					thread->node_index = global_index % nodes.size();
+			}
+
 			if (!thread->daemon)
 			{
 				thread->handle = std::thread(&schedule::trigger_thread, this, type, thread);
@@ -11515,6 +12797,12 @@ namespace vitex
 		bool schedule::has_tasks(difficulty type) const
 		{
 			VI_ASSERT(type != difficulty::count, "difficulty should be set");
+			for (auto* thread : threads[(size_t)type])
+			{
+				if (thread->local != nullptr && thread->local->size() > 0)
+					return true;
+			}
+
 			switch (type)
 			{
 				case difficulty::async:
@@ -11522,7 +12810,7 @@ namespace vitex
 				case difficulty::sync:
 					return sync->queue.size_approx() > 0;
 				case difficulty::timeout:
-					return timeouts->queue.size() > 0;
+					return !timeouts->empty();
 				default:
 					return false;
 			}
@@ -11552,18 +12840,186 @@ namespace vitex
 			debug(thread_message(thread, state, tasks));
 			return true;
 		}
+		bool schedule::steal_ready(difficulty type, thread_data* thread)
+		{
+			if (!thread->local)
+				return false;
+
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			for (auto* victim : threads[(size_t)type])
+			{
+				if (victim != thread && victim->local != nullptr && victim->local->size() > 0)
+					return true;
+			}
+
+			return false;
+		}
+		size_t schedule::unpark_stealers(difficulty type, size_t count)
+		{
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (type == difficulty::async)
+				return async->idle.load() > 0 ? unpark_threads(count) : 0;
+
+			size_t idle = std::min(sync->idle.load(), count);
+			for (size_t i = 0; i < idle; i++)
+				sync->queue.enqueue([]() { });
+			return idle;
+		}
+		size_t schedule::unpark_threads(size_t count)
+		{
+			size_t unparked = 0;
+			while (unparked < count)
+			{
+				thread_data* thread;
+				{
+					umutex<std::mutex> unique(async->update);
+					if (async->parked.empty())
+						break;
+
+					thread = async->parked.back();
+					async->parked.pop_back();
+				}
+				{
+					umutex<std::mutex> unique(thread->update);
+					thread->signal = true;
+				}
+				thread->notify.notify_one();
+				++unparked;
+			}
+			return unparked;
+		}
 		bool schedule::fast_bypass_enqueue(difficulty type, task_callback&& callback)
 		{
 			if (!has_parallel_threads(type))
 				return false;
 
 			auto* thread = (thread_data*)initialize_thread(nullptr, false);
-			if (!thread || thread->type != type || thread->queue.size() >= policy.max_recycles)
+			if (!thread || thread->type != type)
+				return false;
+
+			if (thread->local != nullptr)
+			{
+				auto* shared = (type == difficulty::async ? (concurrent_sync_queue*)async : sync);
+				if (shared->idle.load() > 0)
+					return false;
+
+				thread->local->push(std::move(callback));
+				unpark_stealers(type, 1);
+				return true;
+			}
+			else if (thread->queue.size() >= policy.max_recycles)
 				return false;
 
 			thread->queue.push(std::move(callback));
 			return true;
 		}
+		bool schedule::fast_bypass_dequeue(thread_data* thread, task_callback& callback)
+		{
+			if (thread->local != nullptr)
+			{
+				task_callback* next = thread->local->take();
+				if (!next)
+					return false;
+
+				callback = std::move(*next);
+				memory::deinit(next);
+				return true;
+			}
+			else if (thread->queue.empty())
+				return false;
+
+			callback = std::move(thread->queue.front());
+			thread->queue.pop();
+			return true;
+		}
+		bool schedule::fast_bypass_flush(thread_data* thread)
+		{
+			auto* shared = (thread->type == difficulty::async ? (concurrent_sync_queue*)async : sync);
+			task_callback callback;
+			size_t count = 0;
+			while (fast_bypass_dequeue(thread, callback))
+			{
+				shared->queue.enqueue(std::move(callback));
+				++count;
+			}
+			return count > 0;
+		}
+		bool schedule::steal_dequeue(difficulty type, thread_data* thread, task_callback& callback)
+		{
+			if (!thread->local)
+				return false;
+
+			auto& victims = threads[(size_t)type];
+			size_t count = victims.size();
+			if (count < 2)
+				return false;
+
+			static thread_local uint64_t seed = 0;
+			if (!seed)
+				seed = (uint64_t)(thread->global_index + 1) * 0x9E3779B97F4A7C15ull;
+
+			seed ^= seed << 13;
+			seed ^= seed >> 7;
+			seed ^= seed << 17;
+
+			size_t passes = policy.affinity == thread_affinity::none ? 1 : 2;
+			for (size_t pass = 0; pass < passes; pass++)
+			{
+				for (size_t i = 0, offset = (size_t)(seed % count); i < count; i++)
+				{
+					auto* victim = victims[(offset + i) % count];
+					if (victim == thread || !victim->local || (passes > 1 && (victim->node_index == thread->node_index) != (pass == 0)))
+						continue;
+
+					task_callback* next = victim->local->steal();
+					if (!next)
+						continue;
+
+					callback = std::move(*next);
+					memory::deinit(next);
+					return true;
+				}
+			}
+
+			return false;
+		}
+		size_t schedule::dispatch_timers(std::chrono::microseconds clock)
+		{
+			vector<timeout> expired;
+			timeouts->expire(clock, expired);
+			if (expired.empty())
+				return 0;
+#ifndef NDEBUG
+			report_thread(thread_task::process_timer, expired.size(), get_thread());
+#endif
+			vector<task_callback> batch;
+			batch.reserve(expired.size());
+			for (auto& next : expired)
+			{
+				if (next.alive && active)
+				{
+					batch.emplace_back([this, next = std::move(next)]() mutable
+					{
+						next.callback();
+						umutex<std::mutex> unique(timeouts->update);
+						if (timeouts->wakes(timeouts->reinsert(std::move(next), get_clock())))
+						{
+							timeouts->resync = true;
+							timeouts->notify.notify_all();
+						}
+					});
+				}
+				else
+				{
+					if (next.alive)
+						timeouts->remove(next.id);
+					batch.emplace_back(std::move(next.callback));
+				}
+			}
+
+			sync->queue.enqueue_bulk(std::make_move_iterator(batch.begin()), batch.size());
+			return batch.size();
+		}
 		size_t schedule::get_thread_global_index()
 		{
 			auto* thread = get_thread();
@@ -11624,12 +13080,6 @@ namespace vitex
 		{
 			return policy;
 		}
-		std::chrono::microseconds schedule::get_timeout(std::chrono::microseconds clock)
-		{
-			while (timeouts->queue.find(clock) != timeouts->queue.end())
-				++clock;
-			return clock;
-		}
 		std::chrono::microseconds schedule::get_clock()
 		{
 			return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch());
@@ -16,6 +16,7 @@
 #include <vector>
 #include <charconv>
 #include <cstring>
+#include <cstddef>
 #include <list>
 #include <system_error>
 #include <algorithm>
@@ -34,6 +35,10 @@ namespace vitex
 
 		struct concurrent_sync_queue;
 
+		struct concurrent_task_queue;
+
+		struct concurrent_timeout_queue;
+
 		struct decimal;
 
 		struct cocontext;
@@ -852,6 +857,42 @@ namespace vitex
 				size_t get_elements_count(page_group& page, size_t size);
 			};
 
+			class slab_allocator final : public global_allocator
+			{
+			public:
+				struct page;
+
+				struct thread_cache;
+
+				struct shared_state;
+
+			private:
+				shared_state* state;
+
+			public:
+				slab_allocator(uint64_t minimal_life_time_ms = 2000, size_t page_size_bytes = 65536);
+				~slab_allocator() noexcept override;
+				unique<void> allocate(size_t size) noexcept override;
+				unique<void> allocate(memory_location&& origin, size_t size) noexcept override;
+				void free(unique<void> address) noexcept override;
+				void transfer(unique<void> address, size_t size) noexcept override;
+				void transfer(unique<void> address, memory_location&& origin, size_t size) noexcept override;
+				void watch(memory_location&& origin, void* address) noexcept override;
+				void unwatch(void* address) noexcept override;
+				void finalize() noexcept override;
+				bool is_valid(void* address) noexcept override;
+				bool is_finalizable() noexcept override;
+
+			private:
+				thread_cache* get_thread_cache(bool initialize) noexcept;
+				page* reserve_page(thread_cache* cache, size_t index) noexcept;
+				void release_page(thread_cache* cache, page* target) noexcept;
+
+			public:
+				static size_t get_size_class(size_t size) noexcept;
+				static size_t get_class_size(size_t index) noexcept;
+			};
+
 			class linear_allocator final : public local_allocator
 			{
 			private:
@@ -869,6 +910,8 @@ namespace vitex
 				region* bottom;
 				size_t latest_size;
 				size_t sizing;
+				size_t allocations;
+				size_t reservations;
 
 			public:
 				linear_allocator(size_t size);
@@ -878,6 +921,8 @@ namespace vitex
 				void reset() noexcept override;
 				bool is_valid(void* address) noexcept override;
 				size_t get_leftovers() const noexcept;
+				size_t get_allocations() const noexcept;
+				size_t get_reservations() const noexcept;
 
 			private:
 				void next_region(size_t size) noexcept;
@@ -948,6 +993,56 @@ namespace vitex
 			size_t size() const;
 		};
 
+		class tracing final : public singletonish
+		{
+		public:
+			struct span
+			{
+				const char* file = nullptr;
+				const char* function = nullptr;
+				uint64_t id = 0;
+				uint64_t thread = 0;
+				uint64_t start = 0;
+				uint64_t duration = 0;
+				int line = 0;
+			};
+
+			class scope
+			{
+			private:
+				const char* file;
+				const char* function;
+				uint64_t start;
+				int line;
+
+			public:
+				scope(const char* new_file, const char* new_function, int new_line) noexcept : file(new_file), function(new_function), start(active.load(std::memory_order_relaxed) ? get_clock() : 0), line(new_line)
+				{
+				}
+				scope(const scope&) = delete;
+				scope(scope&&) = delete;
+				~scope() noexcept
+				{
+					if (start > 0)
+						record(file, function, line, start, get_clock());
+				}
+				scope& operator= (const scope&) = delete;
+				scope& operator= (scope&&) = delete;
+			};
+
+		private:
+			static std::atomic<bool> active;
+
+		public:
+			static void set_active(bool enabled) noexcept;
+			static void record(const char* file, const char* function, int line, uint64_t start, uint64_t end) noexcept;
+			static void clear() noexcept;
+			static bool is_active() noexcept;
+			static uint64_t get_clock() noexcept;
+			static vector<span> get_spans() noexcept;
+			static string get_chrome_trace() noexcept;
+		};
+
 		class error_handling final : public singletonish
 		{
 		public:
@@ -2374,14 +2469,6 @@ namespace vitex
 			static void convert_to_wide(const std::string_view& input, wchar_t* output, size_t output_size);
 		};
 
-		struct concurrent_timeout_queue
-		{
-			ordered_map<std::chrono::microseconds, timeout> queue;
-			std::condition_variable notify;
-			std::mutex update;
-			bool resync = true;
-		};
-
 		struct inline_args
 		{
 		public:
@@ -3778,12 +3865,22 @@ namespace vitex
 				process_task,
 				awake,
 				sleep,
+				park,
+				unpark,
 				despawn
 			};
 
+			enum class thread_affinity
+			{
+				none,
+				per_core,
+				per_socket
+			};
+
 			struct thread_data
 			{
 				single_queue<task_callback> queue;
+				concurrent_task_queue* local = nullptr;
 				std::condition_variable notify;
 				std::mutex update;
 				std::thread handle;
@@ -3792,9 +3889,11 @@ namespace vitex
 				difficulty type;
 				size_t global_index;
 				size_t local_index;
+				size_t node_index;
+				bool signal;
 				bool daemon;
 
-				thread_data(difficulty new_type, size_t preallocated_size, size_t new_global_index, size_t new_local_index, bool is_daemon) : allocator(preallocated_size), type(new_type), global_index(new_global_index), local_index(new_local_index), daemon(is_daemon)
+				thread_data(difficulty new_type, size_t preallocated_size, size_t new_global_index, size_t new_local_index, bool is_daemon) : allocator(preallocated_size), type(new_type), global_index(new_global_index), local_index(new_local_index), node_index(0), signal(false), daemon(is_daemon)
 				{
 				}
 				~thread_data() = default;
@@ -3825,7 +3924,9 @@ namespace vitex
 				std::chrono::milliseconds clock_timeout;
 				spawner_callback initialize;
 				activity_callback ping;
+				thread_affinity affinity;
 				bool parallel;
+				bool work_stealing;
 
 				desc();
 				desc(size_t cores);
@@ -3849,6 +3950,9 @@ namespace vitex
 			std::atomic<task_id> generation;
 			std::mutex exclusive;
 			thread_debug_callback debug;
+			os::hw::quantity_info topology;
+			vector<vector<size_t>> nodes;
+			vector<size_t> processors;
 			desc policy;
 			bool terminate;
 			bool enqueue;
@@ -3862,6 +3966,8 @@ namespace vitex
 			task_id set_timeout(uint64_t milliseconds, task_callback&& callback);
 			bool set_task(task_callback&& callback, bool recyclable = true);
 			bool set_coroutine(task_callback&& callback, bool recyclable = true);
+			bool set_tasks(task_callback* callbacks, size_t count);
+			bool set_coroutines(task_callback* callbacks, size_t count);
 			bool set_debug_callback(thread_debug_callback&& callback);
 			bool clear_timeout(task_id work_id);
 			bool trigger_timers();
@@ -3889,14 +3995,21 @@ namespace vitex
 			const thread_data* initialize_thread(thread_data* source, bool update) const;
 			void initialize_spawn_trigger();
 			bool fast_bypass_enqueue(difficulty type, task_callback&& callback);
+			bool fast_bypass_dequeue(thread_data* thread, task_callback& callback);
+			bool steal_dequeue(difficulty type, thread_data* thread, task_callback& callback);
+			bool fast_bypass_flush(thread_data* thread);
+			bool steal_ready(difficulty type, thread_data* thread);
+			size_t unpark_stealers(difficulty type, size_t count);
+			size_t unpark_threads(size_t count);
+			size_t dispatch_timers(std::chrono::microseconds clock);
 			bool report_thread(thread_task state, size_t tasks, const thread_data* thread);
 			bool trigger_thread(difficulty type, thread_data* thread);
 			bool sleep_thread(difficulty type, thread_data* thread);
+			bool pin_thread(thread_data* thread);
 			bool thread_active(thread_data* thread);
 			bool chunk_cleanup();
 			bool push_thread(difficulty type, size_t global_index, size_t local_index, bool is_daemon);
 			bool pop_thread(thread_data* thread);
-			std::chrono::microseconds get_timeout(std::chrono::microseconds clock);
 			task_id get_task_id();
 
 		public:
@@ -4173,60 +4286,171 @@ namespace vitex
 			}
 		};
 
+		class promise_event
+		{
+		public:
+			static constexpr uint8_t waiting = (uint8_t)deferred::waiting;
+			static constexpr uint8_t ready = (uint8_t)deferred::ready;
+			static constexpr uint8_t stored = 4;
+			static constexpr uint8_t subscribed = 8;
+
+		private:
+			struct waiter
+			{
+				std::mutex mutex;
+				std::condition_variable ready;
+				waiter* next = nullptr;
+				bool done = false;
+			};
+
+		private:
+			alignas(std::max_align_t) char storage[sizeof(task_callback) + sizeof(void*) * 4];
+			void(*process)(promise_event*, bool);
+			std::atomic<waiter*> waiters;
+
+		public:
+			promise_event() noexcept : process(nullptr), waiters(nullptr)
+			{
+			}
+			promise_event(const promise_event&) = delete;
+			promise_event(promise_event&&) = delete;
+			~promise_event() noexcept
+			{
+				if (process != nullptr)
+					process(this, false);
+			}
+			promise_event& operator= (const promise_event&) = delete;
+			promise_event& operator= (promise_event&&) = delete;
+			template <typename f>
+			void emplace(f&& callback) noexcept
+			{
+				typedef typename std::decay<f>::type callable;
+				VI_ASSERT(!process, "promise continuation is already set");
+				if constexpr (sizeof(callable) <= sizeof(storage) && alignof(callable) <= alignof(std::max_align_t))
+				{
+					new(storage) callable(std::forward<f>(callback));
+					process = [](promise_event* base, bool invoke)
+					{
+						callable* target = (callable*)base->storage;
+						base->process = nullptr;
+						if (invoke)
+							(*target)();
+						target->~callable();
+					};
+				}
+				else
+				{
+					*(callable**)storage = memory::init<callable>(std::forward<f>(callback));
+					process = [](promise_event* base, bool invoke)
+					{
+						callable* target = *(callable**)base->storage;
+						base->process = nullptr;
+						if (invoke)
+							(*target)();
+						memory::deinit(target);
+					};
+				}
+			}
+			void execute() noexcept
+			{
+				if (process != nullptr)
+					process(this, true);
+			}
+			void wait(std::atomic<uint8_t>& flags) noexcept
+			{
+				waiter target;
+				target.next = waiters.load(std::memory_order_relaxed);
+				while (!waiters.compare_exchange_weak(target.next, &target, std::memory_order_release, std::memory_order_relaxed));
+				if (flags.fetch_or(subscribed, std::memory_order_acq_rel) & ready)
+					notify();
+
+				std::unique_lock<std::mutex> unique(target.mutex);
+				target.ready.wait(unique, [&target]()
+				{
+					return target.done;
+				});
+			}
+			void notify() noexcept
+			{
+				waiter* next = waiters.exchange(nullptr, std::memory_order_acquire);
+				while (next != nullptr)
+				{
+					waiter* target = next;
+					next = target->next;
+					umutex<std::mutex> unique(target->mutex);
+					target->done = true;
+					target->ready.notify_all();
+				}
+			}
+			static deferred to_status(uint8_t flags) noexcept
+			{
+				if (flags & ready)
+					return deferred::ready;
+
+				return flags & waiting ? deferred::waiting : deferred::pending;
+			}
+		};
+
 		template <typename t>
 		struct promise_state
 		{
-			std::mutex update;
-			task_callback event;
+			promise_event event;
 			alignas(t) char value[sizeof(t)];
 			std::atomic<uint32_t> count;
-			std::atomic<deferred> code;
+			std::atomic<uint8_t> flags;
 #ifndef NDEBUG
 			const t* hidden_value = (const t*)value;
 #endif
-			promise_state() noexcept : count(1), code(deferred::pending)
+			promise_state() noexcept : count(1), flags(0)
 			{
 			}
-			promise_state(const t& new_value) noexcept : count(1), code(deferred::ready)
+			promise_state(const t& new_value) noexcept : count(1), flags(promise_event::ready)
 			{
 				option_utils::copy_buffer<t>(value, (const char*)&new_value, sizeof(t));
 			}
-			promise_state(t&& new_value) noexcept : count(1), code(deferred::ready)
+			promise_state(t&& new_value) noexcept : count(1), flags(promise_event::ready)
 			{
 				option_utils::move_buffer<t>(value, (char*)&new_value, sizeof(t));
 			}
 			~promise_state()
 			{
-				if (code == deferred::ready)
+				if (is_ready())
 					((t*)value)->~t();
 			}
 			void emplace(const t& new_value)
 			{
-				VI_ASSERT(code != deferred::ready, "emplacing to already initialized memory is not desired");
+				VI_ASSERT(!is_ready(), "emplacing to already initialized memory is not desired");
 				option_utils::copy_buffer<t>(value, (const char*)&new_value, sizeof(t));
 			}
 			void emplace(t&& new_value)
 			{
-				VI_ASSERT(code != deferred::ready, "emplacing to already initialized memory is not desired");
+				VI_ASSERT(!is_ready(), "emplacing to already initialized memory is not desired");
 				option_utils::move_buffer<t>(value, (char*)&new_value, sizeof(t));
 			}
 			t& unwrap()
 			{
-				VI_PANIC(code == deferred::ready, "unwrapping uninitialized memory will result in an undefined behaviour");
+				VI_PANIC(is_ready(), "unwrapping uninitialized memory will result in an undefined behaviour");
 				return *(t*)value;
 			}
+			bool is_ready() const noexcept
+			{
+				return flags.load(std::memory_order_acquire) & promise_event::ready;
+			}
 		};
 
 		template <>
 		struct promise_state<void>
 		{
-			std::mutex update;
-			task_callback event;
+			promise_event event;
 			std::atomic<uint32_t> count;
-			std::atomic<deferred> code;
+			std::atomic<uint8_t> flags;
 
-			promise_state() noexcept : count(1), code(deferred::pending)
+			promise_state() noexcept : count(1), flags(0)
+			{
+			}
+			bool is_ready() const noexcept
 			{
+				return flags.load(std::memory_order_acquire) & promise_event::ready;
 			}
 		};
 
@@ -4288,35 +4512,24 @@ namespace vitex
 			}
 			void set(const t& other) noexcept
 			{
-				VI_ASSERT(data != nullptr && data->code != deferred::ready, "async should be pending");
-				umutex<std::mutex> unique(data->update);
-				bool async = (data->code != deferred::waiting);
+				VI_ASSERT(data != nullptr && !data->is_ready(), "async should be pending");
 				data->emplace(other);
-				data->code = deferred::ready;
-				execute(data, unique, async);
+				settle(data);
 			}
 			void set(t&& other) noexcept
 			{
-				VI_ASSERT(data != nullptr && data->code != deferred::ready, "async should be pending");
-				umutex<std::mutex> unique(data->update);
-				bool async = (data->code != deferred::waiting);
+				VI_ASSERT(data != nullptr && !data->is_ready(), "async should be pending");
 				data->emplace(std::move(other));
-				data->code = deferred::ready;
-				execute(data, unique, async);
+				settle(data);
 			}
 			void set(const basic_promise& other) noexcept
 			{
-				VI_ASSERT(data != nullptr && data->code != deferred::ready, "async should be pending");
+				VI_ASSERT(data != nullptr && !data->is_ready(), "async should be pending");
 				status* copy = add_ref();
 				other.when([copy](t&& value) mutable
 				{
-					{
-						umutex<std::mutex> unique(copy->update);
-						bool async = (copy->code != deferred::waiting);
-						copy->emplace(std::move(value));
-						copy->code = deferred::ready;
-						execute(copy, unique, async);
-					}
+					copy->emplace(std::move(value));
+					settle(copy);
 					release(copy);
 				});
 			}
@@ -4338,25 +4551,29 @@ namespace vitex
 				if (!is_pending())
 					return;
 
-				status* copy;
+				if (data->flags.load(std::memory_order_acquire) & promise_event::stored)
+					return data->event.wait(data->flags);
+
+				std::mutex mutex;
+				std::condition_variable ready;
+				bool done = false;
+				status* copy = add_ref();
+				copy->flags.fetch_or(promise_event::waiting, std::memory_order_relaxed);
+				store([copy, &mutex, &ready, &done]()
 				{
-					std::unique_lock<std::mutex> unique(data->update);
-					if (data->code == deferred::ready)
-						return;
-
-					std::condition_variable ready;
-					copy = add_ref();
-					copy->code = deferred::waiting;
-					copy->event = [&ready]()
 					{
+						umutex<std::mutex> unique(mutex);
+						done = true;
 						ready.notify_all();
-					};
-					ready.wait(unique, [this]()
-					{
-						return !is_pending();
-					});
-				}
-				release(copy);
+					}
+					release(copy);
+				});
+
+				std::unique_lock<std::mutex> unique(mutex);
+				ready.wait(unique, [&done]()
+				{
+					return done;
+				});
 			}
 			t&& get() noexcept
 			{
@@ -4365,11 +4582,11 @@ namespace vitex
 			}
 			deferred get_status() const noexcept
 			{
-				return data ? data->code.load() : deferred::ready;
+				return data ? promise_event::to_status(data->flags.load(std::memory_order_acquire)) : deferred::ready;
 			}
 			bool is_pending() const noexcept
 			{
-				return data ? data->code != deferred::ready : false;
+				return data ? !data->is_ready() : false;
 			}
 			bool is_null() const noexcept
 			{
@@ -4445,12 +4662,13 @@ namespace vitex
 
 				return std::move(data->unwrap());
 			}
-			void store(task_callback&& callback) const noexcept
+			template <typename f>
+			void store(f&& callback) const noexcept
 			{
-				umutex<std::mutex> unique(data->update);
-				data->event = std::move(callback);
-				if (data->code == deferred::ready)
-					execute(data, unique, false);
+				data->event.emplace(std::forward<f>(callback));
+				uint8_t flags = data->flags.fetch_or(promise_event::stored, std::memory_order_acq_rel);
+				if (flags & promise_event::ready)
+					execute(data, false);
 			}
 
 		public:
@@ -4460,14 +4678,22 @@ namespace vitex
 			}
 
 		private:
-			static void execute(status* state, umutex<std::mutex>& unique, bool async) noexcept
+			static void settle(status* state) noexcept
+			{
+				uint8_t flags = state->flags.fetch_or(promise_event::ready, std::memory_order_acq_rel);
+				if (flags & promise_event::stored)
+					execute(state, !(flags & promise_event::waiting));
+				if (flags & promise_event::subscribed)
+					state->event.notify();
+			}
+			static void execute(status* state, bool async) noexcept
 			{
-				if (state->event)
+				++state->count;
+				executor()([state]()
 				{
-					task_callback callback = std::move(state->event);
-					unique.negate();
-					executor()(std::move(callback), async);
-				}
+					state->event.execute();
+					release(state);
+				}, async);
 			}
 			static void release(status* state) noexcept
 			{
@@ -4615,24 +4841,16 @@ namespace vitex
 			}
 			void set() noexcept
 			{
-				VI_ASSERT(data != nullptr && data->code != deferred::ready, "async should be pending");
-				umutex<std::mutex> unique(data->update);
-				bool async = (data->code != deferred::waiting);
-				data->code = deferred::ready;
-				execute(data, unique, async);
+				VI_ASSERT(data != nullptr && !data->is_ready(), "async should be pending");
+				settle(data);
 			}
 			void set(const basic_promise& other) noexcept
 			{
-				VI_ASSERT(data != nullptr && data->code != deferred::ready, "async should be pending");
+				VI_ASSERT(data != nullptr && !data->is_ready(), "async should be pending");
 				status* copy = add_ref();
 				other.when([copy]() mutable
 				{
-					{
-						umutex<std::mutex> unique(copy->update);
-						bool async = (copy->code != deferred::waiting);
-						copy->code = deferred::ready;
-						execute(copy, unique, async);
-					}
+					settle(copy);
 					release(copy);
 				});
 			}
@@ -4654,25 +4872,29 @@ namespace vitex
 				if (!is_pending())
 					return;
 
-				status* copy;
+				if (data->flags.load(std::memory_order_acquire) & promise_event::stored)
+					return data->event.wait(data->flags);
+
+				std::mutex mutex;
+				std::condition_variable ready;
+				bool done = false;
+				status* copy = add_ref();
+				copy->flags.fetch_or(promise_event::waiting, std::memory_order_relaxed);
+				store([copy, &mutex, &ready, &done]()
 				{
-					std::unique_lock<std::mutex> lock(data->update);
-					if (data->code == deferred::ready)
-						return;
-
-					std::condition_variable ready;
-					copy = add_ref();
-					copy->code = deferred::waiting;
-					copy->event = [&ready]()
 					{
+						umutex<std::mutex> unique(mutex);
+						done = true;
 						ready.notify_all();
-					};
-					ready.wait(lock, [this]()
-					{
-						return !is_pending();
-					});
-				}
-				release(copy);
+					}
+					release(copy);
+				});
+
+				std::unique_lock<std::mutex> unique(mutex);
+				ready.wait(unique, [&done]()
+				{
+					return done;
+				});
 			}
 			void get() noexcept
 			{
@@ -4680,11 +4902,11 @@ namespace vitex
 			}
 			deferred get_status() const noexcept
 			{
-				return data ? data->code.load() : deferred::ready;
+				return data ? promise_event::to_status(data->flags.load(std::memory_order_acquire)) : deferred::ready;
 			}
 			bool is_pending() const noexcept
 			{
-				return data ? data->code != deferred::ready : false;
+				return data ? !data->is_ready() : false;
 			}
 			bool is_null() const noexcept
 			{
@@ -4784,12 +5006,13 @@ namespace vitex
 				if (!data)
 					data = memory::init<status>();
 			}
-			void store(task_callback&& callback) const noexcept
+			template <typename f>
+			void store(f&& callback) const noexcept
 			{
-				umutex<std::mutex> unique(data->update);
-				data->event = std::move(callback);
-				if (data->code == deferred::ready)
-					execute(data, unique, false);
+				data->event.emplace(std::forward<f>(callback));
+				uint8_t flags = data->flags.fetch_or(promise_event::stored, std::memory_order_acq_rel);
+				if (flags & promise_event::ready)
+					execute(data, false);
 			}
 
 		public:
@@ -4799,14 +5022,22 @@ namespace vitex
 			}
 
 		private:
-			static void execute(status* state, umutex<std::mutex>& unique, bool async) noexcept
+			static void settle(status* state) noexcept
+			{
+				uint8_t flags = state->flags.fetch_or(promise_event::ready, std::memory_order_acq_rel);
+				if (flags & promise_event::stored)
+					execute(state, !(flags & promise_event::waiting));
+				if (flags & promise_event::subscribed)
+					state->event.notify();
+			}
+			static void execute(status* state, bool async) noexcept
 			{
-				if (state->event)
+				++state->count;
+				executor()([state]()
 				{
-					task_callback callback = std::move(state->event);
-					unique.negate();
-					executor()(std::move(callback), async);
-				}
+					state->event.execute();
+					release(state);
+				}, async);
 			}
 			static void release(status* state) noexcept
 			{
@@ -469,10 +469,26 @@ namespace vitex
 			VI_ASSERT(!callbacks.empty(), "callbacks should not be empty");
 			core::vector<core::promise<void>> result;
 			result.reserve(callbacks.size());
+			if (!core::schedule::is_available(core::difficulty::sync))
+			{
+				for (auto& callback : callbacks)
+					result.emplace_back(enqueue(std::move(callback)));
+				return result;
+			}
 
 			for (auto& callback : callbacks)
-				result.emplace_back(enqueue(std::move(callback)));
+			{
+				VI_ASSERT(callback != nullptr, "callback should be set");
+				core::promise<void> task;
+				result.emplace_back(task);
+				callback = [task, callback = std::move(callback)]() mutable
+				{
+					callback();
+					task.set();
+				};
+			}
 
+			core::schedule::get()->set_tasks(callbacks.data(), callbacks.size());
 			return result;
 		}
 		void parallel::wait(core::promise<void>&& value)
@@ -1310,9 +1326,9 @@ namespace vitex
 			if (control.usage & (size_t)USE_NETWORKING)
 			{
 				if (network::multiplexer::has_instance())
-					network::multiplexer::get()->rescale(control.polling_timeout, control.polling_events);
+					network::multiplexer::get()->rescale(control.polling_timeout, control.polling_events, control.polling_shards);
 				else
-					new network::multiplexer(control.polling_timeout, control.polling_events);
+					new network::multiplexer(control.polling_timeout, control.polling_events, control.polling_shards);
 			}
 
 			if (control.usage & (size_t)USE_SCRIPTING)
@@ -84,95 +84,95 @@ namespace vitex
 			template <typename function>
 			static core::vector<core::promise<void>> for_loop(size_t size, size_t threshold_size, function callback)
 			{
-				core::vector<core::promise<void>> tasks;
 				if (!size)
-					return tasks;
+					return core::vector<core::promise<void>>();
 
 				size_t threads = std::max<size_t>(1, get_threads());
 				if (core::schedule::is_available() && threads > 1 && size > threshold_size)
 				{
+					core::vector<core::task_callback> callbacks;
 					size_t begin = 0, end = size;
 					size_t step = size / threads;
 					size_t remains = size % threads;
-					tasks.reserve(threads);
+					callbacks.reserve(threads);
 					while (begin != end)
 					{
 						auto offset = begin;
 						begin += remains > 0 ? --remains, step + 1 : step;
-						tasks.emplace_back(core::cotask<void>([offset, begin, &callback]()
+						callbacks.emplace_back([offset, begin, &callback]()
 						{
 							for (size_t i = offset; i < begin; i++)
 								callback(i);
-						}, false));
+						});
 					}
+					return enqueue_all(std::move(callbacks));
 				}
-				else
-				{
-					for (size_t i = 0; i < size; i++)
-						callback(i);
-				}
-				return tasks;
+
+				for (size_t i = 0; i < size; i++)
+					callback(i);
+				return core::vector<core::promise<void>>();
 			}
 			template <typename iterator, typename function>
 			static core::vector<core::promise<void>> for_each(iterator begin, iterator end, size_t threshold_size, function callback)
 			{
-				core::vector<core::promise<void>> tasks;
 				size_t size = end - begin;
 				if (!size)
-					return tasks;
+					return core::vector<core::promise<void>>();
 
 				size_t threads = std::max<size_t>(1, get_threads());
 				if (core::schedule::is_available() && threads > 1 && size > threshold_size)
 				{
+					core::vector<core::task_callback> callbacks;
 					size_t step = size / threads;
 					size_t remains = size % threads;
-					tasks.reserve(threads);
+					callbacks.reserve(threads);
 					while (begin != end)
 					{
 						auto offset = begin;
 						begin += remains > 0 ? --remains, step + 1 : step;
-						tasks.emplace_back(core::cotask<void>(std::bind(std::for_each<iterator, function>, offset, begin, callback), false));
+						callbacks.emplace_back(std::bind(std::for_each<iterator, function>, offset, begin, callback));
 					}
+					return enqueue_all(std::move(callbacks));
 				}
-				else
-					std::for_each(begin, end, callback);
-				return tasks;
+
+				std::for_each(begin, end, callback);
+				return core::vector<core::promise<void>>();
 			}
 			template <typename iterator, typename function>
 			static core::vector<core::promise<void>> for_each_sequential(iterator begin, iterator end, size_t size, size_t threshold_size, function callback)
 			{
-				core::vector<core::promise<void>> tasks;
 				if (!size)
-					return tasks;
+					return core::vector<core::promise<void>>();
 
 				size_t threads = std::max<size_t>(1, get_threads());
 				if (core::schedule::is_available() && threads > 1 && size > threshold_size)
 				{
+					core::vector<core::task_callback> callbacks;
 					size_t step = size / threads;
 					size_t remains = size % threads;
-					tasks.reserve(threads);
+					callbacks.reserve(threads);
 					while (begin != end)
 					{
 						auto offset = begin;
 						size_t count = remains > 0 ? --remains, step + 1 : step;
 						while (count-- > 0)
 							++begin;
-						tasks.emplace_back(core::cotask<void>(std::bind(std::for_each<iterator, function>, offset, begin, callback), false));
+						callbacks.emplace_back(std::bind(std::for_each<iterator, function>, offset, begin, callback));
 					}
+					return enqueue_all(std::move(callbacks));
 				}
-				else
-					std::for_each(begin, end, callback);
-				return tasks;
+
+				std::for_each(begin, end, callback);
+				return core::vector<core::promise<void>>();
 			}
 			template <typename iterator, typename init_function, typename element_function>
 			static core::vector<core::promise<void>> distribute(iterator begin, iterator end, size_t threshold_size, init_function&& init_callback, element_function&& element_callback)
 			{
-				core::vector<core::promise<void>> tasks;
 				size_t size = end - begin;
 				if (!size)
 				{
 					init_callback((size_t)0);
-					return tasks;
+					return core::vector<core::promise<void>>();
 				}
 
 				size_t threads = std::max<size_t>(1, get_threads());
@@ -190,7 +190,8 @@ namespace vitex
 						++counting;
 					}
 
-					tasks.reserve(counting);
+					core::vector<core::task_callback> callbacks;
+					callbacks.reserve(counting);
 					init_callback(counting);
 
 					while (begin != end)
@@ -198,20 +199,18 @@ namespace vitex
 						auto offset = begin;
 						auto bound = std::bind(element_callback, index++, std::placeholders::_1);
 						begin += remains > 0 ? --remains, step + 1 : step;
-						tasks.emplace_back(enqueue([offset, begin, bound]()
+						callbacks.emplace_back([offset, begin, bound]()
 						{
 							std::for_each<iterator, decltype(bound)>(offset, begin, bound);
-						}));
+						});
 					}
-				}
-				else
-				{
-					init_callback((size_t)1);
-					auto bound = std::bind(element_callback, (size_t)0, std::placeholders::_1);
-					std::for_each<iterator, decltype(bound)>(begin, end, bound);
+					return enqueue_all(std::move(callbacks));
 				}
 
-				return tasks;
+				init_callback((size_t)1);
+				auto bound = std::bind(element_callback, (size_t)0, std::placeholders::_1);
+				std::for_each<iterator, decltype(bound)>(begin, end, bound);
+				return core::vector<core::promise<void>>();
 			}
 		};
 
@@ -429,6 +428,7 @@ namespace vitex
 				core::string directory;
 				size_t polling_timeout = 100;
 				size_t polling_events = 256;
+				size_t polling_shards = 1;
 				size_t threads = 0;
 				size_t usage =
 					(size_t)USE_PROCESSING |
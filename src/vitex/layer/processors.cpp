@@ -164,6 +164,9 @@ namespace vitex
 					network::socket_certificate* cert = &router->certificates[name];
 					series::unpack(it->find("ciphers"), &cert->ciphers);
 					series::unpack(it->find("verify-peers"), &cert->verify_peers);
+					series::unpack_a(it->find("session-cache-size"), &cert->session_cache_size);
+					series::unpack(it->find("session-timeout"), &cert->session_timeout);
+					series::unpack(it->find("ticket-rotation"), &cert->ticket_rotation);
 					series::unpack(it->find("pkey"), &cert->blob.private_key);
 					series::unpack(it->find("cert"), &cert->blob.certificate);
 					if (series::unpack(it->find("options"), &name))
@@ -180,6 +183,8 @@ namespace vitex
 							cert->options = (network::secure_layer_options)((size_t)cert->options & (size_t)network::secure_layer_options::no_tlsv12);
 						if (name.find("no_tls_v1_3") != std::string::npos)
 							cert->options = (network::secure_layer_options)((size_t)cert->options & (size_t)network::secure_layer_options::no_tlsv13);
+						if (name.find("ktls") != std::string::npos)
+							cert->options = (network::secure_layer_options)((size_t)cert->options | (size_t)network::secure_layer_options::ktls);
 					}
 
 					core::stringify::eval_envs(cert->blob.private_key, base_directory, net_addresses);
@@ -228,6 +233,7 @@ namespace vitex
 					series::unpack_a(network->find("payload-max-length"), &router->max_heap_buffer);
 					series::unpack_a(network->find("payload-max-length"), &router->max_net_buffer);
 					series::unpack_a(network->find("backlog-queue"), &router->backlog_queue);
+					series::unpack_a(network->find("accept-shards"), &router->accept_shards);
 					series::unpack_a(network->find("socket-timeout"), &router->socket_timeout);
 					series::unpack(network->find("graceful-time-wait"), &router->graceful_time_wait);
 					series::unpack_a(network->find("max-connections"), &router->max_connections);
@@ -243,6 +249,11 @@ namespace vitex
 					series::unpack(network->fetch("session.cookie.http-only"), &router->session.cookie.http_only);
 					series::unpack(network->fetch("session.directory"), &router->session.directory);
 					series::unpack(network->fetch("session.expires"), &router->session.expires);
+					series::unpack(network->fetch("http2.enabled"), &router->http2.enabled);
+					series::unpack_a(network->fetch("http2.max-concurrent-streams"), &router->http2.max_concurrent_streams);
+					series::unpack_a(network->fetch("http2.initial-window-size"), &router->http2.initial_window_size);
+					series::unpack_a(network->fetch("http2.max-frame-size"), &router->http2.max_frame_size);
+					series::unpack_a(network->fetch("http2.header-table-size"), &router->http2.header_table_size);
 					core::stringify::eval_envs(router->session.directory, base_directory, net_addresses);
 					core::stringify::eval_envs(router->temporary_directory, base_directory, net_addresses);
 
@@ -319,12 +330,16 @@ namespace vitex
 							series::unpack(base->fetch("auth.type"), &route->auth.type);
 							series::unpack(base->fetch("auth.realm"), &route->auth.realm);
 							series::unpack_a(base->fetch("compression.min-length"), &route->compression.min_length);
+							series::unpack(base->fetch("compression.precompressed"), &route->compression.precompressed);
+							series::unpack(base->fetch("compression.cache"), &route->compression.cache);
 							series::unpack(base->fetch("compression.enabled"), &route->compression.enabled);
 							series::unpack(base->find("char-set"), &route->char_set);
 							series::unpack(base->find("access-control-allow-origin"), &route->access_control_allow_origin);
 							series::unpack(base->find("redirect"), &route->redirect);
 							series::unpack_a(base->find("web-socket-timeout"), &route->web_socket_timeout);
 							series::unpack_a(base->find("static-file-max-age"), &route->static_file_max_age);
+							series::unpack_a(base->find("file-cache-size"), &route->file_cache_size);
+							series::unpack_a(base->find("file-cache-ttl"), &route->file_cache_ttl);
 							series::unpack(base->find("allow-directory-listing"), &route->allow_directory_listing);
 							series::unpack(base->find("allow-web-socket"), &route->allow_web_socket);
 							series::unpack(base->find("allow-send-file"), &route->allow_send_file);
@@ -5,6 +5,8 @@
 #define NET_KQUEUE 1
 #elif defined(__sun) && defined(__SVR4)
 #define NET_POLL 1
+#elif defined(VI_LINUX) && defined(VI_URING)
+#define NET_URING 1
 #elif defined(VI_LINUX)
 #define NET_EPOLL 1
 #else
@@ -35,6 +37,12 @@
 #ifdef NET_EPOLL
 #include <sys/epoll.h>
 #include <sys/sendfile.h>
+#elif defined(NET_URING)
+#include <linux/io_uring.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
 #else
 #include <sys/event.h>
 #endif
@@ -49,8 +57,27 @@
 #define SD_BOTH SHUT_RDWR
 #endif
 #define DNS_TIMEOUT 21600
+#define DNS_NEGATIVE_TIMEOUT 60
+#define DNS_QUERY_TIMEOUT 2000
+#define DNS_QUERY_ATTEMPTS 2
+#define DNS_MAX_PACKET 4096
+#define DNS_TYPE_A 1
+#define DNS_TYPE_SOA 6
+#define DNS_TYPE_AAAA 28
+#define DNS_RCODE_NXDOMAIN 3
 #define CONNECT_TIMEOUT 2000
-#define MAX_READ_UNTIL 512
+#define CONNECT_ATTEMPT_DELAY 250
+#define UPLINK_IDLE_TIMEOUT 30000
+#define MAX_READ_UNTIL 8192
+#define MAX_WRITE_VECTORS 64
+#define MAX_WRITE_RECORD 16384
+#define READY_READ 1
+#define READY_WRITE 2
+#define READY_CLOSE 4
+#define READY_EPOCH 8
+#define TLS_SESSION_SHARDS 16
+#define TLS_TICKET_NAME 16
+#define TLS_TICKET_KEY 32
 #define CLOSE_TIMEOUT 10
 #define SERVER_BLOCKED_WAIT_US 100
 #pragma warning(push)
@@ -68,6 +95,11 @@ extern "C"
 #include <openssl/engine.h>
 #include <openssl/conf.h>
 #include <openssl/dh.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#if OPENSSL_VERSION_MAJOR >= 3
+#include <openssl/core_names.h>
+#endif
 }
 #undef hex_to_string
 #endif
@@ -92,10 +124,22 @@ namespace vitex
 			if (!core::os::control::has(core::access_option::net))
 				return std::make_error_condition(std::errc::permission_denied);
 
+#if defined(VI_LINUX) && defined(SOCK_NONBLOCK) && defined(SOCK_CLOEXEC)
+			socket_t socket = (socket_t)accept4(fd, address, address_length, SOCK_NONBLOCK | SOCK_CLOEXEC);
+			if (socket == INVALID_SOCKET)
+				return utils::get_last_error(nullptr, -1);
+#else
 			socket_t socket = (socket_t)accept(fd, address, address_length);
 			if (socket == INVALID_SOCKET)
 				return utils::get_last_error(nullptr, -1);
-
+#ifdef VI_MICROSOFT
+			unsigned long mode = 1;
+			ioctlsocket(socket, (long)FIONBIO, &mode);
+#else
+			fcntl(socket, F_SETFL, fcntl(socket, F_GETFL, 0) | O_NONBLOCK);
+			fcntl(socket, F_SETFD, FD_CLOEXEC);
+#endif
+#endif
 			return socket;
 		}
 		static core::expects_io<void> set_socket_blocking(socket_t fd, bool enabled)
@@ -116,6 +160,51 @@ namespace vitex
 #endif
 			return core::expectation::met;
 		}
+		static size_t find_delimiter(const uint8_t* data, size_t size, const std::string_view& match, size_t& index)
+		{
+			size_t offset = 0;
+			while (index > 0 && offset < size)
+			{
+				if (data[offset] != (uint8_t)match[index])
+				{
+					index = 0;
+					break;
+				}
+
+				++offset;
+				if (++index >= match.size())
+					return offset;
+			}
+
+			while (offset < size)
+			{
+				auto* next = (const uint8_t*)memchr(data + offset, match.front(), size - offset);
+				if (!next)
+					return size;
+
+				offset = (size_t)(next - data);
+				size_t length = std::min(match.size(), size - offset);
+				if (!memcmp(next, match.data(), length))
+				{
+					index = length;
+					return offset + length;
+				}
+
+				++offset;
+			}
+
+			return offset;
+		}
+		static void latch_readiness(std::atomic<uint64_t>& readiness, uint64_t flags)
+		{
+			uint64_t value = readiness.load(std::memory_order_relaxed);
+			while (!readiness.compare_exchange_weak(value, (value + READY_EPOCH) | flags, std::memory_order_acq_rel));
+		}
+		static void unlatch_readiness(std::atomic<uint64_t>& readiness, uint64_t snapshot, uint64_t flags)
+		{
+			if (snapshot & flags)
+				readiness.compare_exchange_strong(snapshot, snapshot & ~flags, std::memory_order_acq_rel);
+		}
 		static core::string get_address_identification(const socket_address& address)
 		{
 			core::string result;
@@ -166,55 +255,221 @@ namespace vitex
 
 			return true;
 		}
-		static addrinfo* try_connect_dns(const core::unordered_map<socket_t, addrinfo*>& hosts, uint64_t timeout)
+		static addrinfo* try_connect_dns(const core::vector<std::pair<socket_t, addrinfo*>>& hosts, uint64_t timeout)
 		{
 			VI_MEASURE(core::timings::networking);
-
-			core::vector<pollfd> sockets4, sockets6;
-			for (auto& host : hosts)
+			core::vector<addrinfo*> targets;
+			core::vector<pollfd> sockets;
+			auto time = core::schedule::get_clock();
+			size_t next = 0;
+			while (true)
 			{
-				VI_DEBUG("[net] resolve dns on fd %i", (int)host.first);
-				set_socket_blocking(host.first, false);
-				int status = connect(host.first, host.second->ai_addr, (int)host.second->ai_addrlen);
-				if (status != 0 && utils::get_last_error(nullptr, status) != std::errc::operation_would_block)
+				if (next < hosts.size())
+				{
+					auto& host = hosts[next++];
+					VI_DEBUG("[net] resolve dns on fd %i", (int)host.first);
+					set_socket_blocking(host.first, false);
+					int status = connect(host.first, host.second->ai_addr, (int)host.second->ai_addrlen);
+					if (status == 0)
+						return host.second;
+					else if (utils::get_last_error(nullptr, status) != std::errc::operation_would_block)
+						continue;
+
+					pollfd fd;
+					fd.fd = host.first;
+					fd.events = POLLOUT;
+					fd.revents = 0;
+					sockets.push_back(fd);
+					targets.push_back(host.second);
+				}
+				else if (sockets.empty())
+					return nullptr;
+
+				uint64_t elapsed = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(core::schedule::get_clock() - time).count();
+				if (elapsed >= timeout)
+					return nullptr;
+
+				uint64_t wait = timeout - elapsed;
+				if (next < hosts.size())
+					wait = std::min<uint64_t>(wait, CONNECT_ATTEMPT_DELAY);
+				if (sockets.empty() || utils::poll(sockets.data(), (int)sockets.size(), (int)wait) <= 0)
 					continue;
 
-				pollfd fd;
-				fd.fd = host.first;
-				fd.events = POLLOUT;
-				if (host.second->ai_family == AF_INET6)
-					sockets6.push_back(fd);
-				else
-					sockets4.push_back(fd);
+				for (size_t i = 0; i < sockets.size(); i++)
+				{
+					auto& fd = sockets[i];
+					if (!fd.revents)
+						continue;
+
+					int error = 0;
+					socklen_t size = sizeof(error);
+					getsockopt(fd.fd, SOL_SOCKET, SO_ERROR, (char*)&error, &size);
+					if ((fd.revents & POLLOUT) && !error)
+						return targets[i];
+
+					sockets.erase(sockets.begin() + i);
+					targets.erase(targets.begin() + i--);
+				}
+			}
+		}
+		static addrinfo get_lookup_hints(dns_type resolver, socket_protocol proto, socket_type type)
+		{
+			struct addrinfo hints;
+			memset(&hints, 0, sizeof(struct addrinfo));
+			hints.ai_family = AF_UNSPEC;
+			switch (proto)
+			{
+				case socket_protocol::IP:
+					hints.ai_protocol = IPPROTO_IP;
+					break;
+				case socket_protocol::ICMP:
+					hints.ai_protocol = IPPROTO_ICMP;
+					break;
+				case socket_protocol::UDP:
+					hints.ai_protocol = IPPROTO_UDP;
+					break;
+				case socket_protocol::RAW:
+					hints.ai_protocol = IPPROTO_RAW;
+					break;
+				case socket_protocol::TCP:
+				default:
+					hints.ai_protocol = IPPROTO_TCP;
+					break;
+			}
+			switch (type)
+			{
+				case socket_type::datagram:
+					hints.ai_socktype = SOCK_DGRAM;
+					break;
+				case socket_type::raw:
+					hints.ai_socktype = SOCK_RAW;
+					break;
+				case socket_type::reliably_delivered_message:
+					hints.ai_socktype = SOCK_RDM;
+					break;
+				case socket_type::sequence_packet_stream:
+					hints.ai_socktype = SOCK_SEQPACKET;
+					break;
+				case socket_type::stream:
+				default:
+					hints.ai_socktype = SOCK_STREAM;
+					break;
+			}
+			switch (resolver)
+			{
+				case dns_type::connect:
+					hints.ai_flags = AI_CANONNAME;
+					break;
+				case dns_type::listen:
+					hints.ai_flags = AI_CANONNAME | AI_PASSIVE;
+					break;
+				default:
+					break;
 			}
+			return hints;
+		}
+		static size_t get_lookup_hash(const std::string_view& hostname, const std::string_view& service, dns_type resolver, socket_protocol proto, socket_type type)
+		{
+			char buffer[core::CHUNK_SIZE];
+			size_t header_size = sizeof(uint16_t) * 7;
+			size_t max_service_size = sizeof(buffer) - header_size;
+			size_t service_size = std::min<size_t>(service.size(), max_service_size);
+			size_t hostname_size = std::min<size_t>(hostname.size(), max_service_size - service_size);
+			memcpy(buffer + sizeof(uint32_t) * 0, &resolver, sizeof(uint32_t));
+			memcpy(buffer + sizeof(uint32_t) * 1, &proto, sizeof(uint32_t));
+			memcpy(buffer + sizeof(uint32_t) * 2, &type, sizeof(uint32_t));
+			memcpy(buffer + sizeof(uint32_t) * 3, service.data(), service_size);
+			memcpy(buffer + sizeof(uint32_t) * 3 + service_size, hostname.data(), hostname_size);
 
-			if (!sockets4.empty() && utils::poll(sockets4.data(), (int)sockets4.size(), (int)timeout) > 0)
+			core::key_hasher<core::string> hasher;
+			return hasher(std::string_view(buffer, header_size + service_size + hostname_size));
+		}
+		static socket_address get_lookup_address(const std::string_view& hostname, uint16_t port, int family, const uint8_t* data, const addrinfo& hints)
+		{
+			sockaddr_in address4;
+			sockaddr_in6 address6;
+			addrinfo info = hints;
+			info.ai_family = family;
+			info.ai_canonname = nullptr;
+			info.ai_next = nullptr;
+			if (family == AF_INET6)
+			{
+				memset(&address6, 0, sizeof(address6));
+				address6.sin6_family = AF_INET6;
+				address6.sin6_port = htons(port);
+				memcpy(&address6.sin6_addr, data, sizeof(address6.sin6_addr));
+				info.ai_addr = (sockaddr*)&address6;
+				info.ai_addrlen = sizeof(address6);
+			}
+			else
 			{
-				for (auto& fd : sockets4)
-				{
-					if (fd.revents & POLLOUT)
-					{
-						auto it = hosts.find(fd.fd);
-						if (it != hosts.end())
-							return it->second;
-					}
-				}
+				memset(&address4, 0, sizeof(address4));
+				address4.sin_family = AF_INET;
+				address4.sin_port = htons(port);
+				memcpy(&address4.sin_addr, data, sizeof(address4.sin_addr));
+				info.ai_addr = (sockaddr*)&address4;
+				info.ai_addrlen = sizeof(address4);
+			}
+			return socket_address(hostname, port, &info);
+		}
+		static core::vector<socket_address> get_lookup_order(core::vector<socket_address>&& addresses6, core::vector<socket_address>&& addresses4)
+		{
+			core::vector<socket_address> result;
+			result.reserve(addresses6.size() + addresses4.size());
+			for (size_t i = 0; i < std::max(addresses6.size(), addresses4.size()); i++)
+			{
+				if (i < addresses6.size())
+					result.push_back(std::move(addresses6[i]));
+				if (i < addresses4.size())
+					result.push_back(std::move(addresses4[i]));
+			}
+			return result;
+		}
+		static bool write_dns_query(core::string& packet, uint16_t id, const std::string_view& hostname, uint16_t type)
+		{
+			uint8_t header[12] = { (uint8_t)(id >> 8), (uint8_t)(id & 0xFF), 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+			packet.assign((char*)header, sizeof(header));
+			size_t offset = 0;
+			while (offset < hostname.size())
+			{
+				size_t end = hostname.find('.', offset);
+				if (end == std::string::npos)
+					end = hostname.size();
+
+				size_t size = end - offset;
+				if (!size || size > 63)
+					return false;
+
+				packet.push_back((char)size);
+				packet.append(hostname.substr(offset, size));
+				offset = end + 1;
 			}
 
-			if (!sockets6.empty() && utils::poll(sockets6.data(), (int)sockets6.size(), (int)timeout) > 0)
+			uint8_t footer[5] = { 0x00, (uint8_t)(type >> 8), (uint8_t)(type & 0xFF), 0x00, 0x01 };
+			packet.append((char*)footer, sizeof(footer));
+			return packet.size() <= 512;
+		}
+		static bool skip_dns_name(const uint8_t* data, size_t size, size_t& offset)
+		{
+			while (offset < size)
 			{
-				for (auto& fd : sockets6)
+				uint8_t length = data[offset];
+				if (!length)
 				{
-					if (fd.revents & POLLOUT)
-					{
-						auto it = hosts.find(fd.fd);
-						if (it != hosts.end())
-							return it->second;
-					}
+					++offset;
+					return true;
 				}
-			}
+				else if ((length & 0xC0) == 0xC0)
+				{
+					offset += 2;
+					return offset <= size;
+				}
+				else if (length & 0xC0)
+					return false;
 
-			return nullptr;
+				offset += 1 + (size_t)length;
+			}
+			return false;
 		}
 #ifdef VI_OPENSSL
 		static std::pair<core::string, time_t> asn1_get_time(ASN1_TIME* time)
@@ -464,6 +719,339 @@ namespace vitex
 				core::memory::deallocate(data);
 			}
 		};
+#elif defined(NET_URING)
+		struct epoll_queue
+		{
+			core::unordered_map<uint64_t, socket*> polls;
+			core::unordered_map<socket*, uint64_t> sockets;
+			std::atomic<std::thread::id> owner = std::thread::id();
+			std::mutex exclusive;
+			__kernel_timespec timeout;
+			epoll_event* events = nullptr;
+			io_uring_sqe* sqes = nullptr;
+			io_uring_cqe* cqes = nullptr;
+			uint8_t* sq_ring = nullptr;
+			uint8_t* cq_ring = nullptr;
+			uint32_t* sq_head = nullptr;
+			uint32_t* sq_tail = nullptr;
+			uint32_t* sq_mask = nullptr;
+			uint32_t* sq_array = nullptr;
+			uint32_t* cq_head = nullptr;
+			uint32_t* cq_tail = nullptr;
+			uint32_t* cq_mask = nullptr;
+			size_t sq_ring_size = 0;
+			size_t cq_ring_size = 0;
+			size_t sqes_size = 0;
+			uint64_t sequence = 0;
+			uint32_t features = 0;
+			uint32_t entries = 0;
+			uint32_t pending = 0;
+			size_t ready = 0;
+			size_t size;
+			int fallback = -1;
+			int handle = -1;
+			bool closable = false;
+
+			epoll_queue(size_t new_size) : size(new_size)
+			{
+				uint32_t depth = 64;
+				while (depth < new_size * 2 && depth < 4096)
+					depth <<= 1;
+
+				io_uring_params params;
+				memset(&params, 0, sizeof(params));
+				memset(&timeout, 0, sizeof(timeout));
+				handle = (int)syscall(__NR_io_uring_setup, depth, &params);
+				if (handle < 0)
+				{
+					degrade();
+					return;
+				}
+
+				features = params.features;
+				entries = params.sq_entries;
+				sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+				cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+				sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+				if (features & IORING_FEAT_SINGLE_MMAP)
+					sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+
+				void* sq_address = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, handle, IORING_OFF_SQ_RING);
+				void* cq_address = features & IORING_FEAT_SINGLE_MMAP ? sq_address : mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, handle, IORING_OFF_CQ_RING);
+				void* sqes_address = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, handle, IORING_OFF_SQES);
+				if (sq_address == MAP_FAILED || cq_address == MAP_FAILED || sqes_address == MAP_FAILED)
+				{
+					if (sq_address != MAP_FAILED)
+						munmap(sq_address, sq_ring_size);
+					if (cq_address != MAP_FAILED && cq_address != sq_address)
+						munmap(cq_address, cq_ring_size);
+					if (sqes_address != MAP_FAILED)
+						munmap(sqes_address, sqes_size);
+					::close(handle);
+					handle = -1;
+					degrade();
+					return;
+				}
+
+				sq_ring = (uint8_t*)sq_address;
+				cq_ring = (uint8_t*)cq_address;
+				sqes = (io_uring_sqe*)sqes_address;
+				sq_head = (uint32_t*)(sq_ring + params.sq_off.head);
+				sq_tail = (uint32_t*)(sq_ring + params.sq_off.tail);
+				sq_mask = (uint32_t*)(sq_ring + params.sq_off.ring_mask);
+				sq_array = (uint32_t*)(sq_ring + params.sq_off.array);
+				cq_head = (uint32_t*)(cq_ring + params.cq_off.head);
+				cq_tail = (uint32_t*)(cq_ring + params.cq_off.tail);
+				cq_mask = (uint32_t*)(cq_ring + params.cq_off.ring_mask);
+				cqes = (io_uring_cqe*)(cq_ring + params.cq_off.cqes);
+
+				core::vector<uint8_t> buffer(sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op), 0);
+				io_uring_probe* probe = (io_uring_probe*)buffer.data();
+				if (syscall(__NR_io_uring_register, handle, IORING_REGISTER_PROBE, probe, 256) == 0)
+					closable = probe->last_op >= IORING_OP_CLOSE && (probe->ops[IORING_OP_CLOSE].flags & IO_URING_OP_SUPPORTED);
+			}
+			~epoll_queue()
+			{
+				core::memory::deallocate(events);
+				if (handle >= 0)
+					submit(0, 0);
+				if (sqes != nullptr)
+					munmap(sqes, sqes_size);
+				if (cq_ring != nullptr && cq_ring != sq_ring)
+					munmap(cq_ring, cq_ring_size);
+				if (sq_ring != nullptr)
+					munmap(sq_ring, sq_ring_size);
+			}
+			bool upsert(socket* target, socket_t fd, bool readable, bool writeable)
+			{
+				if (handle < 0)
+					return epoll_upsert(target, fd, readable, writeable);
+
+				core::umutex<std::mutex> unique(exclusive);
+				cancel(target);
+				if (!readable && !writeable)
+					return defer();
+
+				uint32_t events = POLLRDHUP;
+				if (readable)
+					events |= POLLIN;
+				if (writeable)
+					events |= POLLOUT;
+
+				uint64_t id = ++sequence;
+				io_uring_sqe* sqe = prepare();
+				if (!sqe)
+					return false;
+
+				sqe->opcode = IORING_OP_POLL_ADD;
+				sqe->fd = (int)fd;
+				sqe->poll32_events = events;
+				sqe->user_data = id << 1;
+				publish();
+				polls[id] = target;
+				sockets[target] = id;
+				return defer();
+			}
+			bool close(socket_t fd)
+			{
+				if (handle < 0 || !closable)
+					return false;
+
+				core::umutex<std::mutex> unique(exclusive);
+				io_uring_sqe* sqe = prepare();
+				if (!sqe)
+					return false;
+
+				sqe->opcode = IORING_OP_CLOSE;
+				sqe->fd = (int)fd;
+				sqe->user_data = 1;
+				publish();
+				defer();
+				return true;
+			}
+			bool flush()
+			{
+				if (handle < 0)
+					return true;
+
+				core::umutex<std::mutex> unique(exclusive);
+				owner = std::thread::id();
+				return submit(0, 0) >= 0;
+			}
+			int enter(uint64_t timeout_ms)
+			{
+				if (handle < 0)
+				{
+					int count = epoll_wait(fallback, events, (int)size, (int)timeout_ms);
+					ready = count > 0 ? (size_t)count : 0;
+					return count;
+				}
+
+				core::umutex<std::mutex> unique(exclusive);
+				owner = std::this_thread::get_id();
+				if (__atomic_load_n(cq_tail, __ATOMIC_ACQUIRE) != *cq_head)
+					return submit(0, IORING_ENTER_GETEVENTS);
+
+				timeout.tv_sec = (int64_t)(timeout_ms / 1000);
+				timeout.tv_nsec = (int64_t)((timeout_ms % 1000) * 1000000);
+				if (features & IORING_FEAT_EXT_ARG)
+				{
+					io_uring_getevents_arg args;
+					memset(&args, 0, sizeof(args));
+					args.ts = (uint64_t)(uintptr_t)&timeout;
+
+					uint32_t count = pending;
+					pending = 0;
+					unique.negate();
+					return (int)syscall(__NR_io_uring_enter, handle, count, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &args, sizeof(args));
+				}
+
+				io_uring_sqe* sqe = prepare();
+				if (sqe != nullptr)
+				{
+					sqe->opcode = IORING_OP_TIMEOUT;
+					sqe->fd = -1;
+					sqe->addr = (uint64_t)(uintptr_t)&timeout;
+					sqe->len = 1;
+					sqe->off = 1;
+					sqe->user_data = 0;
+					publish();
+				}
+
+				uint32_t count = pending;
+				pending = 0;
+				unique.negate();
+				return (int)syscall(__NR_io_uring_enter, handle, count, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+			}
+			size_t reap(epoll_fd* data, size_t data_size)
+			{
+				if (handle < 0)
+					return epoll_reap(data, data_size);
+
+				core::umutex<std::mutex> unique(exclusive);
+				uint32_t head = *cq_head;
+				uint32_t tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+				size_t incoming = 0;
+				while (head != tail && incoming < data_size)
+				{
+					io_uring_cqe* cqe = &cqes[head++ & *cq_mask];
+					if (!cqe->user_data || cqe->user_data & 1)
+						continue;
+
+					auto it = polls.find(cqe->user_data >> 1);
+					if (it == polls.end())
+						continue;
+
+					socket* target = it->second;
+					auto current = sockets.find(target);
+					if (current != sockets.end() && current->second == it->first)
+						sockets.erase(current);
+					polls.erase(it);
+
+					auto& fd = data[incoming++];
+					uint32_t events = cqe->res < 0 ? POLLERR : (uint32_t)cqe->res;
+					fd.base = target;
+					fd.readable = (events & POLLIN);
+					fd.writeable = (events & POLLOUT);
+					fd.closeable = (events & POLLHUP || events & POLLRDHUP || events & POLLNVAL || events & POLLERR);
+				}
+				__atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+				return incoming;
+			}
+
+		private:
+			void degrade()
+			{
+				VI_WARN("[net] io_uring is unavailable (%i), falling back to epoll", errno);
+				events = core::memory::allocate<epoll_event>(sizeof(epoll_event) * size);
+				fallback = epoll_create1(EPOLL_CLOEXEC);
+			}
+			bool epoll_upsert(socket* target, socket_t fd, bool readable, bool writeable)
+			{
+				epoll_event event;
+				event.data.ptr = (void*)target;
+				event.events = EPOLLRDHUP;
+				if (!readable && !writeable)
+					return epoll_ctl(fallback, EPOLL_CTL_DEL, (int)fd, &event) == 0 || errno == ENOENT;
+
+				if (readable)
+					event.events |= EPOLLIN;
+				if (writeable)
+					event.events |= EPOLLOUT;
+				if (epoll_ctl(fallback, EPOLL_CTL_MOD, (int)fd, &event) == 0)
+					return true;
+
+				return errno == ENOENT && epoll_ctl(fallback, EPOLL_CTL_ADD, (int)fd, &event) == 0;
+			}
+			size_t epoll_reap(epoll_fd* data, size_t data_size)
+			{
+				size_t incoming = 0;
+				for (auto it = events; it != events + std::min(ready, data_size); it++)
+				{
+					auto& fd = data[incoming++];
+					fd.base = (socket*)it->data.ptr;
+					fd.readable = (it->events & EPOLLIN);
+					fd.writeable = (it->events & EPOLLOUT);
+					fd.closeable = (it->events & EPOLLHUP || it->events & EPOLLRDHUP || it->events & EPOLLERR);
+				}
+				ready = 0;
+				return incoming;
+			}
+			void cancel(socket* target)
+			{
+				auto it = sockets.find(target);
+				if (it == sockets.end())
+					return;
+
+				uint64_t id = it->second;
+				polls.erase(id);
+				sockets.erase(it);
+
+				io_uring_sqe* sqe = prepare();
+				if (!sqe)
+					return;
+
+				sqe->opcode = IORING_OP_POLL_REMOVE;
+				sqe->fd = -1;
+				sqe->addr = id << 1;
+				sqe->user_data = (id << 1) | 1;
+				publish();
+			}
+			bool defer()
+			{
+				return owner == std::this_thread::get_id() || submit(0, 0) >= 0;
+			}
+			io_uring_sqe* prepare()
+			{
+				uint32_t tail = *sq_tail;
+				if (tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE) >= entries)
+				{
+					submit(0, 0);
+					if (tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE) >= entries)
+						return nullptr;
+				}
+
+				io_uring_sqe* sqe = &sqes[tail & *sq_mask];
+				memset(sqe, 0, sizeof(io_uring_sqe));
+				return sqe;
+			}
+			void publish()
+			{
+				uint32_t tail = *sq_tail;
+				sq_array[tail & *sq_mask] = tail & *sq_mask;
+				__atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+				++pending;
+			}
+			int submit(uint32_t min_complete, uint32_t flags)
+			{
+				if (!pending && !flags)
+					return 0;
+
+				uint32_t count = pending;
+				pending = 0;
+				return (int)syscall(__NR_io_uring_enter, handle, count, min_complete, flags, nullptr, 0);
+			}
+		};
 #endif
 		location::location(const std::string_view& from) noexcept : body(from), port(0)
 		{
@@ -931,6 +1519,8 @@ namespace vitex
 			handle = kqueue();
 #elif defined(NET_EPOLL)
 			handle = epoll_create(1);
+#elif defined(NET_URING)
+			handle = queue->handle >= 0 ? queue->handle : queue->fallback;
 #endif
 		}
 		epoll_interface::epoll_interface(epoll_interface&& other) noexcept : queue(other.queue), handle(other.handle)
@@ -994,6 +1584,9 @@ namespace vitex
 			if (writeable)
 				event.events |= EPOLLOUT;
 			return epoll_ctl(handle, EPOLL_CTL_ADD, fd->fd, &event) == 0;
+#elif defined(NET_URING)
+			VI_ASSERT(queue != nullptr, "epoll should be initialized");
+			return queue->upsert(fd, fd->fd, readable, writeable);
 #endif
 		}
 		bool epoll_interface::update(socket* fd, bool readable, bool writeable) noexcept
@@ -1027,6 +1620,9 @@ namespace vitex
 			if (writeable)
 				event.events |= EPOLLOUT;
 			return epoll_ctl(handle, EPOLL_CTL_MOD, fd->fd, &event) == 0;
+#elif defined(NET_URING)
+			VI_ASSERT(queue != nullptr, "epoll should be initialized");
+			return queue->upsert(fd, fd->fd, readable, writeable);
 #endif
 		}
 		bool epoll_interface::remove(socket* fd) noexcept
@@ -1055,11 +1651,45 @@ namespace vitex
 			event.events = EPOLLIN | EPOLLOUT;
 #endif
 			return epoll_ctl(handle, EPOLL_CTL_DEL, fd->fd, &event) == 0;
+#elif defined(NET_URING)
+			VI_ASSERT(queue != nullptr, "epoll should be initialized");
+			return queue->upsert(fd, fd->fd, false, false);
 #endif
 		}
-		int epoll_interface::wait(epoll_fd* data, size_t data_size, uint64_t timeout) noexcept
+		bool epoll_interface::watch(socket* fd) noexcept
 		{
-			VI_ASSERT(capacity() >= data_size, "epollfd array should be less than or equal to internal events buffer");
+			VI_ASSERT(handle != INVALID_EPOLL, "epoll should be initialized");
+			VI_ASSERT(fd != nullptr && fd->fd != INVALID_SOCKET, "socket should be set and valid");
+#if defined(NET_EPOLL) && defined(EPOLLET) && !defined(VI_MICROSOFT)
+			VI_TRACE("[net] epoll watch fd %i", (int)fd->fd);
+			epoll_event event;
+			event.data.ptr = (void*)fd;
+#ifdef EPOLLRDHUP
+			event.events = EPOLLRDHUP | EPOLLIN | EPOLLOUT | EPOLLET;
+#else
+			event.events = EPOLLIN | EPOLLOUT | EPOLLET;
+#endif
+			if (epoll_ctl(handle, EPOLL_CTL_ADD, fd->fd, &event) == 0)
+				return true;
+
+			return errno == EEXIST && epoll_ctl(handle, EPOLL_CTL_MOD, fd->fd, &event) == 0;
+#else
+			return false;
+#endif
+		}
+		bool epoll_interface::close(socket_t fd) noexcept
+		{
+#ifdef NET_URING
+			VI_ASSERT(queue != nullptr, "epoll should be initialized");
+			VI_TRACE("[net] io_uring close fd %i", (int)fd);
+			return queue->close(fd);
+#else
+			return false;
+#endif
+		}
+		int epoll_interface::wait(epoll_fd* data, size_t data_size, uint64_t timeout) noexcept
+		{
+			VI_ASSERT(capacity() >= data_size, "epollfd array should be less than or equal to internal events buffer");
 #ifdef NET_POLL
 			auto& events = queue->compile();
 			if (events.empty())
@@ -1128,9 +1758,26 @@ namespace vitex
 #endif
 			}
 			VI_TRACE("[net] epoll recv %i events", (int)incoming);
+#elif defined(NET_URING)
+			VI_TRACE("[net] io_uring wait %i fds (%" PRIu64 " ms)", (int)data_size, timeout);
+			int count = queue->enter(timeout);
+			if (count < 0 && errno != ETIME && errno != EINTR)
+				return count;
+
+			size_t incoming = queue->reap(data, data_size);
+			VI_TRACE("[net] io_uring recv %i events", (int)incoming);
 #endif
 			return (int)incoming;
 		}
+		bool epoll_interface::flush() noexcept
+		{
+#ifdef NET_URING
+			VI_ASSERT(queue != nullptr, "epoll should be initialized");
+			return queue->flush();
+#else
+			return true;
+#endif
+		}
 		size_t epoll_interface::capacity() noexcept
 		{
 #ifdef NET_POLL
@@ -1302,7 +1949,7 @@ namespace vitex
 #if defined(VI_MICROSOFT)
 			int count = WSAPoll(fd, fd_count, timeout);
 #else
-			int count = poll(fd, fd_count, timeout);
+			int count = ::poll(fd, fd_count, timeout);
 #endif
 			if (count > 0)
 				VI_TRACE("[net] poll recv %i events", count);
@@ -1512,6 +2159,33 @@ namespace vitex
 				return result;
 			}
 		}
+		core::expects_io<void> utils::create_socket_pair(socket_t pair[2]) noexcept
+		{
+#ifdef VI_MICROSOFT
+			return std::make_error_condition(std::errc::not_supported);
+#else
+#ifdef SOCK_NONBLOCK
+			if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, pair) == 0)
+				return core::expectation::met;
+#endif
+			if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0)
+				return core::os::error::get_condition_or();
+
+			for (size_t i = 0; i < 2; i++)
+			{
+				auto status = set_socket_blocking(pair[i], false);
+				if (!status)
+				{
+					closesocket(pair[0]);
+					closesocket(pair[1]);
+					return status;
+				}
+				fcntl(pair[i], F_SETFD, FD_CLOEXEC);
+			}
+
+			return core::expectation::met;
+#endif
+		}
 		bool utils::is_invalid(socket_t fd) noexcept
 		{
 			return fd == INVALID_SOCKET;
@@ -1525,6 +2199,270 @@ namespace vitex
 			compute::crypto::display_crypto_log();
 		}
 
+#ifdef VI_OPENSSL
+		struct tls_session_cache
+		{
+			struct entry
+			{
+				core::string data;
+				core::linked_list<core::string>::iterator order;
+				int64_t expires = 0;
+			};
+
+			struct shard
+			{
+				std::mutex update;
+				core::unordered_map<core::string, entry> sessions;
+				core::linked_list<core::string> order;
+			};
+
+			shard shards[TLS_SESSION_SHARDS];
+			std::atomic<size_t> capacity = 0;
+			std::atomic<size_t> size = 0;
+			std::atomic<uint64_t> handshakes = 0;
+			std::atomic<uint64_t> resumptions = 0;
+			std::atomic<uint64_t> hits = 0;
+			std::atomic<uint64_t> misses = 0;
+			std::atomic<uint64_t> evictions = 0;
+			std::atomic<uint64_t> rotations = 0;
+
+			void reserve(size_t new_capacity)
+			{
+				size_t current = capacity.load();
+				while (current < new_capacity && !capacity.compare_exchange_weak(current, new_capacity));
+			}
+			void store(SSL_SESSION* session)
+			{
+				uint32_t id_length = 0;
+				const uint8_t* id = SSL_SESSION_get_id(session, &id_length);
+				int length = i2d_SSL_SESSION(session, nullptr);
+				if (!id_length || length <= 0)
+					return;
+
+				core::string data((size_t)length, '\0');
+				uint8_t* buffer = (uint8_t*)data.data();
+				if (i2d_SSL_SESSION(session, &buffer) != length)
+					return;
+
+				core::string key((const char*)id, (size_t)id_length);
+				size_t limit = std::max<size_t>(1, capacity.load() / TLS_SESSION_SHARDS);
+				auto& target = get_shard(key);
+				core::umutex<std::mutex> unique(target.update);
+				auto it = target.sessions.find(key);
+				if (it != target.sessions.end())
+				{
+					target.order.erase(it->second.order);
+					target.sessions.erase(it);
+					--size;
+				}
+
+				while (target.sessions.size() >= limit && !target.order.empty())
+				{
+					target.sessions.erase(target.order.front());
+					target.order.pop_front();
+					++evictions;
+					--size;
+				}
+
+				auto& next = target.sessions[key];
+				next.data = std::move(data);
+				next.expires = (int64_t)time(nullptr) + (int64_t)SSL_SESSION_get_timeout(session);
+				next.order = target.order.insert(target.order.end(), std::move(key));
+				++size;
+			}
+			void remove(const uint8_t* id, size_t id_length)
+			{
+				core::string key((const char*)id, id_length);
+				auto& target = get_shard(key);
+				core::umutex<std::mutex> unique(target.update);
+				auto it = target.sessions.find(key);
+				if (it == target.sessions.end())
+					return;
+
+				target.order.erase(it->second.order);
+				target.sessions.erase(it);
+				--size;
+			}
+			SSL_SESSION* fetch(const uint8_t* id, size_t id_length)
+			{
+				core::string key((const char*)id, id_length);
+				auto& target = get_shard(key);
+				core::umutex<std::mutex> unique(target.update);
+				auto it = target.sessions.find(key);
+				if (it == target.sessions.end())
+				{
+					++misses;
+					return nullptr;
+				}
+				else if (it->second.expires < (int64_t)time(nullptr))
+				{
+					target.order.erase(it->second.order);
+					target.sessions.erase(it);
+					++misses;
+					--size;
+					return nullptr;
+				}
+
+				const uint8_t* buffer = (const uint8_t*)it->second.data.data();
+				SSL_SESSION* session = d2i_SSL_SESSION(nullptr, &buffer, (long)it->second.data.size());
+				if (session != nullptr)
+					++hits;
+				else
+					++misses;
+				return session;
+			}
+			shard& get_shard(const core::string& key)
+			{
+				return shards[std::hash<std::string_view>()(std::string_view(key)) % TLS_SESSION_SHARDS];
+			}
+			static tls_session_cache* get()
+			{
+				static tls_session_cache* base = new tls_session_cache();
+				return base;
+			}
+		};
+
+		struct tls_ticket_keys
+		{
+			struct key
+			{
+				uint8_t name[TLS_TICKET_NAME];
+				uint8_t cipher[TLS_TICKET_KEY];
+				uint8_t hmac[TLS_TICKET_KEY];
+			};
+
+			std::mutex update;
+			key current;
+			key previous;
+			int64_t rotated = 0;
+			uint64_t rotation = 0;
+			bool has_previous = false;
+
+			bool rotate(int64_t time)
+			{
+				key next;
+				if (RAND_bytes(next.name, sizeof(next.name)) != 1 || RAND_bytes(next.cipher, sizeof(next.cipher)) != 1 || RAND_bytes(next.hmac, sizeof(next.hmac)) != 1)
+					return false;
+
+				if (rotated > 0)
+				{
+					previous = current;
+					has_previous = true;
+					++tls_session_cache::get()->rotations;
+				}
+
+				current = next;
+				rotated = time;
+				return true;
+			}
+			bool rotate_if_expired(int64_t time)
+			{
+				if (rotation > 0 && rotated + (int64_t)rotation <= time)
+					return rotate(time);
+
+				return true;
+			}
+			key* find(const uint8_t* name, int& status)
+			{
+				if (!memcmp(current.name, name, sizeof(current.name)))
+				{
+					status = 1;
+					return &current;
+				}
+				else if (has_previous && !memcmp(previous.name, name, sizeof(previous.name)))
+				{
+					status = 2;
+					return &previous;
+				}
+
+				status = 0;
+				return nullptr;
+			}
+			static int get_index()
+			{
+				static int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, [](void*, void* data, CRYPTO_EX_DATA*, int, long, void*)
+				{
+					core::memory::deinit((tls_ticket_keys*)data);
+				});
+				return index;
+			}
+		};
+
+		static int tls_session_new(SSL* device, SSL_SESSION* session)
+		{
+			tls_session_cache::get()->store(session);
+			return 0;
+		}
+		static void tls_session_remove(SSL_CTX* context, SSL_SESSION* session)
+		{
+			uint32_t id_length = 0;
+			const uint8_t* id = SSL_SESSION_get_id(session, &id_length);
+			if (id_length > 0)
+				tls_session_cache::get()->remove(id, (size_t)id_length);
+		}
+		static SSL_SESSION* tls_session_get(SSL* device, const uint8_t* id, int id_length, int* copy)
+		{
+			*copy = 0;
+			return id_length > 0 ? tls_session_cache::get()->fetch(id, (size_t)id_length) : nullptr;
+		}
+		static int tls_select_protocol(SSL* device, const uint8_t** out, uint8_t* out_size, const uint8_t* in, uint32_t in_size, void* router)
+		{
+			for (auto& protocol : ((socket_router*)router)->protocols)
+			{
+				for (uint32_t offset = 0; offset < in_size; offset += in[offset] + 1)
+				{
+					uint32_t size = in[offset];
+					if (offset + size + 1 > in_size)
+						break;
+
+					if (size == protocol.size() && !memcmp(in + offset + 1, protocol.data(), size))
+					{
+						*out = in + offset + 1;
+						*out_size = (uint8_t)size;
+						return SSL_TLSEXT_ERR_OK;
+					}
+				}
+			}
+
+			return SSL_TLSEXT_ERR_NOACK;
+		}
+#if OPENSSL_VERSION_MAJOR >= 3
+		static int tls_ticket_key(SSL* device, uint8_t* name, uint8_t* iv, EVP_CIPHER_CTX* cipher, EVP_MAC_CTX* hmac, int encrypt)
+		{
+			auto* keys = (tls_ticket_keys*)SSL_CTX_get_ex_data(SSL_get_SSL_CTX(device), tls_ticket_keys::get_index());
+			if (!keys)
+				return 0;
+
+			core::umutex<std::mutex> unique(keys->update);
+			if (!keys->rotate_if_expired((int64_t)time(nullptr)))
+				return -1;
+
+			int status = 1;
+			tls_ticket_keys::key* target = nullptr;
+			if (encrypt)
+			{
+				target = &keys->current;
+				memcpy(name, target->name, sizeof(target->name));
+				if (RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc())) != 1)
+					return -1;
+			}
+			else if (!(target = keys->find(name, status)))
+				return 0;
+
+			OSSL_PARAM params[3];
+			params[0] = OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, target->hmac, sizeof(target->hmac));
+			params[1] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, (char*)"SHA256", 0);
+			params[2] = OSSL_PARAM_construct_end();
+			if (!EVP_MAC_CTX_set_params(hmac, params))
+				return -1;
+
+			if (encrypt)
+				return EVP_EncryptInit_ex(cipher, EVP_aes_256_cbc(), nullptr, target->cipher, iv) == 1 ? status : -1;
+
+			return EVP_DecryptInit_ex(cipher, EVP_aes_256_cbc(), nullptr, target->cipher, iv) == 1 ? status : -1;
+		}
+#endif
+#endif
 		transport_layer::transport_layer() noexcept : is_installed(false)
 		{
 		}
@@ -1589,6 +2527,12 @@ namespace vitex
 #ifdef SSL_OP_NO_TLSv1_2
 			if ((size_t)options & (size_t)secure_layer_options::no_tlsv13)
 				flags |= SSL_OP_NO_TLSv1_3;
+#endif
+#ifdef SSL_OP_ENABLE_KTLS
+			if ((size_t)options & (size_t)secure_layer_options::ktls)
+				flags |= SSL_OP_ENABLE_KTLS;
+			else
+				SSL_CTX_clear_options(context, SSL_OP_ENABLE_KTLS);
 #endif
 			SSL_CTX_set_options(context, flags);
 			SSL_CTX_set_verify_depth(context, (int)verify_depth);
@@ -1643,6 +2587,92 @@ namespace vitex
 			return std::make_error_condition(std::errc::not_supported);
 #endif
 		}
+		core::expects_io<void> transport_layer::configure_server_sessions(ssl_ctx_st* context, size_t cache_size, uint64_t timeout, uint64_t ticket_rotation) noexcept
+		{
+#ifdef VI_OPENSSL
+			VI_ASSERT(context != nullptr, "context should be set");
+			SSL_CTX_set_timeout(context, (long)timeout);
+			if (cache_size > 0)
+			{
+				tls_session_cache::get()->reserve(cache_size);
+				SSL_CTX_set_session_cache_mode(context, SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL);
+				SSL_CTX_sess_set_new_cb(context, &tls_session_new);
+				SSL_CTX_sess_set_remove_cb(context, &tls_session_remove);
+				SSL_CTX_sess_set_get_cb(context, &tls_session_get);
+			}
+			else
+			{
+				SSL_CTX_set_session_cache_mode(context, SSL_SESS_CACHE_OFF);
+				SSL_CTX_sess_set_new_cb(context, nullptr);
+				SSL_CTX_sess_set_remove_cb(context, nullptr);
+				SSL_CTX_sess_set_get_cb(context, nullptr);
+			}
+
+			if (!ticket_rotation)
+			{
+				SSL_CTX_set_options(context, SSL_OP_NO_TICKET);
+				VI_DEBUG("[net] OK configure server 0x%" PRIuPTR " TLS context sessions (cache: %" PRIu64 ", tickets: off)", context, (uint64_t)cache_size);
+				return core::expectation::met;
+			}
+
+			SSL_CTX_clear_options(context, SSL_OP_NO_TICKET);
+#if OPENSSL_VERSION_MAJOR >= 3
+			auto* keys = (tls_ticket_keys*)SSL_CTX_get_ex_data(context, tls_ticket_keys::get_index());
+			if (!keys)
+			{
+				keys = core::memory::init<tls_ticket_keys>();
+				if (!SSL_CTX_set_ex_data(context, tls_ticket_keys::get_index(), keys))
+				{
+					core::memory::deinit(keys);
+					utils::display_transport_log();
+					return std::make_error_condition(std::errc::not_enough_memory);
+				}
+			}
+
+			core::umutex<std::mutex> unique(keys->update);
+			keys->rotation = ticket_rotation;
+			if (!keys->rotated && !keys->rotate((int64_t)time(nullptr)))
+			{
+				utils::display_transport_log();
+				return std::make_error_condition(std::errc::operation_canceled);
+			}
+
+			if (SSL_CTX_set_tlsext_ticket_key_evp_cb(context, &tls_ticket_key) != 1)
+			{
+				utils::display_transport_log();
+				return std::make_error_condition(std::errc::protocol_not_supported);
+			}
+#endif
+			VI_DEBUG("[net] OK configure server 0x%" PRIuPTR " TLS context sessions (cache: %" PRIu64 ", tickets: %" PRIu64 "s)", context, (uint64_t)cache_size, ticket_rotation);
+			return core::expectation::met;
+#else
+			return std::make_error_condition(std::errc::not_supported);
+#endif
+		}
+		void transport_layer::report_handshake(ssl_st* device) noexcept
+		{
+#ifdef VI_OPENSSL
+			if (device != nullptr && SSL_session_reused(device))
+				++tls_session_cache::get()->resumptions;
+			else
+				++tls_session_cache::get()->handshakes;
+#endif
+		}
+		transport_statistics transport_layer::get_statistics() noexcept
+		{
+			transport_statistics result;
+#ifdef VI_OPENSSL
+			auto* cache = tls_session_cache::get();
+			result.handshakes = cache->handshakes.load();
+			result.resumptions = cache->resumptions.load();
+			result.cache_hits = cache->hits.load();
+			result.cache_misses = cache->misses.load();
+			result.cache_evictions = cache->evictions.load();
+			result.ticket_rotations = cache->rotations.load();
+			result.cached_sessions = cache->size.load();
+#endif
+			return result;
+		}
 		void transport_layer::free_server_context(ssl_ctx_st* context) noexcept
 		{
 			if (!context)
@@ -1727,161 +2757,469 @@ namespace vitex
 #endif
 		}
 
-		dns::dns() noexcept
-		{
-			VI_TRACE("[dns] OK initialize cache");
-		}
-		dns::~dns() noexcept
-		{
-			VI_TRACE("[dns] cleanup cache");
-			names.clear();
-		}
-		core::expects_system<core::string> dns::reverse_lookup(const std::string_view& hostname, const std::string_view& service)
+		struct dns_response
 		{
-			VI_ASSERT(hostname.empty() || core::stringify::is_cstring(hostname), "host should be set");
-			VI_ASSERT(service.empty() || core::stringify::is_cstring(service), "service should be set");
-			VI_MEASURE((uint64_t)core::timings::networking * 3);
+			core::vector<socket_address> addresses;
+			int64_t ttl = 0;
+			bool negative = false;
+			bool failed = false;
+		};
 
-			struct addrinfo hints;
-			memset(&hints, 0, sizeof(hints));
-			hints.ai_family = AF_UNSPEC;
+		class dns_query final : public core::reference<dns_query>
+		{
+		public:
+			typedef std::function<void(dns_response&&)> response_callback;
 
-			if (has_ip_v4_address(hostname) || has_ip_v6_address(hostname))
-				hints.ai_flags |= AI_NUMERICHOST;
-			if (core::stringify::has_integer(service))
-				hints.ai_flags |= AI_NUMERICSERV;
+		private:
+			core::vector<socket_address> servers;
+			core::vector<socket_address> addresses4;
+			core::vector<socket_address> addresses6;
+			core::string hostname;
+			response_callback callback;
+			addrinfo hints;
+			socket* stream = nullptr;
+			int64_t ttl = -1;
+			int64_t negative_ttl = -1;
+			size_t attempt = 0;
+			uint16_t port = 0;
+			uint16_t identity = 0;
+			uint8_t answered = 0;
+			bool nonexistent = false;
 
-			struct addrinfo* address = nullptr;
-			if (getaddrinfo(hostname.empty() ? nullptr : hostname.data(), service.empty() ? nullptr : service.data(), &hints, &address) != 0)
-				return core::system_exception(core::stringify::text("dns resolve %s:%s address: invalid address", hostname.data(), service.data()));
+		public:
+			dns_query(core::vector<socket_address>&& new_servers, const std::string_view& new_hostname, uint16_t new_port, const addrinfo& new_hints, response_callback&& new_callback) noexcept : servers(std::move(new_servers)), hostname(new_hostname), callback(std::move(new_callback)), hints(new_hints), port(new_port)
+			{
+			}
+			~dns_query() noexcept
+			{
+				close();
+			}
+			void start()
+			{
+				multiplexer::get()->activate();
+				send();
+			}
 
-			socket_address target = socket_address(hostname, core::from_string<uint16_t>(service).otherwise(0), address);
-			freeaddrinfo(address);
-			return reverse_address_lookup(target);
-		}
-		core::expects_promise_system<core::string> dns::reverse_lookup_deferred(const std::string_view& source_hostname, const std::string_view& source_service)
-		{
-			core::string hostname = core::string(source_hostname), service = core::string(source_service);
-			return core::cotask<core::expects_system<core::string>>([this, hostname = std::move(hostname), service = std::move(service)]() mutable
+		private:
+			void send()
 			{
-				return reverse_lookup(hostname, service);
-			});
-		}
-		core::expects_system<core::string> dns::reverse_address_lookup(const socket_address& address)
-		{
-			VI_MEASURE((uint64_t)core::timings::networking * 3);
-			char reverse_hostname[NI_MAXHOST], reverse_service[NI_MAXSERV];
-			if (getnameinfo(address.get_raw_address(), (socklen_t)address.get_address_size(), reverse_hostname, NI_MAXHOST, reverse_service, NI_MAXSERV, NI_NUMERICSERV) != 0)
-				return core::system_exception(core::stringify::text("dns reverse resolve %s address: invalid address", get_address_identification(address).c_str()));
+				while (attempt < servers.size() * DNS_QUERY_ATTEMPTS)
+				{
+					auto& server = servers[attempt++ % servers.size()];
+					auto status = open(server);
+					if (status)
+						return;
 
-			VI_DEBUG("[net] dns reverse resolved for entity %s (host %s:%s is used)", get_address_identification(address).c_str(), reverse_hostname, reverse_service);
-			return core::string(reverse_hostname, strnlen(reverse_hostname, sizeof(reverse_hostname)));
-		}
-		core::expects_promise_system<core::string> dns::reverse_address_lookup_deferred(const socket_address& address)
-		{
-			return core::cotask<core::expects_system<core::string>>([this, address]() mutable
+					VI_DEBUG("[dns] query %s on %s failed: %s", hostname.c_str(), get_address_identification(server).c_str(), status.error().message().c_str());
+					if (status.error() == std::errc::invalid_argument)
+						break;
+				}
+				finish(true);
+			}
+			void receive(socket_poll event)
 			{
-				return reverse_address_lookup(address);
-			});
-		}
-		core::expects_system<socket_address> dns::lookup(const std::string_view& hostname, const std::string_view& service, dns_type resolver, socket_protocol proto, socket_type type)
+				if (!packet::is_done(event))
+				{
+					VI_DEBUG("[dns] query %s timed out", hostname.c_str());
+					return send();
+				}
+
+				uint8_t buffer[DNS_MAX_PACKET];
+				while (true)
+				{
+					auto size = stream->read(buffer, sizeof(buffer));
+					if (!size)
+					{
+						if (size.error() == std::errc::operation_would_block)
+							break;
+
+						return send();
+					}
+					else if (!read_response(buffer, *size))
+						return send();
+				}
+
+				if (nonexistent || answered == 3)
+					return finish(false);
+
+				add_ref();
+				multiplexer::get()->when_readable(stream, [this](socket_poll event)
+				{
+					receive(event);
+					release();
+				});
+			}
+			bool read_response(const uint8_t* data, size_t size)
+			{
+				if (size < 12)
+					return true;
+
+				uint16_t id = (uint16_t)((data[0] << 8) | data[1]);
+				uint8_t index = id == identity ? 1 : (id == (uint16_t)(identity + 1) ? 2 : 0);
+				if (!index || (answered & index) || !(data[2] & 0x80))
+					return true;
+
+				uint8_t code = data[3] & 0x0F;
+				if (code == DNS_RCODE_NXDOMAIN)
+					nonexistent = true;
+				else if (code != 0)
+					return false;
+
+				size_t questions = (size_t)((data[4] << 8) | data[5]);
+				size_t answers = (size_t)((data[6] << 8) | data[7]);
+				size_t authorities = (size_t)((data[8] << 8) | data[9]);
+				size_t offset = 12;
+				for (size_t i = 0; i < questions; i++)
+				{
+					if (!skip_dns_name(data, size, offset) || (offset += 4) > size)
+						return false;
+				}
+
+				for (size_t i = 0; i < answers + authorities; i++)
+				{
+					if (!skip_dns_name(data, size, offset) || offset + 10 > size)
+						return false;
+
+					uint16_t type = (uint16_t)((data[offset + 0] << 8) | data[offset + 1]);
+					uint16_t level = (uint16_t)((data[offset + 2] << 8) | data[offset + 3]);
+					int64_t expires = (int64_t)(((uint32_t)data[offset + 4] << 24) | ((uint32_t)data[offset + 5] << 16) | ((uint32_t)data[offset + 6] << 8) | (uint32_t)data[offset + 7]);
+					size_t length = (size_t)((data[offset + 8] << 8) | data[offset + 9]);
+					const uint8_t* record = data + offset + 10;
+					if ((offset += 10 + length) > size)
+						return false;
+					else if (level != 1)
+						continue;
+
+					if (i >= answers)
+					{
+						if (type == DNS_TYPE_SOA && length >= 4)
+						{
+							int64_t minimum = (int64_t)(((uint32_t)record[length - 4] << 24) | ((uint32_t)record[length - 3] << 16) | ((uint32_t)record[length - 2] << 8) | (uint32_t)record[length - 1]);
+							int64_t next_ttl = std::min(expires, minimum);
+							negative_ttl = negative_ttl < 0 ? next_ttl : std::min(negative_ttl, next_ttl);
+						}
+						continue;
+					}
+					else if (type == DNS_TYPE_A && length == 4)
+						addresses4.push_back(get_lookup_address(hostname, port, AF_INET, record, hints));
+					else if (type == DNS_TYPE_AAAA && length == 16)
+						addresses6.push_back(get_lookup_address(hostname, port, AF_INET6, record, hints));
+					else
+						continue;
+
+					ttl = ttl < 0 ? expires : std::min(ttl, expires);
+				}
+
+				answered |= index;
+				return true;
+			}
+			core::expects_io<void> open(const socket_address& server)
+			{
+				close();
+				auto connectable = execute_socket(server.get_family(), SOCK_DGRAM, IPPROTO_UDP);
+				if (!connectable)
+					return connectable.error();
+
+				stream = new socket(*connectable);
+				stream->set_close_on_exec();
+				stream->set_blocking(false);
+				stream->set_io_timeout(DNS_QUERY_TIMEOUT);
+				auto status = stream->connect(server, DNS_QUERY_TIMEOUT);
+				if (!status)
+					return status;
+
+				core::string packet;
+				identity = (uint16_t)compute::crypto::random();
+				for (uint16_t i = 0; i < 2; i++)
+				{
+					if (!write_dns_query(packet, identity + i, hostname, i > 0 ? DNS_TYPE_AAAA : DNS_TYPE_A))
+						return std::make_error_condition(std::errc::invalid_argument);
+
+					auto written = stream->write((uint8_t*)packet.data(), packet.size());
+					if (!written)
+						return written.error();
+				}
+
+				addresses4.clear();
+				addresses6.clear();
+				ttl = negative_ttl = -1;
+				nonexistent = false;
+				answered = 0;
+				add_ref();
+				multiplexer::get()->when_readable(stream, [this](socket_poll event)
+				{
+					receive(event);
+					release();
+				});
+				return core::expectation::met;
+			}
+			void close()
+			{
+				if (!stream)
+					return;
+
+				stream->shutdown();
+				core::memory::release(stream);
+			}
+			void finish(bool failed)
+			{
+				dns_response response;
+				response.failed = failed;
+				if (!failed)
+				{
+					response.addresses = get_lookup_order(std::move(addresses6), std::move(addresses4));
+					response.negative = response.addresses.empty();
+					response.ttl = response.negative ? (negative_ttl < 0 ? DNS_NEGATIVE_TIMEOUT : negative_ttl) : ttl;
+				}
+
+				close();
+				VI_DEBUG("[dns] query %s resolved %i addresses (ttl: %i)", hostname.c_str(), (int)response.addresses.size(), (int)response.ttl);
+				auto resolve = std::move(callback);
+				multiplexer::get()->deactivate();
+				resolve(std::move(response));
+				release();
+			}
+		};
+
+		class dns_race final : public core::reference<dns_race>
 		{
-			VI_ASSERT(!hostname.empty() && core::stringify::is_cstring(hostname), "host should be set");
-			VI_MEASURE((uint64_t)core::timings::networking * 3);
-			int64_t time = ::time(nullptr);
-			struct addrinfo hints;
-			memset(&hints, 0, sizeof(struct addrinfo));
-			hints.ai_family = AF_UNSPEC;
-			switch (proto)
+		public:
+			typedef std::function<void(core::option<socket_address>&&)> race_callback;
+
+		private:
+			std::mutex update;
+			core::vector<socket_address> candidates;
+			core::vector<socket*> attempts;
+			race_callback callback;
+			core::task_id timer = core::INVALID_TASK_ID;
+			size_t next = 0;
+			size_t pending = 0;
+			bool resolved = false;
+
+		public:
+			dns_race(core::vector<socket_address>&& new_candidates, race_callback&& new_callback) noexcept : candidates(std::move(new_candidates)), callback(std::move(new_callback))
 			{
-				case socket_protocol::IP:
-					hints.ai_protocol = IPPROTO_IP;
-					break;
-				case socket_protocol::ICMP:
-					hints.ai_protocol = IPPROTO_ICMP;
-					break;
-				case socket_protocol::UDP:
-					hints.ai_protocol = IPPROTO_UDP;
-					break;
-				case socket_protocol::RAW:
-					hints.ai_protocol = IPPROTO_RAW;
-					break;
-				case socket_protocol::TCP:
-				default:
-					hints.ai_protocol = IPPROTO_TCP;
-					break;
+				attempts.resize(candidates.size(), nullptr);
 			}
-			switch (type)
+			void start()
 			{
-				case socket_type::datagram:
-					hints.ai_socktype = SOCK_DGRAM;
-					break;
-				case socket_type::raw:
-					hints.ai_socktype = SOCK_RAW;
-					break;
-				case socket_type::reliably_delivered_message:
-					hints.ai_socktype = SOCK_RDM;
-					break;
-				case socket_type::sequence_packet_stream:
-					hints.ai_socktype = SOCK_SEQPACKET;
-					break;
-				case socket_type::stream:
-				default:
-					hints.ai_socktype = SOCK_STREAM;
-					break;
+				multiplexer::get()->activate();
+				if (candidates.empty())
+					return finish(core::optional::none);
+
+				launch();
 			}
-			switch (resolver)
+
+		private:
+			void launch()
 			{
-				case dns_type::connect:
-					hints.ai_flags = AI_CANONNAME;
-					break;
-				case dns_type::listen:
-					hints.ai_flags = AI_CANONNAME | AI_PASSIVE;
-					break;
-				default:
-					break;
+				core::umutex<std::mutex> unique(update);
+				if (resolved || next >= candidates.size())
+					return;
+
+				size_t index = next++;
+				auto& address = candidates[index];
+				clear_timer();
+				++pending;
+
+				auto connectable = execute_socket(address.get_family(), address.get_type(), address.get_protocol());
+				if (!connectable)
+				{
+					unique.negate();
+					return complete(index, connectable.error());
+				}
+
+				auto* stream = attempts[index] = new socket(*connectable);
+				stream->set_close_on_exec();
+				stream->set_blocking(false);
+				stream->set_io_timeout(CONNECT_TIMEOUT);
+				if (next < candidates.size())
+				{
+					add_ref();
+					timer = core::schedule::get()->set_timeout(CONNECT_ATTEMPT_DELAY, [this]()
+					{
+						launch();
+						release();
+					});
+					if (timer == core::INVALID_TASK_ID)
+						release();
+				}
+
+				add_ref();
+				unique.negate();
+				VI_DEBUG("[dns] race connect to %s on fd %i", get_address_identification(address).c_str(), (int)stream->get_fd());
+				stream->connect_queued(address, [this, index, stream](const core::option<std::error_condition>& error)
+				{
+					int status = error ? 1 : 0;
+					if (!status)
+					{
+						socklen_t size = sizeof(status);
+						getsockopt(stream->get_fd(), SOL_SOCKET, SO_ERROR, (char*)&status, &size);
+					}
+
+					if (status != 0)
+						complete(index, error ? *error : std::make_error_condition(std::errc::connection_refused));
+					else
+						complete(index, core::optional::none);
+					release();
+				});
 			}
+			void complete(size_t index, core::option<std::error_condition>&& error)
+			{
+				core::option<socket_address> winner = core::optional::none;
+				core::umutex<std::mutex> unique(update);
+				socket* stream = attempts[index];
+				bool finished = false, retry = false;
+				attempts[index] = nullptr;
+				--pending;
+				if (!resolved)
+				{
+					if (!error)
+					{
+						winner = candidates[index];
+						resolved = finished = true;
+						clear_timer();
+						for (auto* item : attempts)
+						{
+							if (item != nullptr)
+								multiplexer::get()->cancel_events(item);
+						}
+					}
+					else if (next < candidates.size())
+						retry = true;
+					else if (!pending)
+						resolved = finished = true;
+				}
+
+				unique.negate();
+				if (stream != nullptr)
+				{
+					stream->shutdown();
+					core::memory::release(stream);
+				}
+
+				if (retry)
+					launch();
+				else if (finished)
+					finish(std::move(winner));
+			}
+			void finish(core::option<socket_address>&& winner)
+			{
+				auto resolve = std::move(callback);
+				multiplexer::get()->deactivate();
+				resolve(std::move(winner));
+				release();
+			}
+			void clear_timer()
+			{
+				if (timer != core::INVALID_TASK_ID && core::schedule::get()->clear_timeout(timer))
+					release();
+				timer = core::INVALID_TASK_ID;
+			}
+		};
+
+		dns::dns() noexcept
+		{
+			VI_TRACE("[dns] OK initialize cache");
+			load_system_config();
+		}
+		dns::~dns() noexcept
+		{
+			VI_TRACE("[dns] cleanup cache");
+			names.clear();
+		}
+		core::expects_system<core::string> dns::reverse_lookup(const std::string_view& hostname, const std::string_view& service)
+		{
+			VI_ASSERT(hostname.empty() || core::stringify::is_cstring(hostname), "host should be set");
+			VI_ASSERT(service.empty() || core::stringify::is_cstring(service), "service should be set");
+			VI_MEASURE((uint64_t)core::timings::networking * 3);
+
+			struct addrinfo hints;
+			memset(&hints, 0, sizeof(hints));
+			hints.ai_family = AF_UNSPEC;
+
 			if (has_ip_v4_address(hostname) || has_ip_v6_address(hostname))
 				hints.ai_flags |= AI_NUMERICHOST;
 			if (core::stringify::has_integer(service))
 				hints.ai_flags |= AI_NUMERICSERV;
 
-			char buffer[core::CHUNK_SIZE];
-			size_t header_size = sizeof(uint16_t) * 7;
-			size_t max_service_size = sizeof(buffer) - header_size;
-			size_t service_size = std::min<size_t>(service.size(), max_service_size);
-			size_t hostname_size = std::min<size_t>(hostname.size(), max_service_size - service_size);
-			memcpy(buffer + sizeof(uint32_t) * 0, &resolver, sizeof(uint32_t));
-			memcpy(buffer + sizeof(uint32_t) * 1, &proto, sizeof(uint32_t));
-			memcpy(buffer + sizeof(uint32_t) * 2, &type, sizeof(uint32_t));
-			memcpy(buffer + sizeof(uint32_t) * 3, service.data(), service_size);
-			memcpy(buffer + sizeof(uint32_t) * 3 + service_size, hostname.data(), hostname_size);
+			struct addrinfo* address = nullptr;
+			if (getaddrinfo(hostname.empty() ? nullptr : hostname.data(), service.empty() ? nullptr : service.data(), &hints, &address) != 0)
+				return core::system_exception(core::stringify::text("dns resolve %s:%s address: invalid address", hostname.data(), service.data()));
 
-			core::key_hasher<core::string> hasher;
-			size_t hash = hasher(std::string_view(buffer, header_size + service_size + hostname_size));
+			socket_address target = socket_address(hostname, core::from_string<uint16_t>(service).otherwise(0), address);
+			freeaddrinfo(address);
+			return reverse_address_lookup(target);
+		}
+		core::expects_promise_system<core::string> dns::reverse_lookup_deferred(const std::string_view& source_hostname, const std::string_view& source_service)
+		{
+			core::string hostname = core::string(source_hostname), service = core::string(source_service);
+			return core::cotask<core::expects_system<core::string>>([this, hostname = std::move(hostname), service = std::move(service)]() mutable
 			{
-				core::umutex<std::mutex> unique(exclusive);
-				auto it = names.find(hash);
-				if (it != names.end() && it->second.first > time)
-					return it->second.second;
-			}
+				return reverse_lookup(hostname, service);
+			});
+		}
+		core::expects_system<core::string> dns::reverse_address_lookup(const socket_address& address)
+		{
+			VI_MEASURE((uint64_t)core::timings::networking * 3);
+			char reverse_hostname[NI_MAXHOST], reverse_service[NI_MAXSERV];
+			if (getnameinfo(address.get_raw_address(), (socklen_t)address.get_address_size(), reverse_hostname, NI_MAXHOST, reverse_service, NI_MAXSERV, NI_NUMERICSERV) != 0)
+				return core::system_exception(core::stringify::text("dns reverse resolve %s address: invalid address", get_address_identification(address).c_str()));
+
+			VI_DEBUG("[net] dns reverse resolved for entity %s (host %s:%s is used)", get_address_identification(address).c_str(), reverse_hostname, reverse_service);
+			return core::string(reverse_hostname, strnlen(reverse_hostname, sizeof(reverse_hostname)));
+		}
+		core::expects_promise_system<core::string> dns::reverse_address_lookup_deferred(const socket_address& address)
+		{
+			return core::cotask<core::expects_system<core::string>>([this, address]() mutable
+			{
+				return reverse_address_lookup(address);
+			});
+		}
+		core::expects_system<socket_address> dns::lookup(const std::string_view& hostname, const std::string_view& service, dns_type resolver, socket_protocol proto, socket_type type)
+		{
+			VI_ASSERT(!hostname.empty() && core::stringify::is_cstring(hostname), "host should be set");
+			VI_MEASURE((uint64_t)core::timings::networking * 3);
+			struct addrinfo hints = get_lookup_hints(resolver, proto, type);
+			if (has_ip_v4_address(hostname) || has_ip_v6_address(hostname))
+				hints.ai_flags |= AI_NUMERICHOST;
+			if (core::stringify::has_integer(service))
+				hints.ai_flags |= AI_NUMERICSERV;
+
+			size_t hash = get_lookup_hash(hostname, service, resolver, proto, type);
+			auto cache = get_cache(hash, hostname, service);
+			if (cache)
+				return std::move(*cache);
 
 			struct addrinfo* addresses = nullptr;
-			if (getaddrinfo(hostname.empty() ? nullptr : hostname.data(), service.empty() ? nullptr : service.data(), &hints, &addresses) != 0)
+			int status = getaddrinfo(hostname.empty() ? nullptr : hostname.data(), service.empty() ? nullptr : service.data(), &hints, &addresses);
+			if (status != 0)
+			{
+#ifdef EAI_NODATA
+				if (status == EAI_NONAME || status == EAI_NODATA)
+#else
+				if (status == EAI_NONAME)
+#endif
+					set_negative_cache(hash, DNS_NEGATIVE_TIMEOUT);
 				return core::system_exception(core::stringify::text("dns resolve %s:%s address: invalid address", hostname.data(), service.data()));
+			}
 
 			struct addrinfo* target_address = nullptr;
-			core::unordered_map<socket_t, addrinfo*> hosts;
+			core::vector<std::pair<socket_t, addrinfo*>> hosts4, hosts6;
 			for (auto it = addresses; it != nullptr; it = it->ai_next)
 			{
 				auto connectable = execute_socket(it->ai_family, it->ai_socktype, it->ai_protocol);
 				if (!connectable && connectable.error() == std::errc::permission_denied)
 				{
-					for (auto& host : hosts)
+					for (auto* group : { &hosts4, &hosts6 })
 					{
-						closesocket(host.first);
-						VI_DEBUG("[net] close dns fd %i", (int)host.first);
+						for (auto& host : *group)
+						{
+							closesocket(host.first);
+							VI_DEBUG("[net] close dns fd %i", (int)host.first);
+						}
 					}
+					freeaddrinfo(addresses);
 					return core::system_exception(core::stringify::text("dns resolve %s:%s address", hostname.data(), service.data()), std::move(connectable.error()));
 				}
 				else if (!connectable)
@@ -1891,7 +3229,7 @@ namespace vitex
 				VI_DEBUG("[net] open dns fd %i", (int)connection);
 				if (resolver == dns_type::connect)
 				{
-					hosts[connection] = it;
+					(it->ai_family == AF_INET6 ? hosts6 : hosts4).push_back(std::make_pair(connection, it));
 					continue;
 				}
 
@@ -1901,10 +3239,20 @@ namespace vitex
 				break;
 			}
 
+			core::vector<std::pair<socket_t, addrinfo*>> candidates;
+			candidates.reserve(hosts4.size() + hosts6.size());
+			for (size_t i = 0; i < std::max(hosts4.size(), hosts6.size()); i++)
+			{
+				if (i < hosts6.size())
+					candidates.push_back(hosts6[i]);
+				if (i < hosts4.size())
+					candidates.push_back(hosts4[i]);
+			}
+
 			if (resolver == dns_type::connect)
-				target_address = try_connect_dns(hosts, CONNECT_TIMEOUT);
+				target_address = try_connect_dns(candidates, CONNECT_TIMEOUT);
 
-			for (auto& host : hosts)
+			for (auto& host : candidates)
 			{
 				closesocket(host.first);
 				VI_DEBUG("[net] close dns fd %i", (int)host.first);
@@ -1919,45 +3267,262 @@ namespace vitex
 			socket_address result = socket_address(hostname, core::from_string<uint16_t>(service).otherwise(0), target_address);
 			VI_DEBUG("[net] dns resolved for entity %s:%s (address %s is used)", hostname.data(), service.data(), get_ip_address_identification(result).c_str());
 			freeaddrinfo(addresses);
+			return set_cache(hash, result, DNS_TIMEOUT);
+		}
+		core::expects_promise_system<socket_address> dns::lookup_deferred(const std::string_view& source_hostname, const std::string_view& source_service, dns_type resolver, socket_protocol proto, socket_type type)
+		{
+			VI_ASSERT(!source_hostname.empty() && core::stringify::is_cstring(source_hostname), "host should be set");
+			size_t hash = get_lookup_hash(source_hostname, source_service, resolver, proto, type);
+			auto cache = get_cache(hash, source_hostname, source_service);
+			if (cache)
+				return core::expects_promise_system<socket_address>(std::move(*cache));
+
+			core::string hostname = core::string(source_hostname), service = core::string(source_service);
+			if (!is_resolvable_deferred(hostname, service))
+			{
+				return core::cotask<core::expects_system<socket_address>>([this, hostname = std::move(hostname), service = std::move(service), resolver, proto, type]() mutable
+				{
+					return lookup(hostname, service, resolver, proto, type);
+				});
+			}
+
+			core::expects_promise_system<socket_address> future;
+			auto hints = get_lookup_hints(resolver, proto, type);
+			auto port = core::from_string<uint16_t>(service).otherwise(0);
+			auto resolve = [this, future, hash, hostname, service, resolver](dns_response&& response) mutable
+			{
+				if (response.addresses.empty())
+				{
+					if (response.negative)
+						set_negative_cache(hash, response.ttl);
+					return future.set(core::system_exception(core::stringify::text("dns resolve %s:%s address: invalid address", hostname.c_str(), service.c_str()), std::make_error_condition(response.failed ? std::errc::timed_out : std::errc::host_unreachable)));
+				}
+				else if (resolver != dns_type::connect)
+					return future.set(set_cache(hash, response.addresses.front(), response.ttl));
+
+				int64_t ttl = response.ttl;
+				auto* race = new dns_race(std::move(response.addresses), [this, future, hash, hostname, service, ttl](core::option<socket_address>&& address) mutable
+				{
+					if (!address)
+						return future.set(core::system_exception(core::stringify::text("dns resolve %s:%s address: invalid address", hostname.c_str(), service.c_str()), std::make_error_condition(std::errc::host_unreachable)));
+
+					VI_DEBUG("[net] dns resolved for entity %s:%s (address %s is used)", hostname.c_str(), service.c_str(), get_ip_address_identification(*address).c_str());
+					future.set(set_cache(hash, *address, ttl));
+				});
+				race->start();
+			};
+
+			if (has_ip_v4_address(hostname) || has_ip_v6_address(hostname))
+			{
+				dns_response response;
+				response.addresses.push_back(socket_address(hostname, port));
+				response.ttl = DNS_TIMEOUT;
+				resolve(std::move(response));
+				return future;
+			}
 
+			auto* query = new dns_query(get_nameservers(), hostname, port, hints, std::move(resolve));
+			query->start();
+			return future;
+		}
+		void dns::set_nameservers(core::vector<socket_address>&& addresses)
+		{
+			core::umutex<std::mutex> unique(exclusive);
+			nameservers = std::move(addresses);
+			names.clear();
+		}
+		core::vector<socket_address> dns::get_nameservers()
+		{
+			core::umutex<std::mutex> unique(exclusive);
+			return nameservers;
+		}
+		void dns::clear_cache()
+		{
+			core::umutex<std::mutex> unique(exclusive);
+			names.clear();
+		}
+		core::option<core::expects_system<socket_address>> dns::get_cache(size_t hash, const std::string_view& hostname, const std::string_view& service)
+		{
+			int64_t time = ::time(nullptr);
 			core::umutex<std::mutex> unique(exclusive);
 			auto it = names.find(hash);
-			if (it != names.end())
+			if (it == names.end() || it->second.expires <= time)
+				return core::optional::none;
+			else if (!it->second.negative)
+				return core::expects_system<socket_address>(it->second.address);
+
+			return core::expects_system<socket_address>(core::system_exception(core::stringify::text("dns resolve %.*s:%.*s address: invalid address", (int)hostname.size(), hostname.data(), (int)service.size(), service.data()), std::make_error_condition(std::errc::host_unreachable)));
+		}
+		socket_address dns::set_cache(size_t hash, const socket_address& address, int64_t ttl)
+		{
+			int64_t time = ::time(nullptr);
+			core::umutex<std::mutex> unique(exclusive);
+			auto& next = names[hash];
+			if (next.expires <= time || next.negative)
 			{
-				it->second.first = time + DNS_TIMEOUT;
-				result = it->second.second;
+				next.address = address;
+				next.negative = false;
 			}
-			else
-				names[hash] = std::make_pair(time + DNS_TIMEOUT, result);
 
-			return result;
+			next.expires = time + std::max<int64_t>(1, std::min<int64_t>(ttl, DNS_TIMEOUT));
+			return next.address;
 		}
-		core::expects_promise_system<socket_address> dns::lookup_deferred(const std::string_view& source_hostname, const std::string_view& source_service, dns_type resolver, socket_protocol proto, socket_type type)
+		void dns::set_negative_cache(size_t hash, int64_t ttl)
 		{
-			core::string hostname = core::string(source_hostname), service = core::string(source_service);
-			return core::cotask<core::expects_system<socket_address>>([this, hostname = std::move(hostname), service = std::move(service), resolver, proto, type]() mutable
+			int64_t time = ::time(nullptr);
+			core::umutex<std::mutex> unique(exclusive);
+			auto& next = names[hash];
+			next.address = socket_address();
+			next.expires = time + std::max<int64_t>(1, std::min<int64_t>(ttl, DNS_NEGATIVE_TIMEOUT));
+			next.negative = true;
+		}
+		bool dns::is_resolvable_deferred(const std::string_view& hostname, const std::string_view& service)
+		{
+			if (!core::schedule::is_available() || !core::stringify::has_integer(service))
+				return false;
+			else if (has_ip_v4_address(hostname) || has_ip_v6_address(hostname))
+				return true;
+			else if (hostname.find('.') == std::string::npos)
+				return false;
+
+			core::string name = core::string(hostname);
+			core::stringify::to_lower(name);
+			if (!name.empty() && name.back() == '.')
+				name.erase(name.size() - 1);
+
+			core::umutex<std::mutex> unique(exclusive);
+			return !nameservers.empty() && hosts.find(name) == hosts.end();
+		}
+		void dns::load_system_config()
+		{
+#ifndef VI_MICROSOFT
+			auto resolver = core::os::file::read_as_string("/etc/resolv.conf");
+			if (resolver)
 			{
-				return lookup(hostname, service, resolver, proto, type);
-			});
+				addrinfo hints = get_lookup_hints(dns_type::connect, socket_protocol::UDP, socket_type::datagram);
+				for (auto& line : core::stringify::split(*resolver, '\n'))
+				{
+					core::stringify::trim(line);
+					if (!core::stringify::starts_with(line, "nameserver"))
+						continue;
+
+					core::string address = line.substr(10);
+					core::stringify::trim(address);
+					size_t scope = address.find('%');
+					if (scope != std::string::npos)
+						address.erase(scope);
+
+					uint8_t buffer[16];
+					if (inet_pton(AF_INET, address.c_str(), buffer) == 1)
+						nameservers.push_back(get_lookup_address(address, 53, AF_INET, buffer, hints));
+					else if (inet_pton(AF_INET6, address.c_str(), buffer) == 1)
+						nameservers.push_back(get_lookup_address(address, 53, AF_INET6, buffer, hints));
+				}
+			}
+
+			auto entries = core::os::file::read_as_string("/etc/hosts");
+			if (entries)
+			{
+				for (auto& line : core::stringify::split(*entries, '\n'))
+				{
+					size_t comment = line.find('#');
+					if (comment != std::string::npos)
+						line.erase(comment);
+
+					core::stringify::replace(line, '\t', ' ');
+					auto items = core::stringify::split(line, ' ');
+					for (size_t i = 1; i < items.size(); i++)
+					{
+						if (items[i].empty())
+							continue;
+
+						core::stringify::to_lower(items[i]);
+						hosts.insert(std::move(items[i]));
+					}
+				}
+			}
+			VI_DEBUG("[dns] OK load %i nameservers and %i host names", (int)nameservers.size(), (int)hosts.size());
+#endif
+		}
+
+		multiplexer::shard::shard(size_t max_events, bool notifiable) noexcept : handle(max_events), owner(std::thread::id()), signaled(false), notifier(nullptr), signal(INVALID_SOCKET), watched(false)
+		{
+			fds.resize(max_events);
+			if (!notifiable)
+				return;
+
+			socket_t pair[2];
+			if (!utils::create_socket_pair(pair))
+				return;
+
+			notifier = new socket(pair[0]);
+			signal = pair[1];
+			watched = handle.watch(notifier);
+			if (!watched && !handle.add(notifier, true, false))
+			{
+				VI_WARN("[net] cannot watch shard notifier on fd %i: immediate events will be dispatched on any worker", (int)pair[0]);
+				closesocket(signal);
+				signal = INVALID_SOCKET;
+				core::memory::release(notifier);
+			}
+		}
+		multiplexer::shard::~shard() noexcept
+		{
+			if (signal != INVALID_SOCKET)
+				closesocket(signal);
+			core::memory::release(notifier);
 		}
 
 		multiplexer::multiplexer() noexcept : multiplexer(100, 256)
 		{
 		}
-		multiplexer::multiplexer(uint64_t dispatch_timeout, size_t max_events) noexcept : handle(max_events), activations(0), default_timeout(dispatch_timeout)
+		multiplexer::multiplexer(uint64_t dispatch_timeout, size_t max_events, size_t max_shards) noexcept : activations(0), cursor(0), default_timeout(dispatch_timeout)
 		{
-			VI_TRACE("[net] OK initialize multiplexer (%" PRIu64 " events)", (uint64_t)max_events);
-			fds.resize(max_events);
+			VI_TRACE("[net] OK initialize multiplexer (%" PRIu64 " events, %" PRIu64 " shards)", (uint64_t)max_events, (uint64_t)max_shards);
+			max_shards = std::max<size_t>(1, max_shards);
+			shards.reserve(max_shards);
+			for (size_t i = 0; i < max_shards; i++)
+				shards.push_back(core::memory::init<shard>(max_events, max_shards > 1));
 		}
 		multiplexer::~multiplexer() noexcept
 		{
+			activations = 0;
+			try_join();
 			shutdown();
+			for (auto* target : shards)
+				core::memory::deinit(target);
 			VI_TRACE("[net] free multiplexer");
 		}
-		void multiplexer::rescale(uint64_t dispatch_timeout, size_t max_events) noexcept
+		void multiplexer::rescale(uint64_t dispatch_timeout, size_t max_events, size_t max_shards) noexcept
 		{
 			default_timeout = dispatch_timeout;
-			handle = epoll_interface(max_events);
+			max_shards = std::max<size_t>(1, max_shards);
+			if (max_shards == shards.size())
+			{
+				for (auto* target : shards)
+				{
+					target->handle = epoll_interface(max_events);
+					target->fds.resize(max_events);
+					if (target->notifier != nullptr && !(target->watched = target->handle.watch(target->notifier)))
+						target->handle.add(target->notifier, true, false);
+				}
+				return;
+			}
+
+			size_t active = activations.exchange(0);
+			try_join();
+			shutdown();
+			for (auto* target : shards)
+				core::memory::deinit(target);
+
+			shards.clear();
+			shards.reserve(max_shards);
+			for (size_t i = 0; i < max_shards; i++)
+				shards.push_back(core::memory::init<shard>(max_events, max_shards > 1));
+
+			activations = active;
+			if (active > 0)
+				try_enqueue();
 		}
 		void multiplexer::activate() noexcept
 		{
@@ -1967,72 +3532,116 @@ namespace vitex
 		{
 			try_unlisten();
 		}
-		void multiplexer::shutdown() noexcept
+		void multiplexer::shutdown() noexcept
+		{
+			VI_MEASURE(core::timings::file_system);
+			for (auto* target : shards)
+			{
+				dispatch_timers(target, core::schedule::get_clock());
+				if (target->signaled.exchange(false, std::memory_order_acq_rel))
+				{
+					core::vector<core::task_callback> posted;
+					core::umutex<std::mutex> unique(target->exclusive);
+					posted.swap(target->posted);
+					unique.negate();
+					for (auto& callback : posted)
+						core::cospawn(std::move(callback));
+				}
+
+				core::ordered_map<std::chrono::microseconds, socket*> dirty_timers;
+				core::unordered_set<socket*> dirty_trackers;
+				core::umutex<std::mutex> unique(target->exclusive);
+				VI_DEBUG("[net] shutdown multiplexer on fds (sockets = %i)", (int)(target->timers.size() + target->trackers.size()));
+				dirty_timers.swap(target->timers);
+				dirty_trackers.swap(target->trackers);
+				unique.negate();
+
+				for (auto& item : dirty_trackers)
+				{
+					VI_DEBUG("[net] sock reset on fd %i", (int)item->fd);
+					item->events.expiration = std::chrono::microseconds(0);
+					cancel_events(item, socket_poll::reset);
+				}
+
+				for (auto& item : dirty_timers)
+				{
+					VI_DEBUG("[net] sock timeout on fd %i", (int)item.second->fd);
+					item.second->events.expiration = std::chrono::microseconds(0);
+					cancel_events(item.second, socket_poll::timeout);
+				}
+			}
+		}
+		int multiplexer::dispatch(uint64_t event_timeout) noexcept
 		{
-			VI_MEASURE(core::timings::file_system);
-			dispatch_timers(core::schedule::get_clock());
+			if (shards.size() == 1)
+				return dispatch_shard(shards.front(), event_timeout);
 
-			core::ordered_map<std::chrono::microseconds, socket*> dirty_timers;
-			core::unordered_set<socket*> dirty_trackers;
-			core::umutex<std::mutex> unique(exclusive);
-			VI_DEBUG("[net] shutdown multiplexer on fds (sockets = %i)", (int)(timers.size() + trackers.size()));
-			dirty_timers.swap(timers);
-			dirty_trackers.swap(trackers);
-
-			for (auto& item : dirty_trackers)
+			int count = 0;
+			for (auto* target : shards)
 			{
-				VI_DEBUG("[net] sock reset on fd %i", (int)item->fd);
-				item->events.expiration = std::chrono::microseconds(0);
-				cancel_events(item, socket_poll::reset);
+				int events = dispatch_shard(target, 0);
+				if (events > 0)
+					count += events;
 			}
 
-			for (auto& item : dirty_timers)
-			{
-				VI_DEBUG("[net] sock timeout on fd %i", (int)item.second->fd);
-				item.second->events.expiration = std::chrono::microseconds(0);
-				cancel_events(item.second, socket_poll::timeout);
-			}
+			return count;
 		}
-		int multiplexer::dispatch(uint64_t event_timeout) noexcept
+		int multiplexer::dispatch_shard(shard* target, uint64_t event_timeout) noexcept
 		{
-			int count = handle.wait(fds.data(), fds.size(), event_timeout);
+			int count = target->handle.wait(target->fds.data(), target->fds.size(), event_timeout);
 			auto time = core::schedule::get_clock();
 			if (count > 0)
 			{
 				VI_MEASURE(core::timings::file_system);
 				size_t size = (size_t)count;
 				for (size_t i = 0; i < size; i++)
-					dispatch_events(fds[i], time);
+				{
+					auto& fd = target->fds[i];
+					if (fd.base != target->notifier || !fd.base)
+						dispatch_events(target, fd, time);
+					else
+						dispatch_notifier(target);
+				}
 			}
 
-			dispatch_timers(time);
+			dispatch_posted(target);
+			dispatch_timers(target, time);
+			target->handle.flush();
 			return count;
 		}
-		void multiplexer::dispatch_timers(const std::chrono::microseconds& time) noexcept
+		void multiplexer::dispatch_timers(shard* target, const std::chrono::microseconds& time) noexcept
 		{
 			VI_MEASURE(core::timings::file_system);
-			if (timers.empty())
+			if (target->timers.empty())
 				return;
 
-			core::umutex<std::mutex> unique(exclusive);
-			while (!timers.empty())
+			core::umutex<std::mutex> unique(target->exclusive);
+			while (!target->timers.empty())
 			{
-				auto it = timers.begin();
+				auto it = target->timers.begin();
 				if (it->first > time)
 					break;
 
 				VI_DEBUG("[net] sock timeout on fd %i", (int)it->second->fd);
 				it->second->events.expiration = std::chrono::microseconds(0);
 				cancel_events(it->second, socket_poll::timeout);
-				timers.erase(it);
+				target->timers.erase(it);
 			}
 		}
-		bool multiplexer::dispatch_events(const epoll_fd& fd, const std::chrono::microseconds& time) noexcept
+		bool multiplexer::dispatch_events(shard* target, const epoll_fd& fd, const std::chrono::microseconds& time) noexcept
 		{
 			VI_ASSERT(fd.base != nullptr, "no socket is connected to epoll fd");
 			VI_TRACE("[net] sock event:%s%s%s on fd %i", fd.closeable ? "c" : "", fd.readable ? "r" : "", fd.writeable ? "w" : "", (int)fd.base->fd);
 			if (fd.closeable)
 			{
+				core::umutex<std::mutex> unique(fd.base->events.mutex);
+				if (fd.base->events.watching && !fd.base->events.read_callback && !fd.base->events.write_callback)
+				{
+					latch_readiness(fd.base->events.readiness, READY_CLOSE);
+					return false;
+				}
+
+				unique.negate();
 				VI_DEBUG("[net] sock reset on fd %i", (int)fd.base->fd);
 				cancel_events(fd.base, socket_poll::reset);
 				return false;
@@ -2041,20 +3650,25 @@ namespace vitex
 				return true;
 
 			core::umutex<std::mutex> unique(fd.base->events.mutex);
+			bool watching = fd.base->events.watching;
 			bool was_listening_read = !!fd.base->events.read_callback;
 			bool was_listening_write = !!fd.base->events.write_callback;
 			bool still_listening_read = !fd.readable && was_listening_read;
 			bool still_listening_write = !fd.writeable && was_listening_write;
+			if (watching)
+				latch_readiness(fd.base->events.readiness, (fd.readable ? READY_READ : 0) | (fd.writeable ? READY_WRITE : 0));
+
 			if (still_listening_read || still_listening_write)
 			{
-				if (was_listening_read != still_listening_read || was_listening_write != still_listening_write)
-					handle.update(fd.base, still_listening_read, still_listening_write);
-				update_timeout(fd.base, time);
+				if (!watching && (was_listening_read != still_listening_read || was_listening_write != still_listening_write))
+					target->handle.update(fd.base, still_listening_read, still_listening_write);
+				update_timeout(target, fd.base, time);
 			}
 			else if (was_listening_read || was_listening_write)
 			{
-				handle.remove(fd.base);
-				remove_timeout(fd.base);
+				if (!watching)
+					target->handle.remove(fd.base);
+				remove_timeout(target, fd.base);
 			}
 
 			if (fd.readable && fd.writeable)
@@ -2063,7 +3677,7 @@ namespace vitex
 				fd.base->events.read_callback.swap(read_callback);
 				fd.base->events.write_callback.swap(write_callback);
 				unique.negate();
-				core::cospawn([read_callback = std::move(read_callback), write_callback = std::move(write_callback)]() mutable
+				dispatch_callback([read_callback = std::move(read_callback), write_callback = std::move(write_callback)]() mutable
 				{
 					if (write_callback)
 						write_callback(socket_poll::finish);
@@ -2076,33 +3690,98 @@ namespace vitex
 				poll_event_callback read_callback;
 				fd.base->events.read_callback.swap(read_callback);
 				unique.negate();
-				core::cospawn([read_callback = std::move(read_callback)]() mutable { read_callback(socket_poll::finish); });
+				dispatch_callback([read_callback = std::move(read_callback)]() mutable { read_callback(socket_poll::finish); });
 			}
 			else if (fd.writeable && was_listening_write)
 			{
 				poll_event_callback write_callback;
 				fd.base->events.write_callback.swap(write_callback);
 				unique.negate();
-				core::cospawn([write_callback = std::move(write_callback)]() mutable { write_callback(socket_poll::finish); });
+				dispatch_callback([write_callback = std::move(write_callback)]() mutable { write_callback(socket_poll::finish); });
 			}
 
 			return still_listening_read || still_listening_write;
 		}
+		void multiplexer::dispatch_callback(core::task_callback&& callback) noexcept
+		{
+			if (shards.size() > 1)
+				callback();
+			else
+				core::cospawn(std::move(callback));
+		}
+		void multiplexer::dispatch_notifier(shard* target) noexcept
+		{
+			uint8_t buffer[64];
+			while (recv(target->notifier->fd, (char*)buffer, sizeof(buffer), 0) > 0);
+			if (!target->watched)
+				target->handle.update(target->notifier, true, false);
+		}
+		bool multiplexer::dispatch_posted(shard* target) noexcept
+		{
+			if (!target->signaled.exchange(false, std::memory_order_acq_rel))
+				return false;
+
+			core::vector<core::task_callback> posted;
+			core::umutex<std::mutex> unique(target->exclusive);
+			posted.swap(target->posted);
+			unique.negate();
+
+			VI_MEASURE(core::timings::file_system);
+			for (auto& callback : posted)
+				callback();
+			return target->signaled.load(std::memory_order_acquire);
+		}
+		void multiplexer::post_callback(shard* target, core::task_callback&& callback) noexcept
+		{
+			if (!target->notifier)
+				return core::cospawn(std::move(callback));
+
+			core::umutex<std::mutex> unique(target->exclusive);
+			target->posted.push_back(std::move(callback));
+			unique.negate();
+			if (target->signaled.exchange(true, std::memory_order_acq_rel) || target->owner.load(std::memory_order_relaxed) == std::this_thread::get_id())
+				return;
+
+			uint8_t buffer = 0;
+			send(target->signal, (char*)&buffer, 1, 0);
+		}
 		bool multiplexer::when_readable(socket* value, poll_event_callback&& when_ready) noexcept
 		{
 			VI_ASSERT(value != nullptr && value->fd != INVALID_SOCKET, "socket should be set and valid");
 			VI_ASSERT(when_ready != nullptr, "readable callback should be set");
+			if (value->pending.size > 0)
+			{
+				post_callback(get_shard(value), [when_ready = std::move(when_ready)]() mutable { when_ready(socket_poll::finish); });
+				return true;
+			}
+			else if (!value->staged.empty())
+				value->flush_staged_queued();
+
 			core::umutex<std::mutex> unique(value->events.mutex);
+			auto* target = get_shard(value);
+			if (!value->events.watching)
+				value->events.watching = target->handle.watch(value);
+
+			uint64_t readiness = value->events.readiness.load(std::memory_order_acquire);
+			if (value->events.watching && readiness & (READY_READ | READY_CLOSE))
+			{
+				auto event = readiness & READY_CLOSE ? socket_poll::reset : socket_poll::finish;
+				value->events.readiness.fetch_and(~(uint64_t)READY_READ, std::memory_order_acq_rel);
+				unique.negate();
+				post_callback(target, [event, when_ready = std::move(when_ready)]() mutable { when_ready(event); });
+				return true;
+			}
+
 			bool was_listening_read = !!value->events.read_callback;
 			bool still_listening_write = !!value->events.write_callback;
 			value->events.read_callback.swap(when_ready);
-			bool listening = (when_ready ? handle.update(value, true, still_listening_write) : handle.add(value, true, still_listening_write));
+			bool listening = value->events.watching || (when_ready ? target->handle.update(value, true, still_listening_write) : target->handle.add(value, true, still_listening_write));
 			if (!was_listening_read && !still_listening_write)
-				add_timeout(value, core::schedule::get_clock());
+				add_timeout(target, value, core::schedule::get_clock());
 
 			unique.negate();
 			if (when_ready)
-				core::cospawn([when_ready = std::move(when_ready)]() mutable { when_ready(socket_poll::cancel); });
+				post_callback(target, [when_ready = std::move(when_ready)]() mutable { when_ready(socket_poll::cancel); });
 
 			return listening;
 		}
@@ -2110,16 +3789,30 @@ namespace vitex
 		{
 			VI_ASSERT(value != nullptr && value->fd != INVALID_SOCKET, "socket should be set and valid");
 			core::umutex<std::mutex> unique(value->events.mutex);
+			auto* target = get_shard(value);
+			if (!value->events.watching)
+				value->events.watching = target->handle.watch(value);
+
+			uint64_t readiness = value->events.readiness.load(std::memory_order_acquire);
+			if (value->events.watching && readiness & (READY_WRITE | READY_CLOSE))
+			{
+				auto event = readiness & READY_CLOSE ? socket_poll::reset : socket_poll::finish;
+				value->events.readiness.fetch_and(~(uint64_t)READY_WRITE, std::memory_order_acq_rel);
+				unique.negate();
+				post_callback(target, [event, when_ready = std::move(when_ready)]() mutable { when_ready(event); });
+				return true;
+			}
+
 			bool still_listening_read = !!value->events.read_callback;
 			bool was_listening_write = !!value->events.write_callback;
 			value->events.write_callback.swap(when_ready);
-			bool listening = (when_ready ? handle.update(value, still_listening_read, true) : handle.add(value, still_listening_read, true));
+			bool listening = value->events.watching || (when_ready ? target->handle.update(value, still_listening_read, true) : target->handle.add(value, still_listening_read, true));
 			if (!was_listening_write && !still_listening_read)
-				add_timeout(value, core::schedule::get_clock());
+				add_timeout(target, value, core::schedule::get_clock());
 
 			unique.negate();
 			if (when_ready)
-				core::cospawn([when_ready = std::move(when_ready)]() mutable { when_ready(socket_poll::cancel); });
+				post_callback(target, [when_ready = std::move(when_ready)]() mutable { when_ready(socket_poll::cancel); });
 
 			return listening;
 		}
@@ -2127,13 +3820,21 @@ namespace vitex
 		{
 			VI_ASSERT(value != nullptr, "socket should be set and valid");
 			core::umutex<std::mutex> unique(value->events.mutex);
+			auto* target = get_shard(value);
 			poll_event_callback read_callback, write_callback;
 			value->events.read_callback.swap(read_callback);
 			value->events.write_callback.swap(write_callback);
 			bool was_listening = read_callback || write_callback;
-			bool not_listening = was_listening && value->is_valid() ? handle.remove(value) : true;
+			bool was_watching = value->events.watching && event != socket_poll::timeout;
+			if (was_watching)
+			{
+				value->events.watching = false;
+				value->events.readiness = 0;
+			}
+
+			bool not_listening = (was_watching || (was_listening && !value->events.watching)) && value->is_valid() ? target->handle.remove(value) : true;
 			if (was_listening)
-				remove_timeout(value);
+				remove_timeout(target, value);
 
 			unique.negate();
 			if (packet::is_done(event) || !was_listening)
@@ -2159,65 +3860,92 @@ namespace vitex
 		{
 			return cancel_events(value, socket_poll::finish);
 		}
+		bool multiplexer::submit_close(socket* value) noexcept
+		{
+			VI_ASSERT(value != nullptr && value->fd != INVALID_SOCKET, "socket should be set and valid");
+			return get_shard(value)->handle.close(value->fd);
+		}
 		bool multiplexer::is_listening() noexcept
 		{
 			return activations > 0;
 		}
-		void multiplexer::add_timeout(socket* value, const std::chrono::microseconds& time) noexcept
+		bool multiplexer::is_sharded() const noexcept
+		{
+			return shards.size() > 1;
+		}
+		void multiplexer::add_timeout(shard* target, socket* value, const std::chrono::microseconds& time) noexcept
 		{
 			if (value->events.timeout > 0)
 			{
 				VI_TRACE("[net] sock set timeout on fd %i (time = %i)", (int)value->fd, (int)value->events.timeout);
 				auto expiration = time + std::chrono::milliseconds(value->events.timeout);
-				core::umutex<std::mutex> unique(exclusive);
-				while (timers.find(expiration) != timers.end())
+				core::umutex<std::mutex> unique(target->exclusive);
+				while (target->timers.find(expiration) != target->timers.end())
 					++expiration;
 
-				timers[expiration] = value;
+				target->timers[expiration] = value;
 				value->events.expiration = expiration;
 			}
 			else
 			{
-				core::umutex<std::mutex> unique(exclusive);
+				core::umutex<std::mutex> unique(target->exclusive);
 				value->events.expiration = std::chrono::microseconds(-1);
-				trackers.insert(value);
+				target->trackers.insert(value);
 			}
 		}
-		void multiplexer::update_timeout(socket* value, const std::chrono::microseconds& time) noexcept
+		void multiplexer::update_timeout(shard* target, socket* value, const std::chrono::microseconds& time) noexcept
 		{
-			remove_timeout(value);
-			add_timeout(value, time);
+			remove_timeout(target, value);
+			add_timeout(target, value, time);
 		}
-		void multiplexer::remove_timeout(socket* value) noexcept
+		void multiplexer::remove_timeout(shard* target, socket* value) noexcept
 		{
 			VI_TRACE("[net] sock cancel timeout on fd %i", (int)value->fd);
 			if (value->events.expiration > std::chrono::microseconds(0))
 			{
-				core::umutex<std::mutex> unique(exclusive);
-				auto it = timers.find(value->events.expiration);
-				VI_ASSERT(it != timers.end(), "socket timeout update de-sync happend");
+				core::umutex<std::mutex> unique(target->exclusive);
+				auto it = target->timers.find(value->events.expiration);
+				VI_ASSERT(it != target->timers.end(), "socket timeout update de-sync happend");
 				value->events.expiration = std::chrono::microseconds(0);
-				if (it != timers.end())
-					timers.erase(it);
+				if (it != target->timers.end())
+					target->timers.erase(it);
 			}
 			else if (value->events.expiration < std::chrono::microseconds(0))
 			{
-				core::umutex<std::mutex> unique(exclusive);
+				core::umutex<std::mutex> unique(target->exclusive);
 				value->events.expiration = std::chrono::microseconds(0);
-				trackers.erase(value);
+				target->trackers.erase(value);
 			}
 		}
 		void multiplexer::try_dispatch() noexcept
 		{
 			auto* queue = core::schedule::get();
-			dispatch(queue->has_parallel_threads(core::difficulty::sync) ? default_timeout : 5);
+			dispatch_shard(shards.front(), queue->has_parallel_threads(core::difficulty::sync) ? default_timeout : 5);
 			try_enqueue();
 		}
+		void multiplexer::try_dispatch_shard(shard* target) noexcept
+		{
+			VI_DEBUG("[net] start events polling on shard thread %s", core::os::process::get_thread_id(std::this_thread::get_id()).c_str());
+			target->owner = std::this_thread::get_id();
+			while (activations > 0)
+				dispatch_shard(target, target->signaled.load(std::memory_order_acquire) ? 0 : default_timeout);
+			target->owner = std::thread::id();
+		}
 		void multiplexer::try_enqueue() noexcept
 		{
 			if (!activations)
 				return;
 
+			if (shards.size() > 1)
+			{
+				for (auto* target : shards)
+				{
+					if (!target->worker.joinable())
+						target->worker = std::thread(&multiplexer::try_dispatch_shard, this, target);
+				}
+				return;
+			}
+
 			auto* queue = core::schedule::get();
 			queue->set_task(std::bind(&multiplexer::try_dispatch, this));
 		}
@@ -2233,41 +3961,79 @@ namespace vitex
 		{
 			VI_ASSERT(activations > 0, "events poller is already inactive");
 			if (!--activations)
+			{
 				VI_DEBUG("[net] stop events polling");
+				try_join();
+			}
+		}
+		void multiplexer::try_join() noexcept
+		{
+			for (auto* target : shards)
+			{
+				if (!target->worker.joinable())
+					continue;
+
+				if (target->worker.get_id() == std::this_thread::get_id())
+					target->worker.detach();
+				else
+					target->worker.join();
+			}
 		}
 		size_t multiplexer::get_activations() noexcept
 		{
 			return activations;
 		}
+		size_t multiplexer::get_shards() const noexcept
+		{
+			return shards.size();
+		}
+		multiplexer::shard* multiplexer::get_shard(socket* value) noexcept
+		{
+			if (shards.size() == 1)
+				return shards.front();
+
+			if (!value->events.shard)
+				value->events.shard = ++cursor;
+
+			return shards[(value->events.shard - 1) % shards.size()];
+		}
 
-		uplinks::uplinks() noexcept : max_duplicates(1)
+		uplinks::uplinks(size_t max_shards) noexcept : hits(0), misses(0), evictions(0), idle(0), max_duplicates(1), max_idle(0), idle_timeout(UPLINK_IDLE_TIMEOUT)
 		{
+			shards.resize(std::max<size_t>(1, max_shards));
+			for (auto& target : shards)
+				target = core::memory::init<shard>();
 			multiplexer::get()->activate();
 		}
 		uplinks::~uplinks() noexcept
 		{
 			auto* dispatcher = multiplexer::get();
 			core::single_queue<acquire_callback> queue;
-			core::umutex<std::recursive_mutex> unique(exclusive);
-			for (auto& item : connections)
+			max_duplicates = 0;
+			for (auto* target : shards)
 			{
-				for (auto& stream : item.second.streams)
+				core::umutex<std::recursive_mutex> unique(target->exclusive);
+				for (auto& item : target->connections)
 				{
-					dispatcher->cancel_events(stream);
-					core::memory::release(stream);
-				}
+					for (auto& next : item.second.streams)
+					{
+						dispatcher->cancel_events(next.stream);
+						core::memory::release(next.stream);
+					}
 
-				while (!item.second.requests.empty())
-				{
-					queue.push(std::move(item.second.requests.front()));
-					item.second.requests.pop();
+					while (!item.second.requests.empty())
+					{
+						queue.push(std::move(item.second.requests.front()));
+						item.second.requests.pop();
+					}
 				}
+				target->connections.clear();
 			}
 
-			max_duplicates = 0;
-			connections.clear();
+			for (auto* target : shards)
+				core::memory::deinit(target);
+			shards.clear();
 			dispatcher->deactivate();
-			unique.negate();
 
 			while (!queue.empty())
 			{
@@ -2279,6 +4045,14 @@ namespace vitex
 		{
 			max_duplicates = max + 1;
 		}
+		void uplinks::set_max_idle(size_t max)
+		{
+			max_idle = max;
+		}
+		void uplinks::set_idle_timeout(uint64_t timeout_ms)
+		{
+			idle_timeout = timeout_ms;
+		}
 		void uplinks::listen_connection(core::string&& id, socket* stream)
 		{
 			stream->add_ref();
@@ -2287,23 +4061,31 @@ namespace vitex
 				if (packet::is_error(event))
 				{
 				expire:
-					core::umutex<std::recursive_mutex> unique(exclusive);
-					auto it = connections.find(id);
-					if (it != connections.end())
+					auto* target = get_shard(id);
+					core::umutex<std::recursive_mutex> unique(target->exclusive);
+					auto it = target->connections.find(id);
+					if (it != target->connections.end())
 					{
-						auto queue = std::move(it->second.requests);
-						core::uptr<socket> target_stream = stream;
-						multiplexer::get()->cancel_events(stream);
-						it->second.streams.erase(stream);
-						if (it->second.streams.empty() && it->second.requests.empty())
-							connections.erase(it);
-						unique.negate();
-
-						VI_DEBUG("[uplink] expire fd %i of %s", (int)stream->get_fd(), id.c_str());
-						while (!queue.empty())
+						auto& streams = it->second.streams;
+						auto next = std::find_if(streams.begin(), streams.end(), [stream](const idle_stream& item) { return item.stream == stream; });
+						if (next != streams.end())
 						{
-							queue.front()(nullptr);
-							queue.pop();
+							auto queue = std::move(it->second.requests);
+							core::uptr<socket> target_stream = stream;
+							multiplexer::get()->cancel_events(stream);
+							streams.erase(next);
+							if (streams.empty() && it->second.requests.empty())
+								target->connections.erase(it);
+							unique.negate();
+
+							++evictions;
+							--idle;
+							VI_DEBUG("[uplink] expire fd %i of %s", (int)stream->get_fd(), id.c_str());
+							while (!queue.empty())
+							{
+								queue.front()(nullptr);
+								queue.pop();
+							}
 						}
 					}
 				}
@@ -2322,25 +4104,50 @@ namespace vitex
 				stream->release();
 			});
 		}
+		void uplinks::store_connection(core::string&& id, connection_queue& pool, socket* stream, core::vector<socket*>& evicted)
+		{
+			size_t limit = max_idle > 0 ? max_idle : max_duplicates;
+			while (!pool.streams.empty() && pool.streams.size() >= limit)
+			{
+				evicted.push_back(pool.streams.back().stream);
+				pool.streams.pop_back();
+				++evictions;
+				--idle;
+			}
+
+			VI_DEBUG("[uplink] store fd %i of %s", (int)stream->get_fd(), id.c_str());
+			pool.streams.push_front({ stream, core::schedule::get_clock() });
+			stream->set_io_timeout(idle_timeout);
+			stream->set_blocking(false);
+			listen_connection(std::move(id), stream);
+			++idle;
+		}
+		void uplinks::release_connections(core::vector<socket*>& evicted)
+		{
+			auto* dispatcher = multiplexer::get();
+			for (auto* stream : evicted)
+			{
+				VI_DEBUG("[uplink] evict fd %i", (int)stream->get_fd());
+				dispatcher->cancel_events(stream);
+				core::memory::release(stream);
+			}
+		}
 		bool uplinks::push_connection(const socket_address& address, socket* stream)
 		{
 			if (!max_duplicates)
 				return false;
 
+			core::vector<socket*> evicted;
 			auto name = get_address_identification(address);
-			core::umutex<std::recursive_mutex> unique(exclusive);
-			auto it = connections.find(name);
-			if (it == connections.end())
+			auto* target = get_shard(name);
+			core::umutex<std::recursive_mutex> unique(target->exclusive);
+			auto it = target->connections.find(name);
+			if (it == target->connections.end())
 			{
 				if (!stream)
 					return false;
 
-				VI_DEBUG("[uplink] store fd %i of %s", (int)stream->get_fd(), name.c_str());
-				auto& pool = connections[name];
-				pool.streams.insert(stream);
-				stream->set_io_timeout(0);
-				stream->set_blocking(false);
-				listen_connection(std::move(name), stream);
+				store_connection(std::move(name), target->connections[name], stream, evicted);
 				return true;
 			}
 			else if (!it->second.requests.empty())
@@ -2353,22 +4160,19 @@ namespace vitex
 					return false;
 
 				VI_DEBUG("[uplink] reuse fd %i of %s", (int)stream->get_fd(), name.c_str());
+				++hits;
 				return true;
 			}
 			else if (!stream)
 			{
 				if (it->second.streams.empty())
-					connections.erase(it);
+					target->connections.erase(it);
 				return false;
 			}
-			else if (it->second.streams.size() >= max_duplicates)
-				return false;
 
-			VI_DEBUG("[uplink] store fd %i of %s", (int)stream->get_fd(), name.c_str());
-			it->second.streams.insert(stream);
-			stream->set_io_timeout(0);
-			stream->set_blocking(false);
-			listen_connection(std::move(name), stream);
+			store_connection(std::move(name), it->second, stream, evicted);
+			unique.negate();
+			release_connections(evicted);
 			return true;
 		}
 		bool uplinks::pop_connection_queued(const socket_address& address, acquire_callback&& callback)
@@ -2381,20 +4185,47 @@ namespace vitex
 			}
 
 			auto name = get_address_identification(address);
-			core::umutex<std::recursive_mutex> unique(exclusive);
-			auto it = connections.find(name);
-			if (it == connections.end())
+			auto* target = get_shard(name);
+			core::umutex<std::recursive_mutex> unique(target->exclusive);
+			auto it = target->connections.find(name);
+			if (it == target->connections.end())
 			{
-				auto& item = connections[name];
+				auto& item = target->connections[name];
 				item.duplicates = max_duplicates - 1;
+				++misses;
 				callback(nullptr);
 				return false;
 			}
-			else if (it->second.streams.empty())
+
+			core::vector<socket*> evicted;
+			auto time = core::schedule::get_clock();
+			auto timeout = std::chrono::milliseconds(idle_timeout);
+			socket* stream = nullptr;
+			while (!stream && !it->second.streams.empty())
+			{
+				auto next = it->second.streams.front();
+				it->second.streams.pop_front();
+				--idle;
+
+				if ((idle_timeout > 0 && time - next.since >= timeout) || !next.stream->is_reusable())
+				{
+					evicted.push_back(next.stream);
+					++evictions;
+				}
+				else
+					stream = next.stream;
+			}
+
+			if (!stream)
 			{
-				if (it->second.duplicates > 0)
+				if (it->second.duplicates > 0 || !evicted.empty())
 				{
-					--it->second.duplicates;
+					it->second.duplicates += evicted.size();
+					if (it->second.duplicates > 0)
+						--it->second.duplicates;
+					unique.negate();
+					release_connections(evicted);
+					++misses;
 					callback(nullptr);
 					return false;
 				}
@@ -2403,14 +4234,12 @@ namespace vitex
 				return true;
 			}
 
-			socket* stream = *it->second.streams.begin();
-			it->second.streams.erase(it->second.streams.begin());
-			unique.unlock();
-
+			unique.negate();
+			release_connections(evicted);
 			VI_DEBUG("[uplink] reuse fd %i of %s", (int)stream->get_fd(), name.c_str());
 			multiplexer::get()->cancel_events(stream);
+			++hits;
 			callback(stream);
-
 			return true;
 		}
 		core::promise<socket*> uplinks::pop_connection(const socket_address& address)
@@ -2419,14 +4248,41 @@ namespace vitex
 			pop_connection_queued(address, [future](socket* target) mutable { future.set(target); });
 			return future;
 		}
+		uplink_statistics uplinks::get_statistics() const
+		{
+			uplink_statistics result;
+			result.hits = hits.load();
+			result.misses = misses.load();
+			result.evictions = evictions.load();
+			result.idle = idle.load();
+			return result;
+		}
 		size_t uplinks::get_max_duplicates() const
 		{
 			return max_duplicates;
 		}
+		size_t uplinks::get_max_idle() const
+		{
+			return max_idle;
+		}
+		uint64_t uplinks::get_idle_timeout() const
+		{
+			return idle_timeout;
+		}
 		size_t uplinks::get_size()
 		{
-			core::umutex<std::recursive_mutex> unique(exclusive);
-			return connections.size();
+			size_t size = 0;
+			for (auto* target : shards)
+			{
+				core::umutex<std::recursive_mutex> unique(target->exclusive);
+				size += target->connections.size();
+			}
+			return size;
+		}
+		uplinks::shard* uplinks::get_shard(const std::string_view& id)
+		{
+			core::key_hasher<core::string> hasher;
+			return shards[hasher(id) % shards.size()];
 		}
 
 		certificate_builder::certificate_builder() noexcept
@@ -2683,10 +4539,13 @@ namespace vitex
 			return private_key;
 		}
 
-		socket::ievents::ievents(ievents&& other) noexcept : read_callback(other.read_callback), write_callback(other.write_callback), expiration(other.expiration), timeout(other.timeout)
+		socket::ievents::ievents(ievents&& other) noexcept : read_callback(other.read_callback), write_callback(other.write_callback), expiration(other.expiration), timeout(other.timeout), shard(other.shard)
 		{
 			other.expiration = std::chrono::milliseconds(0);
+			other.readiness = 0;
 			other.timeout = 0;
+			other.shard = 0;
+			other.watching = false;
 		}
 		socket::ievents& socket::ievents::operator=(ievents&& other) noexcept
 		{
@@ -2696,9 +4555,15 @@ namespace vitex
 			read_callback = std::move(other.read_callback);
 			write_callback = std::move(other.write_callback);
 			expiration = other.expiration;
+			readiness = 0;
 			timeout = other.timeout;
+			shard = other.shard;
+			watching = false;
 			other.expiration = std::chrono::milliseconds(0);
+			other.readiness = 0;
 			other.timeout = 0;
+			other.shard = 0;
+			other.watching = false;
 			return *this;
 		}
 
@@ -2710,9 +4575,10 @@ namespace vitex
 		{
 			VI_WATCH(this, "socket fd");
 		}
-		socket::socket(socket&& other) noexcept : events(std::move(other.events)), device(other.device), fd(other.fd), income(other.income), outcome(other.outcome)
+		socket::socket(socket&& other) noexcept : events(std::move(other.events)), pending(other.pending), staged(std::move(other.staged)), device(other.device), fd(other.fd), income(other.income), outcome(other.outcome)
 		{
 			VI_WATCH(this, "socket fd (moved)");
+			other.pending = ibuffer();
 			other.device = nullptr;
 			other.fd = INVALID_SOCKET;
 		}
@@ -2720,6 +4586,8 @@ namespace vitex
 		{
 			VI_UNWATCH(this);
 			shutdown();
+			if (pending.data != nullptr)
+				core::memory::deallocate(pending.data);
 		}
 		socket& socket::operator= (socket&& other) noexcept
 		{
@@ -2727,11 +4595,17 @@ namespace vitex
 				return *this;
 
 			shutdown();
+			if (pending.data != nullptr)
+				core::memory::deallocate(pending.data);
+
 			events = std::move(other.events);
+			pending = other.pending;
+			staged = std::move(other.staged);
 			device = other.device;
 			fd = other.fd;
 			income = other.income;
 			outcome = other.outcome;
+			other.pending = ibuffer();
 			other.device = nullptr;
 			other.fd = INVALID_SOCKET;
 			return *this;
@@ -2741,10 +4615,13 @@ namespace vitex
 			VI_ASSERT(incoming != nullptr, "incoming socket should be set");
 			char address[ADDRESS_SIZE];
 			socket_size_t length = sizeof(address);
+			uint64_t readiness = events.readiness.load(std::memory_order_acquire);
 			auto new_fd = execute_accept(fd, (sockaddr*)&address, &length);
 			if (!new_fd)
 			{
 				VI_TRACE("[net] fd %i: not acceptable", (int)fd);
+				if (new_fd.error() == std::errc::operation_would_block)
+					unlatch_readiness(events.readiness, readiness, READY_READ);
 				return new_fd.error();
 			}
 
@@ -2817,11 +4694,14 @@ namespace vitex
 			if (device != nullptr)
 			{
 				VI_TRACE("[net] fd %i free ssl device", (int)fd);
+				if (SSL_is_init_finished(device))
+					SSL_shutdown(device);
 				SSL_free(device);
 				device = nullptr;
 			}
 #endif
 			clear_events(gracefully);
+			clear_pending();
 			if (fd == INVALID_SOCKET)
 				return std::make_error_condition(std::errc::bad_file_descriptor);
 
@@ -2840,15 +4720,20 @@ namespace vitex
 		}
 		core::expects_io<void> socket::close()
 		{
+			flush_staged();
+			staged.clear();
 #ifdef VI_OPENSSL
 			if (device != nullptr)
 			{
 				VI_TRACE("[net] fd %i free ssl device", (int)fd);
+				if (SSL_is_init_finished(device))
+					SSL_shutdown(device);
 				SSL_free(device);
 				device = nullptr;
 			}
 #endif
 			clear_events(false);
+			clear_pending();
 			if (fd == INVALID_SOCKET)
 				return std::make_error_condition(std::errc::bad_file_descriptor);
 
@@ -2888,10 +4773,14 @@ namespace vitex
 		core::expects_io<void> socket::close_queued(socket_status_callback&& callback)
 		{
 			VI_ASSERT(callback != nullptr, "callback should be set");
+			flush_staged();
+			staged.clear();
 #ifdef VI_OPENSSL
 			if (device != nullptr)
 			{
 				VI_TRACE("[net] fd %i free ssl device", (int)fd);
+				if (SSL_is_init_finished(device))
+					SSL_shutdown(device);
 				SSL_free(device);
 				device = nullptr;
 			}
@@ -2956,7 +4845,8 @@ namespace vitex
 				}
 			}
 
-			closesocket(fd);
+			if (!multiplexer::get()->submit_close(this))
+				closesocket(fd);
 			VI_DEBUG("[net] sock fd %i closed", (int)fd);
 			fd = INVALID_SOCKET;
 
@@ -2970,20 +4860,27 @@ namespace vitex
 			VI_ASSERT(size > 0, "size should be set and greater than zero");
 			VI_MEASURE(core::timings::networking);
 			VI_TRACE("[net] fd %i sendfile %" PRId64 " off, %" PRId64 " bytes", (int)fd, offset, size);
+			auto flush = flush_staged();
+			if (!flush)
+				return flush.error();
+
 			off_t seek = (off_t)offset, length = (off_t)size;
+			uint64_t readiness = events.readiness.load(std::memory_order_acquire);
 #ifdef VI_OPENSSL
 			if (device != nullptr)
 			{
-				static bool is_unsupported = false;
-				if (is_unsupported)
+				if (!is_send_offloaded())
 					return std::make_error_condition(std::errc::not_supported);
 
 				ossl_ssize_t value = SSL_sendfile(device, VI_FILENO(stream), seek, length, 0);
 				if (value < 0)
 				{
 					auto condition = utils::get_last_error(device, (int)value);
-					is_unsupported = (condition == std::errc::protocol_error);
-					return is_unsupported ? std::make_error_condition(std::errc::not_supported) : condition;
+					if (condition == std::errc::protocol_error)
+						return std::make_error_condition(std::errc::not_supported);
+					else if (condition == std::errc::operation_would_block)
+						unlatch_readiness(events.readiness, readiness, READY_WRITE);
+					return condition;
 				}
 
 				size_t written = (size_t)value;
@@ -2994,7 +4891,12 @@ namespace vitex
 #ifdef VI_APPLE
 			int value = sendfile(VI_FILENO(stream), fd, seek, &length, nullptr, 0);
 			if (value < 0)
-				return utils::get_last_error(device, value);
+			{
+				auto condition = utils::get_last_error(device, value);
+				if (condition == std::errc::operation_would_block)
+					unlatch_readiness(events.readiness, readiness, READY_WRITE);
+				return condition;
+			}
 
 			size_t written = (size_t)length;
 			outcome += written;
@@ -3002,7 +4904,12 @@ namespace vitex
 #elif defined(VI_LINUX)
 			ssize_t value = sendfile(fd, VI_FILENO(stream), &seek, size);
 			if (value < 0)
-				return utils::get_last_error(device, (int)value);
+			{
+				auto condition = utils::get_last_error(device, (int)value);
+				if (condition == std::errc::operation_would_block)
+					unlatch_readiness(events.readiness, readiness, READY_WRITE);
+				return condition;
+			}
 
 			size_t written = (size_t)value;
 			outcome += written;
@@ -3010,6 +4917,7 @@ namespace vitex
 #else
 			(void)seek;
 			(void)length;
+			(void)readiness;
 			return std::make_error_condition(std::errc::not_supported);
 #endif
 		}
@@ -3077,12 +4985,30 @@ namespace vitex
 				return std::make_error_condition(std::errc::bad_file_descriptor);
 
 			VI_TRACE("[net] fd %i write %i bytes", (int)fd, (int)size);
+			if (!staged.empty() && !device)
+			{
+				socket_buffer next;
+				next.data = buffer;
+				next.size = size;
+				return write_vectored(&next, 1);
+			}
+
+			auto flush = flush_staged();
+			if (!flush)
+				return flush.error();
+
+			uint64_t readiness = events.readiness.load(std::memory_order_acquire);
 #ifdef VI_OPENSSL
 			if (device != nullptr)
 			{
 				int value = SSL_write(device, buffer, (int)size);
 				if (value <= 0)
-					return utils::get_last_error(device, value);
+				{
+					auto condition = utils::get_last_error(device, value);
+					if (condition == std::errc::operation_would_block)
+						unlatch_readiness(events.readiness, readiness, READY_WRITE);
+					return condition;
+				}
 
 				size_t written = (size_t)value;
 				outcome += written;
@@ -3093,7 +5019,12 @@ namespace vitex
 			if (value == 0)
 				return std::make_error_condition(std::errc::operation_would_block);
 			else if (value < 0)
-				return utils::get_last_error(device, value);
+			{
+				auto condition = utils::get_last_error(device, value);
+				if (condition == std::errc::operation_would_block)
+					unlatch_readiness(events.readiness, readiness, READY_WRITE);
+				return condition;
+			}
 
 			size_t written = (size_t)value;
 			outcome += written;
@@ -3151,22 +5082,270 @@ namespace vitex
 						callback(socket_poll::reset);
 					}
 
-					return status;
+					return status;
+				}
+				else
+				{
+					size_t written_size = *status;
+					size -= written_size;
+					temp_offset += written_size;
+					written += written_size;
+				}
+			}
+
+			if (copy_buffer_when_async && temp_buffer != nullptr)
+				core::memory::deallocate(temp_buffer);
+
+			callback(temp_buffer ? socket_poll::finish : socket_poll::finish_sync);
+			return written;
+		}
+		core::expects_io<size_t> socket::write_vectored(const socket_buffer* buffers, size_t count, bool more)
+		{
+			VI_ASSERT(buffers != nullptr && count > 0, "buffers should be set");
+			VI_MEASURE(core::timings::networking);
+			if (fd == INVALID_SOCKET)
+				return std::make_error_condition(std::errc::bad_file_descriptor);
+
+			VI_TRACE("[net] fd %i write %i buffers", (int)fd, (int)count);
+#ifdef VI_OPENSSL
+			if (device != nullptr)
+			{
+				auto flush = flush_staged();
+				if (!flush)
+					return flush.error();
+
+				if (count == 1 || buffers->size >= MAX_WRITE_RECORD)
+					return write(buffers->data, buffers->size);
+
+				thread_local uint8_t record[MAX_WRITE_RECORD];
+				size_t size = 0;
+				for (size_t i = 0; i < count && size < sizeof(record); i++)
+				{
+					size_t chunk = std::min(buffers[i].size, sizeof(record) - size);
+					memcpy(record + size, buffers[i].data, chunk);
+					size += chunk;
+				}
+				return write(record, size);
+			}
+#endif
+			uint64_t readiness = events.readiness.load(std::memory_order_acquire);
+			size_t staging = staged.size(), base = staging > 0 ? 1 : 0;
+			size_t size = std::min<size_t>(count, MAX_WRITE_VECTORS - base);
+#ifdef VI_MICROSOFT
+			WSABUF vectors[MAX_WRITE_VECTORS];
+			if (base > 0)
+			{
+				vectors[0].buf = (CHAR*)staged.data();
+				vectors[0].len = (ULONG)staging;
+			}
+
+			for (size_t i = 0; i < size; i++)
+			{
+				vectors[base + i].buf = (CHAR*)buffers[i].data;
+				vectors[base + i].len = (ULONG)buffers[i].size;
+			}
+
+			DWORD sent = 0;
+			int value = WSASend(fd, vectors, (DWORD)(base + size), &sent, 0, nullptr, nullptr) == 0 ? (int)sent : SOCKET_ERROR;
+#else
+			iovec vectors[MAX_WRITE_VECTORS];
+			if (base > 0)
+			{
+				vectors[0].iov_base = (void*)staged.data();
+				vectors[0].iov_len = staging;
+			}
+
+			for (size_t i = 0; i < size; i++)
+			{
+				vectors[base + i].iov_base = (void*)buffers[i].data;
+				vectors[base + i].iov_len = buffers[i].size;
+			}
+
+			msghdr message;
+			memset(&message, 0, sizeof(message));
+			message.msg_iov = vectors;
+			message.msg_iovlen = base + size;
+#ifdef MSG_MORE
+			int value = (int)sendmsg(fd, &message, more ? MSG_MORE : 0);
+#else
+			int value = (int)sendmsg(fd, &message, 0);
+#endif
+#endif
+			if (value == 0)
+				return std::make_error_condition(std::errc::operation_would_block);
+			else if (value < 0)
+			{
+				auto condition = utils::get_last_error(device, value);
+				if (condition == std::errc::operation_would_block)
+					unlatch_readiness(events.readiness, readiness, READY_WRITE);
+				return condition;
+			}
+
+			size_t written = (size_t)value;
+			if (staging > 0)
+			{
+				size_t flushed = std::min(written, staging);
+				staged.erase(0, flushed);
+				written -= flushed;
+			}
+
+			outcome += written;
+			return written;
+		}
+		core::expects_io<size_t> socket::write_vectored_queued(const socket_buffer* buffers, size_t count, socket_written_callback&& callback, bool more)
+		{
+			VI_ASSERT(buffers != nullptr && count > 0, "buffers should be set");
+			VI_ASSERT(callback != nullptr, "callback should be set");
+			if (fd == INVALID_SOCKET)
+			{
+				callback(socket_poll::reset);
+				return std::make_error_condition(std::errc::bad_file_descriptor);
+			}
+
+			size_t size = 0;
+			for (size_t i = 0; i < count; i++)
+				size += buffers[i].size;
+
+			while (count > 0 && !buffers->size)
+			{
+				++buffers;
+				--count;
+			}
+
+			if (!count)
+			{
+				callback(socket_poll::finish_sync);
+				return size;
+			}
+
+			auto status = write_vectored(buffers, count, more);
+			if (status && *status == size)
+			{
+				callback(socket_poll::finish_sync);
+				return size;
+			}
+			else if (!status && status.error() != std::errc::operation_would_block)
+			{
+				callback(socket_poll::reset);
+				return status;
+			}
+
+			core::vector<socket_buffer> queue(buffers, buffers + count);
+			return write_vectored_pending(std::move(queue), std::move(callback), status ? *status : 0, more, false);
+		}
+		core::expects_io<size_t> socket::write_vectored_pending(core::vector<socket_buffer>&& queue, socket_written_callback&& callback, size_t written, bool more, bool async)
+		{
+			size_t offset = 0, total = written;
+			while (true)
+			{
+				while (offset < queue.size() && (written > 0 || !queue[offset].size))
+				{
+					auto& next = queue[offset];
+					size_t chunk = std::min(written, next.size);
+					next.data += chunk;
+					next.size -= chunk;
+					written -= chunk;
+					if (!next.size)
+						++offset;
+				}
+
+				if (offset >= queue.size())
+				{
+					callback(async ? socket_poll::finish : socket_poll::finish_sync);
+					return total;
+				}
+
+				auto status = write_vectored(queue.data() + offset, queue.size() - offset, more);
+				if (status)
+				{
+					written = *status;
+					total += written;
+					continue;
+				}
+
+				if (status.error() == std::errc::operation_would_block)
+				{
+					queue.erase(queue.begin(), queue.begin() + offset);
+					multiplexer::get()->when_writeable(this, [this, more, queue = std::move(queue), callback = std::move(callback)](socket_poll event) mutable
+					{
+						if (!packet::is_done(event))
+							callback(event);
+						else
+							write_vectored_pending(std::move(queue), std::move(callback), 0, more, true);
+					});
 				}
 				else
+					callback(socket_poll::reset);
+
+				return status;
+			}
+		}
+		core::expects_io<size_t> socket::write_staged(const socket_buffer* buffers, size_t count)
+		{
+			VI_ASSERT(buffers != nullptr && count > 0, "buffers should be set");
+			if (fd == INVALID_SOCKET)
+				return std::make_error_condition(std::errc::bad_file_descriptor);
+
+			size_t size = 0;
+			for (size_t i = 0; i < count; i++)
+				size += buffers[i].size;
+
+			VI_TRACE("[net] fd %i stage %i bytes", (int)fd, (int)size);
+			staged.reserve(staged.size() + size);
+			for (size_t i = 0; i < count; i++)
+				staged.append((char*)buffers[i].data, buffers[i].size);
+
+			outcome += size;
+			return size;
+		}
+		core::expects_io<void> socket::flush_staged()
+		{
+			while (!staged.empty() && fd != INVALID_SOCKET)
+			{
+				VI_TRACE("[net] fd %i flush %i staged bytes", (int)fd, (int)staged.size());
+				uint64_t readiness = events.readiness.load(std::memory_order_acquire);
+#ifdef VI_OPENSSL
+				int value = device != nullptr ? SSL_write(device, staged.data(), (int)staged.size()) : (int)send(fd, staged.data(), (int)staged.size(), 0);
+				if (value <= 0 && device != nullptr)
 				{
-					size_t written_size = *status;
-					size -= written_size;
-					temp_offset += written_size;
-					written += written_size;
+					auto condition = utils::get_last_error(device, value);
+					if (condition == std::errc::operation_would_block)
+						unlatch_readiness(events.readiness, readiness, READY_WRITE);
+					return condition;
+				}
+#else
+				int value = (int)send(fd, staged.data(), (int)staged.size(), 0);
+#endif
+				if (value == 0)
+					return std::make_error_condition(std::errc::operation_would_block);
+				else if (value < 0)
+				{
+					auto condition = utils::get_last_error(device, value);
+					if (condition == std::errc::operation_would_block)
+						unlatch_readiness(events.readiness, readiness, READY_WRITE);
+					return condition;
 				}
+
+				staged.erase(0, (size_t)value);
 			}
 
-			if (copy_buffer_when_async && temp_buffer != nullptr)
-				core::memory::deallocate(temp_buffer);
+			return core::expectation::met;
+		}
+		core::expects_io<void> socket::flush_staged_queued()
+		{
+			auto status = flush_staged();
+			if (status || staged.empty() || status.error() != std::errc::operation_would_block)
+				return status;
 
-			callback(temp_buffer ? socket_poll::finish : socket_poll::finish_sync);
-			return written;
+			if (!is_awaiting_writeable())
+			{
+				multiplexer::get()->when_writeable(this, [this](socket_poll event)
+				{
+					if (packet::is_done(event))
+						flush_staged_queued();
+				});
+			}
+			return status;
 		}
 		core::expects_promise_io<size_t> socket::write_deferred(const uint8_t* buffer, size_t size, bool copy_buffer_when_async)
 		{
@@ -3187,13 +5366,28 @@ namespace vitex
 			if (fd == INVALID_SOCKET)
 				return std::make_error_condition(std::errc::bad_file_descriptor);
 
+			if (pending.size > 0)
+			{
+				size_t received = std::min(size, pending.size);
+				memcpy(buffer, pending.data + pending.offset, received);
+				pending.offset += received;
+				pending.size -= received;
+				return received;
+			}
+
 			VI_TRACE("[net] fd %i read %i bytes", (int)fd, (int)size);
+			uint64_t readiness = events.readiness.load(std::memory_order_acquire);
 #ifdef VI_OPENSSL
 			if (device != nullptr)
 			{
 				int value = SSL_read(device, buffer, (int)size);
 				if (value <= 0)
-					return utils::get_last_error(device, value);
+				{
+					auto condition = utils::get_last_error(device, value);
+					if (condition == std::errc::operation_would_block)
+						unlatch_readiness(events.readiness, readiness, READY_READ);
+					return condition;
+				}
 
 				size_t received = (size_t)value;
 				income += received;
@@ -3204,7 +5398,12 @@ namespace vitex
 			if (value == 0)
 				return std::make_error_condition(std::errc::connection_reset);
 			else if (value < 0)
-				return utils::get_last_error(device, value);
+			{
+				auto condition = utils::get_last_error(device, value);
+				if (condition == std::errc::operation_would_block)
+					unlatch_readiness(events.readiness, readiness, READY_READ);
+				return condition;
+			}
 
 			size_t received = (size_t)value;
 			income += received;
@@ -3291,47 +5490,18 @@ namespace vitex
 				return std::make_error_condition(std::errc::bad_file_descriptor);
 			}
 
-			uint8_t buffer[MAX_READ_UNTIL];
-			size_t size = match.size(), cache = 0, receiving = 0, index = 0;
-			auto notify_incoming = [&callback, &buffer, &cache, &receiving]()
-			{
-				if (!cache)
-					return true;
-
-				size_t size = cache;
-				cache = 0; receiving += size;
-				return callback(socket_poll::next, buffer, size);
-			};
-
-			VI_ASSERT(size > 0, "match should not be empty");
-			while (index < size)
+			size_t index = 0;
+			auto status = read_until_buffered(match, callback, index);
+			if (!status)
 			{
-				auto status = read(buffer + cache, 1);
-				if (!status)
-				{
-					if (notify_incoming())
-						callback(socket_poll::reset, nullptr, 0);
-					return status;
-				}
-
-				size_t offset = cache;
-				if (++cache >= sizeof(buffer) && !notify_incoming())
-					break;
-
-				if (match[index] == buffer[offset])
-				{
-					if (++index >= size)
-					{
-						if (notify_incoming())
-							callback(socket_poll::finish_sync, nullptr, 0);
-						break;
-					}
-				}
-				else
-					index = 0;
+				callback(socket_poll::reset, nullptr, 0);
+				return status;
 			}
 
-			return receiving;
+			if (index >= match.size())
+				callback(socket_poll::finish_sync, nullptr, 0);
+
+			return status;
 		}
 		core::expects_io<size_t> socket::read_until_queued(core::string&& match, socket_read_callback&& callback, size_t temp_index, bool temp_buffer)
 		{
@@ -3344,58 +5514,29 @@ namespace vitex
 				return std::make_error_condition(std::errc::bad_file_descriptor);
 			}
 
-			uint8_t buffer[MAX_READ_UNTIL];
-			size_t size = match.size(), cache = 0, receiving = 0;
-			auto notify_incoming = [&callback, &buffer, &cache, &receiving]()
-			{
-				if (!cache)
-					return true;
-
-				size_t size = cache;
-				cache = 0; receiving += size;
-				return callback(socket_poll::next, buffer, size);
-			};
-
-			VI_ASSERT(size > 0, "match should not be empty");
-			while (temp_index < size)
+			auto status = read_until_buffered(match, callback, temp_index);
+			if (!status)
 			{
-				auto status = read(buffer + cache, 1);
-				if (!status)
-				{
-					if (status.error() == std::errc::operation_would_block)
-					{
-						multiplexer::get()->when_readable(this, [this, temp_index, match = std::move(match), callback = std::move(callback)](socket_poll event) mutable
-						{
-							if (packet::is_done(event))
-								read_until_queued(std::move(match), std::move(callback), temp_index, true);
-							else
-								callback(event, nullptr, 0);
-						});
-					}
-					else if (notify_incoming())
-						callback(socket_poll::reset, nullptr, 0);
-
-					return status;
-				}
-
-				size_t offset = cache++;
-				if (cache >= sizeof(buffer) && !notify_incoming())
-					break;
-
-				if (match[temp_index] == buffer[offset])
+				if (status.error() == std::errc::operation_would_block)
 				{
-					if (++temp_index >= size)
+					multiplexer::get()->when_readable(this, [this, temp_index, match = std::move(match), callback = std::move(callback)](socket_poll event) mutable
 					{
-						if (notify_incoming())
-							callback(temp_buffer ? socket_poll::finish : socket_poll::finish_sync, nullptr, 0);
-						break;
-					}
+						if (packet::is_done(event))
+							read_until_queued(std::move(match), std::move(callback), temp_index, true);
+						else
+							callback(event, nullptr, 0);
+					});
 				}
 				else
-					temp_index = 0;
+					callback(socket_poll::reset, nullptr, 0);
+
+				return status;
 			}
 
-			return receiving;
+			if (temp_index >= match.size())
+				callback(temp_buffer ? socket_poll::finish : socket_poll::finish_sync, nullptr, 0);
+
+			return status;
 		}
 		core::expects_promise_io<core::string> socket::read_until_deferred(core::string&& match, size_t max_size)
 		{
@@ -3438,52 +5579,18 @@ namespace vitex
 				return std::make_error_condition(std::errc::bad_file_descriptor);
 			}
 
-			uint8_t buffer[MAX_READ_UNTIL];
-			size_t size = match.size(), cache = 0, receiving = 0, index = 0;
-			auto notify_incoming = [&callback, &buffer, &cache, &receiving]()
-			{
-				if (!cache)
-					return true;
-
-				size_t size = cache;
-				cache = 0; receiving += size;
-				return callback(socket_poll::next, buffer, size);
-			};
-
-			VI_ASSERT(size > 0, "match should not be empty");
-			while (index < size)
+			size_t index = 0;
+			auto status = read_until_buffered(match, callback, index);
+			if (!status)
 			{
-				auto status = read(buffer + cache, sizeof(buffer) - cache);
-				if (!status)
-				{
-					if (notify_incoming())
-						callback(socket_poll::reset, nullptr, 0);
-					return status;
-				}
-
-				size_t length = *status;
-				size_t remaining = length;
-				while (remaining-- > 0)
-				{
-					size_t offset = cache;
-					if (++cache >= length && !notify_incoming())
-						break;
-
-					if (match[index] == buffer[offset])
-					{
-						if (++index >= size)
-						{
-							if (notify_incoming())
-								callback(socket_poll::finish_sync, nullptr, 0);
-							break;
-						}
-					}
-					else
-						index = 0;
-				}
+				callback(socket_poll::reset, nullptr, 0);
+				return status;
 			}
 
-			return receiving;
+			if (index >= match.size())
+				callback(socket_poll::finish_sync, nullptr, 0);
+
+			return status;
 		}
 		core::expects_io<size_t> socket::read_until_chunked_queued(core::string&& match, socket_read_callback&& callback, size_t temp_index, bool temp_buffer)
 		{
@@ -3496,66 +5603,34 @@ namespace vitex
 				return std::make_error_condition(std::errc::bad_file_descriptor);
 			}
 
-			uint8_t buffer[MAX_READ_UNTIL];
-			size_t size = match.size(), cache = 0, receiving = 0, remaining = 0;
-			auto notify_incoming = [&callback, &buffer, &cache, &receiving]()
-			{
-				if (!cache)
-					return true;
-
-				size_t size = cache;
-				cache = 0; receiving += size;
-				return callback(socket_poll::next, buffer, size);
-			};
-
-			VI_ASSERT(size > 0, "match should not be empty");
-			while (temp_index < size)
+			auto status = read_until_buffered(match, callback, temp_index);
+			if (!status)
 			{
-				auto status = read(buffer + cache, sizeof(buffer) - cache);
-				if (!status)
+				if (status.error() == std::errc::operation_would_block)
 				{
-					if (status.error() == std::errc::operation_would_block)
+					multiplexer::get()->when_readable(this, [this, temp_index, match = std::move(match), callback = std::move(callback)](socket_poll event) mutable
 					{
-						multiplexer::get()->when_readable(this, [this, temp_index, match = std::move(match), callback = std::move(callback)](socket_poll event) mutable
-						{
-							if (packet::is_done(event))
-								read_until_chunked_queued(std::move(match), std::move(callback), temp_index, true);
-							else
-								callback(event, nullptr, 0);
-						});
-					}
-					else if (notify_incoming())
-						callback(socket_poll::reset, nullptr, 0);
-
-					return status;
+						if (packet::is_done(event))
+							read_until_chunked_queued(std::move(match), std::move(callback), temp_index, true);
+						else
+							callback(event, nullptr, 0);
+					});
 				}
+				else
+					callback(socket_poll::reset, nullptr, 0);
 
-				size_t length = *status;
-				remaining = length;
-				while (remaining-- > 0)
-				{
-					size_t offset = cache;
-					if (++cache >= length && !notify_incoming())
-						break;
+				return status;
+			}
 
-					if (match[temp_index] == buffer[offset])
-					{
-						if (++temp_index >= size)
-						{
-							if (notify_incoming())
-							{
-								cache = ++offset;
-								callback(temp_buffer ? socket_poll::finish : socket_poll::finish_sync, remaining > 0 ? buffer + cache : nullptr, remaining);
-							}
-							break;
-						}
-					}
-					else
-						temp_index = 0;
-				}
+			if (temp_index >= match.size())
+			{
+				uint8_t* leftover = pending.size > 0 ? pending.data + pending.offset : nullptr;
+				size_t remaining = pending.size;
+				pending.offset = pending.size = 0;
+				callback(temp_buffer ? socket_poll::finish : socket_poll::finish_sync, leftover, remaining);
 			}
 
-			return receiving;
+			return status;
 		}
 		core::expects_promise_io<core::string> socket::read_until_chunked_deferred(core::string&& match, size_t max_size)
 		{
@@ -3710,12 +5785,64 @@ namespace vitex
 
 			return core::expectation::met;
 		}
+		core::expects_io<size_t> socket::read_until_buffered(const std::string_view& match, socket_read_callback& callback, size_t& temp_index)
+		{
+			size_t receiving = 0;
+			while (temp_index < match.size())
+			{
+				if (!pending.size)
+				{
+					if (!pending.data)
+						pending.data = core::memory::allocate<uint8_t>(MAX_READ_UNTIL);
+
+					auto status = read(pending.data, MAX_READ_UNTIL);
+					if (!status)
+						return status;
+
+					pending.offset = 0;
+					pending.size = *status;
+				}
+
+				uint8_t* buffer = pending.data + pending.offset;
+				size_t size = find_delimiter(buffer, pending.size, match, temp_index);
+				pending.offset += size;
+				pending.size -= size;
+				receiving += size;
+				if (!callback(socket_poll::next, buffer, size))
+					break;
+			}
+
+			return receiving;
+		}
+		core::expects_io<void> socket::unread(const uint8_t* buffer, size_t size)
+		{
+			VI_ASSERT(buffer != nullptr || !size, "buffer should be set");
+			if (!size)
+				return core::expectation::met;
+			else if (pending.size + size > MAX_READ_UNTIL)
+				return std::make_error_condition(std::errc::no_buffer_space);
+
+			if (!pending.data)
+				pending.data = core::memory::allocate<uint8_t>(MAX_READ_UNTIL);
+
+			VI_TRACE("[net] fd %i unread %i bytes", (int)fd, (int)size);
+			if (pending.size > 0)
+				memmove(pending.data + size, pending.data + pending.offset, pending.size);
+			memmove(pending.data, buffer, size);
+			pending.offset = 0;
+			pending.size += size;
+			return core::expectation::met;
+		}
 		core::expects_io<void> socket::migrate_to(socket_t new_fd, bool gracefully)
 		{
 			VI_MEASURE(core::timings::networking);
 			VI_TRACE("[net] migrate fd %i to fd %i", (int)fd, (int)new_fd);
+			clear_pending();
+			staged.clear();
 			if (!gracefully)
 			{
+				events.watching = false;
+				events.readiness = 0;
 				fd = new_fd;
 				return core::expectation::met;
 			}
@@ -3724,6 +5851,11 @@ namespace vitex
 			fd = new_fd;
 			return status;
 		}
+		void socket::clear_pending()
+		{
+			pending.offset = 0;
+			pending.size = 0;
+		}
 		core::expects_io<void> socket::set_close_on_exec()
 		{
 			VI_TRACE("[net] fd %i setopt: cloexec", (int)fd);
@@ -3785,6 +5917,14 @@ namespace vitex
 		{
 			return set_socket_flag(SO_KEEPALIVE, (enabled ? 1 : 0));
 		}
+		core::expects_io<void> socket::set_reuse_port(bool enabled)
+		{
+#ifdef SO_REUSEPORT
+			return set_socket_flag(SO_REUSEPORT, (enabled ? 1 : 0));
+#else
+			return std::make_error_condition(std::errc::not_supported);
+#endif
+		}
 		core::expects_io<void> socket::set_timeout(int timeout)
 		{
 			VI_TRACE("[net] fd %i setopt: rwtimeout %i", (int)fd, timeout);
@@ -3872,10 +6012,48 @@ namespace vitex
 		{
 			return device;
 		}
+		std::string_view socket::get_pending() const
+		{
+			return pending.size > 0 ? std::string_view((char*)pending.data + pending.offset, pending.size) : std::string_view();
+		}
+		std::string_view socket::get_application_protocol() const
+		{
+#ifdef VI_OPENSSL
+			if (!device)
+				return std::string_view();
+
+			const uint8_t* name = nullptr;
+			uint32_t size = 0;
+			SSL_get0_alpn_selected(device, &name, &size);
+			return name != nullptr ? std::string_view((char*)name, size) : std::string_view();
+#else
+			return std::string_view();
+#endif
+		}
+		size_t socket::get_staged_size() const
+		{
+			return staged.size();
+		}
 		bool socket::is_valid() const
 		{
 			return fd != INVALID_SOCKET;
 		}
+		bool socket::is_reusable() const
+		{
+			if (fd == INVALID_SOCKET || pending.size > 0)
+				return false;
+#ifdef VI_OPENSSL
+			if (device != nullptr && SSL_pending(device) > 0)
+				return false;
+#endif
+			uint8_t buffer;
+#ifdef VI_MICROSOFT
+			int value = (int)recv(fd, (char*)&buffer, 1, MSG_PEEK);
+#else
+			int value = (int)recv(fd, (char*)&buffer, 1, MSG_PEEK | MSG_DONTWAIT);
+#endif
+			return value < 0 && utils::get_last_error(nullptr, value) == std::errc::operation_would_block;
+		}
 		bool socket::is_awaiting_events()
 		{
 			core::umutex<std::mutex> unique(events.mutex);
@@ -3895,6 +6073,22 @@ namespace vitex
 		{
 			return device != nullptr;
 		}
+		bool socket::is_send_offloaded() const
+		{
+#ifdef VI_OPENSSL
+			return device != nullptr && BIO_get_ktls_send(SSL_get_wbio(device));
+#else
+			return false;
+#endif
+		}
+		bool socket::is_receive_offloaded() const
+		{
+#ifdef VI_OPENSSL
+			return device != nullptr && BIO_get_ktls_recv(SSL_get_rbio(device));
+#else
+			return false;
+#endif
+		}
 
 		socket_listener::socket_listener(const std::string_view& new_name, const socket_address& new_address, bool secure) : name(new_name), address(new_address), stream(new socket()), is_secure(secure)
 		{
@@ -4042,24 +6236,36 @@ namespace vitex
 				return core::system_exception("configure server: invalid listeners", std::make_error_condition(std::errc::invalid_argument));
 			}
 
+			size_t shards = std::max<size_t>(1, router->accept_shards);
 			for (auto&& it : router->listeners)
 			{
-				socket_listener* host = new socket_listener(it.first, it.second.address, it.second.is_secure);
-				auto status = host->stream->open(host->address);
-				if (!status)
-					return core::system_exception(core::stringify::text("open %s listener error", get_address_identification(host->address).c_str()), std::move(status.error()));
+				for (size_t i = 0; i < shards; i++)
+				{
+					socket_listener* host = new socket_listener(it.first, it.second.address, it.second.is_secure);
+					listeners.push_back(host);
 
-				status = host->stream->bind(host->address);
-				if (!status)
-					return core::system_exception(core::stringify::text("bind %s listener error", get_address_identification(host->address).c_str()), std::move(status.error()));
+					auto status = host->stream->open(host->address);
+					if (!status)
+						return core::system_exception(core::stringify::text("open %s listener error", get_address_identification(host->address).c_str()), std::move(status.error()));
 
-				status = host->stream->listen((int)router->backlog_queue);
-				if (!status)
-					return core::system_exception(core::stringify::text("listen %s listener error", get_address_identification(host->address).c_str()), std::move(status.error()));
+					if (shards > 1)
+					{
+						status = host->stream->set_reuse_port(true);
+						if (!status)
+							return core::system_exception(core::stringify::text("reuse port %s listener error", get_address_identification(host->address).c_str()), std::move(status.error()));
+					}
+
+					status = host->stream->bind(host->address);
+					if (!status)
+						return core::system_exception(core::stringify::text("bind %s listener error", get_address_identification(host->address).c_str()), std::move(status.error()));
+
+					status = host->stream->listen((int)router->backlog_queue);
+					if (!status)
+						return core::system_exception(core::stringify::text("listen %s listener error", get_address_identification(host->address).c_str()), std::move(status.error()));
 
-				host->stream->set_close_on_exec();
-				host->stream->set_blocking(false);
-				listeners.push_back(host);
+					host->stream->set_close_on_exec();
+					host->stream->set_blocking(false);
+				}
 			}
 #ifdef VI_OPENSSL
 			for (auto&& it : router->certificates)
@@ -4069,6 +6275,10 @@ namespace vitex
 					return core::system_exception("create server transport layer error: " + it.first, std::move(context.error()));
 
 				it.second.context = *context;
+				auto sessions = transport_layer::get()->configure_server_sessions(it.second.context, it.second.session_cache_size, it.second.session_timeout, it.second.ticket_rotation);
+				if (!sessions)
+					return core::system_exception("configure server transport layer sessions error: " + it.first, std::move(sessions.error()));
+
 				if (it.second.verify_peers > 0)
 					SSL_CTX_set_verify(it.second.context, SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT | SSL_VERIFY_CLIENT_ONCE, nullptr);
 				else
@@ -4103,6 +6313,9 @@ namespace vitex
 
 				if (!SSL_CTX_check_private_key(it.second.context))
 					return core::system_exception(core::stringify::text("server transport layer private key %s verify error: %s", it.first.c_str(), ERR_error_string(ERR_get_error(), nullptr)), std::make_error_condition(std::errc::bad_message));
+
+				if (!router->protocols.empty())
+					SSL_CTX_set_alpn_select_cb(it.second.context, &tls_select_protocol, router);
 			}
 #endif
 			return core::expectation::met;
@@ -4208,7 +6421,10 @@ namespace vitex
 					else if (incoming.fd == INVALID_SOCKET)
 						return false;
 
-					core::cospawn([this, source, incoming]() mutable { accept(source, std::move(incoming)); });
+					if (multiplexer::get()->is_sharded())
+						accept(source, std::move(incoming));
+					else
+						core::cospawn([this, source, incoming]() mutable { accept(source, std::move(incoming)); });
 					return true;
 				});
 			}
@@ -4231,10 +6447,9 @@ namespace vitex
 			base->address = std::move(incoming.address);
 			base->stream->set_io_timeout(router->socket_timeout);
 			base->stream->migrate_to(incoming.fd, false);
-			base->stream->set_close_on_exec();
+			base->stream->events.shard = host->stream->events.shard;
 			base->stream->set_no_delay(router->enable_no_delay);
 			base->stream->set_keep_alive(true);
-			base->stream->set_blocking(false);
 
 			if (router->graceful_time_wait >= 0)
 				base->stream->set_time_wait((int)router->graceful_time_wait);
@@ -4295,6 +6510,8 @@ namespace vitex
 			int error_code = SSL_accept(base->stream->get_device());
 			if (error_code != -1)
 			{
+				transport_layer::get()->report_handshake(base->stream->get_device());
+				VI_DEBUG("[net] fd %i secured (ktls send: %s, receive: %s)", (int)base->stream->get_fd(), base->stream->is_send_offloaded() ? "on" : "off", base->stream->is_receive_offloaded() ? "on" : "off");
 				on_request_open(base);
 				return core::expectation::met;
 			}
@@ -26,6 +26,8 @@ namespace vitex
 
 		class socket_connection;
 
+		class socket_server;
+
 		enum
 		{
 			ADDRESS_SIZE = 64,
@@ -42,7 +44,8 @@ namespace vitex
 			no_tlsv1 = 1 << 3,
 			no_tlsv11 = 1 << 4,
 			no_tlsv12 = 1 << 5,
-			no_tlsv13 = 1 << 6
+			no_tlsv13 = 1 << 6,
+			ktls = 1 << 7
 		};
 
 		enum class server_state
@@ -170,9 +173,23 @@ namespace vitex
 			core::string ciphers = "ALL";
 			ssl_ctx_st* context = nullptr;
 			secure_layer_options options = secure_layer_options::all;
+			size_t session_cache_size = 20480;
+			uint64_t session_timeout = 300;
+			uint64_t ticket_rotation = 3600;
 			uint32_t verify_peers = 100;
 		};
 
+		struct transport_statistics
+		{
+			uint64_t handshakes = 0;
+			uint64_t resumptions = 0;
+			uint64_t cache_hits = 0;
+			uint64_t cache_misses = 0;
+			uint64_t cache_evictions = 0;
+			uint64_t ticket_rotations = 0;
+			size_t cached_sessions = 0;
+		};
+
 		struct socket_cidr
 		{
 			compute::uint128 min_value;
@@ -235,6 +252,12 @@ namespace vitex
 			socket_t fd = 0;
 		};
 
+		struct socket_buffer
+		{
+			const uint8_t* data = nullptr;
+			size_t size = 0;
+		};
+
 		struct router_listener
 		{
 			socket_address address;
@@ -265,7 +288,10 @@ namespace vitex
 			bool add(socket* fd, bool readable, bool writeable) noexcept;
 			bool update(socket* fd, bool readable, bool writeable) noexcept;
 			bool remove(socket* fd) noexcept;
+			bool watch(socket* fd) noexcept;
+			bool close(socket_t fd) noexcept;
 			int wait(epoll_fd* data, size_t data_size, uint64_t timeout) noexcept;
+			bool flush() noexcept;
 			size_t capacity() noexcept;
 		};
 
@@ -355,6 +381,7 @@ namespace vitex
 			static int poll(poll_fd* fd, int fd_count, int timeout) noexcept;
 			static std::error_condition get_last_error(ssl_st* device, int error_code) noexcept;
 			static core::option<socket_cidr> parse_address_mask(const std::string_view& mask) noexcept;
+			static core::expects_io<void> create_socket_pair(socket_t pair[2]) noexcept;
 			static bool is_invalid(socket_t fd) noexcept;
 			static int64_t clock() noexcept;
 			static void display_transport_log() noexcept;
@@ -373,6 +400,9 @@ namespace vitex
 			virtual ~transport_layer() noexcept override;
 			core::expects_io<ssl_ctx_st*> create_server_context(size_t verify_depth, secure_layer_options options, const std::string_view& ciphers_list) noexcept;
 			core::expects_io<ssl_ctx_st*> create_client_context(size_t verify_depth) noexcept;
+			core::expects_io<void> configure_server_sessions(ssl_ctx_st* context, size_t cache_size, uint64_t timeout, uint64_t ticket_rotation) noexcept;
+			void report_handshake(ssl_st* device) noexcept;
+			transport_statistics get_statistics() noexcept;
 			void free_server_context(ssl_ctx_st* context) noexcept;
 			void free_client_context(ssl_ctx_st* context) noexcept;
 
@@ -382,9 +412,19 @@ namespace vitex
 
 		class dns final : public core::singleton<dns>
 		{
+		private:
+			struct entry
+			{
+				socket_address address;
+				int64_t expires = 0;
+				bool negative = false;
+			};
+
 		private:
 			std::mutex exclusive;
-			core::unordered_map<size_t, std::pair<int64_t, socket_address>> names;
+			core::unordered_map<size_t, entry> names;
+			core::unordered_set<core::string> hosts;
+			core::vector<socket_address> nameservers;
 
 		public:
 			dns() noexcept;
@@ -395,24 +435,51 @@ namespace vitex
 			core::expects_promise_system<core::string> reverse_address_lookup_deferred(const socket_address& address);
 			core::expects_system<socket_address> lookup(const std::string_view& hostname, const std::string_view& service, dns_type resolver, socket_protocol proto = socket_protocol::TCP, socket_type type = socket_type::stream);
 			core::expects_promise_system<socket_address> lookup_deferred(const std::string_view& hostname, const std::string_view& service, dns_type resolver, socket_protocol proto = socket_protocol::TCP, socket_type type = socket_type::stream);
+			void set_nameservers(core::vector<socket_address>&& addresses);
+			core::vector<socket_address> get_nameservers();
+			void clear_cache();
+
+		private:
+			core::option<core::expects_system<socket_address>> get_cache(size_t hash, const std::string_view& hostname, const std::string_view& service);
+			socket_address set_cache(size_t hash, const socket_address& address, int64_t ttl);
+			void set_negative_cache(size_t hash, int64_t ttl);
+			bool is_resolvable_deferred(const std::string_view& hostname, const std::string_view& service);
+			void load_system_config();
 		};
 
 		class multiplexer final : public core::singleton<multiplexer>
 		{
 		private:
-			std::mutex exclusive;
-			core::unordered_set<socket*> trackers;
-			core::vector<epoll_fd> fds;
-			core::ordered_map<std::chrono::microseconds, socket*> timers;
-			epoll_interface handle;
+			struct shard
+			{
+				std::mutex exclusive;
+				core::unordered_set<socket*> trackers;
+				core::vector<epoll_fd> fds;
+				core::vector<core::task_callback> posted;
+				core::ordered_map<std::chrono::microseconds, socket*> timers;
+				epoll_interface handle;
+				std::atomic<std::thread::id> owner;
+				std::atomic<bool> signaled;
+				socket* notifier;
+				socket_t signal;
+				bool watched;
+				std::thread worker;
+
+				shard(size_t max_events, bool notifiable) noexcept;
+				~shard() noexcept;
+			};
+
+		private:
+			core::vector<shard*> shards;
 			std::atomic<size_t> activations;
+			std::atomic<size_t> cursor;
 			uint64_t default_timeout;
 
 		public:
 			multiplexer() noexcept;
-			multiplexer(uint64_t dispatch_timeout, size_t max_events) noexcept;
+			multiplexer(uint64_t dispatch_timeout, size_t max_events, size_t max_shards = 1) noexcept;
 			virtual ~multiplexer() noexcept override;
-			void rescale(uint64_t dispatch_timeout, size_t max_events) noexcept;
+			void rescale(uint64_t dispatch_timeout, size_t max_events, size_t max_shards = 1) noexcept;
 			void activate() noexcept;
 			void deactivate() noexcept;
 			void shutdown() noexcept;
@@ -421,19 +488,38 @@ namespace vitex
 			bool when_writeable(socket* value, poll_event_callback&& when_ready) noexcept;
 			bool cancel_events(socket* value, socket_poll event = socket_poll::cancel) noexcept;
 			bool clear_events(socket* value) noexcept;
+			bool submit_close(socket* value) noexcept;
 			bool is_listening() noexcept;
+			bool is_sharded() const noexcept;
 			size_t get_activations() noexcept;
+			size_t get_shards() const noexcept;
 
 		private:
-			void dispatch_timers(const std::chrono::microseconds& time) noexcept;
-			bool dispatch_events(const epoll_fd& fd, const std::chrono::microseconds& time) noexcept;
+			int dispatch_shard(shard* target, uint64_t timeout) noexcept;
+			void dispatch_timers(shard* target, const std::chrono::microseconds& time) noexcept;
+			bool dispatch_events(shard* target, const epoll_fd& fd, const std::chrono::microseconds& time) noexcept;
+			void dispatch_callback(core::task_callback&& callback) noexcept;
+			void dispatch_notifier(shard* target) noexcept;
+			bool dispatch_posted(shard* target) noexcept;
+			void post_callback(shard* target, core::task_callback&& callback) noexcept;
 			void try_dispatch() noexcept;
+			void try_dispatch_shard(shard* target) noexcept;
 			void try_enqueue() noexcept;
 			void try_listen() noexcept;
 			void try_unlisten() noexcept;
-			void add_timeout(socket* value, const std::chrono::microseconds& time) noexcept;
-			void update_timeout(socket* value, const std::chrono::microseconds& time) noexcept;
-			void remove_timeout(socket* value) noexcept;
+			void try_join() noexcept;
+			void add_timeout(shard* target, socket* value, const std::chrono::microseconds& time) noexcept;
+			void update_timeout(shard* target, socket* value, const std::chrono::microseconds& time) noexcept;
+			void remove_timeout(shard* target, socket* value) noexcept;
+			shard* get_shard(socket* value) noexcept;
+		};
+
+		struct uplink_statistics
+		{
+			uint64_t hits = 0;
+			uint64_t misses = 0;
+			uint64_t evictions = 0;
+			size_t idle = 0;
 		};
 
 		class uplinks final : public core::singleton<uplinks>
@@ -442,30 +528,55 @@ namespace vitex
 			typedef std::function<void(socket*)> acquire_callback;
 
 		private:
+			struct idle_stream
+			{
+				socket* stream;
+				std::chrono::microseconds since;
+			};
+
 			struct connection_queue
 			{
 				core::single_queue<acquire_callback> requests;
-				core::unordered_set<socket*> streams;
+				core::linked_list<idle_stream> streams;
 				size_t duplicates = 0;
 			};
 
+			struct shard
+			{
+				std::recursive_mutex exclusive;
+				core::unordered_map<core::string, connection_queue> connections;
+			};
+
 		private:
-			std::recursive_mutex exclusive;
-			core::unordered_map<core::string, connection_queue> connections;
+			core::vector<shard*> shards;
+			std::atomic<uint64_t> hits;
+			std::atomic<uint64_t> misses;
+			std::atomic<uint64_t> evictions;
+			std::atomic<size_t> idle;
 			size_t max_duplicates;
+			size_t max_idle;
+			uint64_t idle_timeout;
 
 		public:
-			uplinks() noexcept;
+			uplinks(size_t max_shards = 16) noexcept;
 			virtual ~uplinks() noexcept override;
 			void set_max_duplicates(size_t max);
+			void set_max_idle(size_t max);
+			void set_idle_timeout(uint64_t timeout_ms);
 			bool push_connection(const socket_address& address, socket* target);
 			bool pop_connection_queued(const socket_address& address, acquire_callback&& callback);
 			core::promise<socket*> pop_connection(const socket_address& address);
+			uplink_statistics get_statistics() const;
 			size_t get_max_duplicates() const;
+			size_t get_max_idle() const;
+			uint64_t get_idle_timeout() const;
 			size_t get_size();
 
 		private:
 			void listen_connection(core::string&& id, socket* target);
+			void store_connection(core::string&& id, connection_queue& pool, socket* target, core::vector<socket*>& evicted);
+			void release_connections(core::vector<socket*>& evicted);
+			shard* get_shard(const std::string_view& id);
 		};
 
 		class certificate_builder final : public core::reference<certificate_builder>
@@ -498,6 +609,7 @@ namespace vitex
 		{
 			friend epoll_interface;
 			friend multiplexer;
+			friend socket_server;
 
 		private:
 			struct ievents
@@ -506,7 +618,10 @@ namespace vitex
 				poll_event_callback read_callback = nullptr;
 				poll_event_callback write_callback = nullptr;
 				std::chrono::microseconds expiration = std::chrono::microseconds(0);
+				std::atomic<uint64_t> readiness = 0;
 				uint64_t timeout = 0;
+				size_t shard = 0;
+				bool watching = false;
 
 				ievents() = default;
 				ievents(ievents&& other) noexcept;
@@ -514,6 +629,15 @@ namespace vitex
 				~ievents() = default;
 			} events;
 
+			struct ibuffer
+			{
+				uint8_t* data = nullptr;
+				size_t offset = 0;
+				size_t size = 0;
+			} pending;
+
+			core::string staged;
+
 		private:
 			ssl_st* device;
 			socket_t fd;
@@ -543,6 +667,10 @@ namespace vitex
 			core::expects_io<size_t> write(const uint8_t* buffer, size_t size);
 			core::expects_io<size_t> write_queued(const uint8_t* buffer, size_t size, socket_written_callback&& callback, bool copy_buffer_when_async = true, uint8_t* temp_buffer = nullptr, size_t temp_offset = 0);
 			core::expects_promise_io<size_t> write_deferred(const uint8_t* buffer, size_t size, bool copy_buffer_when_async = true);
+			core::expects_io<size_t> write_vectored(const socket_buffer* buffers, size_t count, bool more = false);
+			core::expects_io<size_t> write_vectored_queued(const socket_buffer* buffers, size_t count, socket_written_callback&& callback, bool more = false);
+			core::expects_io<size_t> write_staged(const socket_buffer* buffers, size_t count);
+			core::expects_io<void> flush_staged_queued();
 			core::expects_io<size_t> read(uint8_t* buffer, size_t size);
 			core::expects_io<size_t> read_queued(size_t size, socket_read_callback&& callback, size_t temp_buffer = 0);
 			core::expects_promise_io<core::string> read_deferred(size_t size);
@@ -552,6 +680,7 @@ namespace vitex
 			core::expects_io<size_t> read_until_chunked(const std::string_view& match, socket_read_callback&& callback);
 			core::expects_io<size_t> read_until_chunked_queued(core::string&& match, socket_read_callback&& callback, size_t temp_index = 0, bool temp_buffer = false);
 			core::expects_promise_io<core::string> read_until_chunked_deferred(core::string&& match, size_t max_size);
+			core::expects_io<void> unread(const uint8_t* buffer, size_t size);
 			core::expects_io<void> connect(const socket_address& address, uint64_t timeout);
 			core::expects_io<void> connect_queued(const socket_address& address, socket_status_callback&& callback);
 			core::expects_promise_io<void> connect_deferred(const socket_address& address);
@@ -570,6 +699,7 @@ namespace vitex
 			core::expects_io<void> set_blocking(bool enabled);
 			core::expects_io<void> set_no_delay(bool enabled);
 			core::expects_io<void> set_keep_alive(bool enabled);
+			core::expects_io<void> set_reuse_port(bool enabled);
 			core::expects_io<void> set_timeout(int timeout);
 			core::expects_io<void> get_socket(int option, void* value, size_t* size);
 			core::expects_io<void> get_any(int level, int option, void* value, size_t* size);
@@ -581,14 +711,24 @@ namespace vitex
 			void set_io_timeout(uint64_t timeout_ms);
 			socket_t get_fd() const;
 			ssl_st* get_device() const;
+			std::string_view get_pending() const;
+			std::string_view get_application_protocol() const;
+			size_t get_staged_size() const;
 			bool is_awaiting_readable();
 			bool is_awaiting_writeable();
 			bool is_awaiting_events();
 			bool is_secure() const;
+			bool is_send_offloaded() const;
+			bool is_receive_offloaded() const;
 			bool is_valid() const;
+			bool is_reusable() const;
 
 		private:
 			core::expects_io<void> try_close_queued(socket_status_callback&& callback, const std::chrono::microseconds& time, bool keep_trying);
+			core::expects_io<size_t> read_until_buffered(const std::string_view& match, socket_read_callback& callback, size_t& temp_index);
+			core::expects_io<size_t> write_vectored_pending(core::vector<socket_buffer>&& queue, socket_written_callback&& callback, size_t written, bool more, bool async);
+			core::expects_io<void> flush_staged();
+			void clear_pending();
 		};
 
 		class socket_listener final : public core::reference<socket_listener>
@@ -609,9 +749,11 @@ namespace vitex
 		public:
 			core::unordered_map<core::string, socket_certificate> certificates;
 			core::unordered_map<core::string, router_listener> listeners;
+			core::vector<core::string> protocols;
 			size_t max_heap_buffer = 1024 * 1024 * 4;
 			size_t max_net_buffer = 1024 * 1024 * 32;
 			size_t backlog_queue = 20;
+			size_t accept_shards = 1;
 			size_t socket_timeout = 10000;
 			size_t max_connections = 0;
 			int64_t keep_alive_max_count = 0;
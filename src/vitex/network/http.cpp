@@ -20,6 +20,7 @@
 #endif
 #include <random>
 #include <string>
+#include <optional>
 extern "C"
 {
 #ifdef VI_ZLIB
@@ -44,7 +45,24 @@ extern "C"
 #define HTTP_WEBSOCKET_LEGACY_KEY_SIZE 8
 #define HTTP_MAX_REDIRECTS 128
 #define HTTP_HRM_SIZE 1024 * 1024 * 4
+#define HTTP_COMPRESSION_CACHE_SIZE 1024 * 1024 * 64
+#define HTTP_COMPRESSION_MEMORY_SIZE 1024 * 256
+#define HTTP_PIPELINE_COALESCE_SIZE 1024 * 64
 #define HTTP_KIMV_LOAD_FACTOR 48
+#define HTTP2_PREFACE "PRI * HTTP/2.0\r\n\r\n"
+#define HTTP2_FRAME_HEADER_SIZE 9
+#define HTTP2_STATIC_TABLE_SIZE 61
+#define HTTP2_DEFAULT_WINDOW_SIZE 65535
+#define HTTP2_MAX_WINDOW_SIZE 2147483647
+#define HTTP2_MIN_FRAME_SIZE 16384
+#define HTTP2_MAX_FRAME_SIZE 16777215
+#define HTTP2_CHANNEL_BUFFER_SIZE 1024 * 64
+#define HTTP2_SESSION_BUFFER_SIZE 1024 * 256
+#define HTTP2_FLAG_END_STREAM 0x1
+#define HTTP2_FLAG_ACK 0x1
+#define HTTP2_FLAG_END_HEADERS 0x4
+#define HTTP2_FLAG_PADDED 0x8
+#define HTTP2_FLAG_PRIORITY 0x20
 #define GZ_HEADER_SIZE 17
 #pragma warning(push)
 #pragma warning(disable: 4996)
@@ -63,6 +81,66 @@ namespace vitex
 				return !path.empty() && path.back() == '/';
 #endif
 			}
+			static int8_t route_literal(const compute::regex_source& source, core::string& literal)
+			{
+				const core::string& expression = source.get_regex();
+				if (expression.empty() || source.ignore_case || source.get_state() != compute::regex_state::preprocessed)
+					return -1;
+
+				const char* data = expression.c_str();
+				size_t size = expression.size(), depth = 0;
+				auto length = [data, size](size_t offset) -> size_t
+				{
+					if (data[offset] == '\\')
+						return offset + 1 < size && data[offset + 1] == 'x' ? 4 : 2;
+					else if (data[offset] != '[')
+						return 1;
+
+					size_t next = offset + 1;
+					while (next < size && data[next] != ']')
+						next += (data[next] == '\\' ? 2 : 1);
+					return next + 1 - offset;
+				};
+
+				for (size_t i = 0; i < size; i += length(i))
+				{
+					if (data[i] == '(')
+						++depth;
+					else if (data[i] == ')' && depth > 0)
+						--depth;
+					else if (data[i] == '|' && !depth)
+						return -1;
+				}
+
+				bool anchored = data[0] == '^';
+				literal.clear();
+				for (size_t i = anchored ? 1 : 0, step = 0; i < size; i += step)
+				{
+					char value = data[i];
+					step = length(i);
+					if (value == '\\')
+					{
+						if (step != 2 || i + 1 >= size || isalnum((uint8_t)data[i + 1]))
+							break;
+						value = data[i + 1];
+					}
+					else if (strchr("^$().[]*+?|", value) != nullptr)
+						break;
+
+					char next = (i + step < size ? data[i + step] : '\0');
+					if (next == '*' || next == '?')
+						break;
+
+					literal.push_back(value);
+					if (next == '+')
+						break;
+				}
+
+				if (anchored)
+					return 1;
+
+				return literal.empty() ? -1 : 0;
+			}
 			static bool connection_valid(connection* target)
 			{
 				return target && target->root && target->route && target->route->router;
@@ -91,6 +169,29 @@ namespace vitex
 
 				return it->second.back();
 			}
+			static const std::pair<std::string_view, std::string_view>* hpack_static_entry(size_t index)
+			{
+				static const std::pair<std::string_view, std::string_view> entries[HTTP2_STATIC_TABLE_SIZE] = { { ":authority", "" }, { ":method", "GET" }, { ":method", "POST" }, { ":path", "/" }, { ":path", "/index.html" }, { ":scheme", "http" }, { ":scheme", "https" }, { ":status", "200" }, { ":status", "204" }, { ":status", "206" }, { ":status", "304" }, { ":status", "400" }, { ":status", "404" }, { ":status", "500" }, { "accept-charset", "" }, { "accept-encoding", "gzip, deflate" }, { "accept-language", "" }, { "accept-ranges", "" }, { "accept", "" }, { "access-control-allow-origin", "" }, { "age", "" }, { "allow", "" }, { "authorization", "" }, { "cache-control", "" }, { "content-disposition", "" }, { "content-encoding", "" }, { "content-language", "" }, { "content-length", "" }, { "content-location", "" }, { "content-range", "" }, { "content-type", "" }, { "cookie", "" }, { "date", "" }, { "etag", "" }, { "expect", "" }, { "expires", "" }, { "from", "" }, { "host", "" }, { "if-match", "" }, { "if-modified-since", "" }, { "if-none-match", "" }, { "if-range", "" }, { "if-unmodified-since", "" }, { "last-modified", "" }, { "link", "" }, { "location", "" }, { "max-forwards", "" }, { "proxy-authenticate", "" }, { "proxy-authorization", "" }, { "range", "" }, { "referer", "" }, { "refresh", "" }, { "retry-after", "" }, { "server", "" }, { "set-cookie", "" }, { "strict-transport-security", "" }, { "transfer-encoding", "" }, { "user-agent", "" }, { "vary", "" }, { "via", "" }, { "www-authenticate", "" } };
+				return index > 0 && index <= HTTP2_STATIC_TABLE_SIZE ? &entries[index - 1] : nullptr;
+			}
+			static uint8_t hpack_huffman_code(uint8_t symbol, uint32_t* code)
+			{
+				static const uint32_t codes[256] = { 0x1ff8, 0x7fffd8, 0xfffffe2, 0xfffffe3, 0xfffffe4, 0xfffffe5, 0xfffffe6, 0xfffffe7, 0xfffffe8, 0xffffea, 0x3ffffffc, 0xfffffe9, 0xfffffea, 0x3ffffffd, 0xfffffeb, 0xfffffec, 0xfffffed, 0xfffffee, 0xfffffef, 0xffffff0, 0xffffff1, 0xffffff2, 0x3ffffffe, 0xffffff3, 0xffffff4, 0xffffff5, 0xffffff6, 0xffffff7, 0xffffff8, 0xffffff9, 0xffffffa, 0xffffffb, 0x14, 0x3f8, 0x3f9, 0xffa, 0x1ff9, 0x15, 0xf8, 0x7fa, 0x3fa, 0x3fb, 0xf9, 0x7fb, 0xfa, 0x16, 0x17, 0x18, 0x0, 0x1, 0x2, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x5c, 0xfb, 0x7ffc, 0x20, 0xffb, 0x3fc, 0x1ffa, 0x21, 0x5d, 0x5e, 0x5f, 0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f, 0x70, 0x71, 0x72, 0xfc, 0x73, 0xfd, 0x1ffb, 0x7fff0, 0x1ffc, 0x3ffc, 0x22, 0x7ffd, 0x3, 0x23, 0x4, 0x24, 0x5, 0x25, 0x26, 0x27, 0x6, 0x74, 0x75, 0x28, 0x29, 0x2a, 0x7, 0x2b, 0x76, 0x2c, 0x8, 0x9, 0x2d, 0x77, 0x78, 0x79, 0x7a, 0x7b, 0x7ffe, 0x7fc, 0x3ffd, 0x1ffd, 0xffffffc, 0xfffe6, 0x3fffd2, 0xfffe7, 0xfffe8, 0x3fffd3, 0x3fffd4, 0x3fffd5, 0x7fffd9, 0x3fffd6, 0x7fffda, 0x7fffdb, 0x7fffdc, 0x7fffdd, 0x7fffde, 0xffffeb, 0x7fffdf, 0xffffec, 0xffffed, 0x3fffd7, 0x7fffe0, 0xffffee, 0x7fffe1, 0x7fffe2, 0x7fffe3, 0x7fffe4, 0x1fffdc, 0x3fffd8, 0x7fffe5, 0x3fffd9, 0x7fffe6, 0x7fffe7, 0xffffef, 0x3fffda, 0x1fffdd, 0xfffe9, 0x3fffdb, 0x3fffdc, 0x7fffe8, 0x7fffe9, 0x1fffde, 0x7fffea, 0x3fffdd, 0x3fffde, 0xfffff0, 0x1fffdf, 0x3fffdf, 0x7fffeb, 0x7fffec, 0x1fffe0, 0x1fffe1, 0x3fffe0, 0x1fffe2, 0x7fffed, 0x3fffe1, 0x7fffee, 0x7fffef, 0xfffea, 0x3fffe2, 0x3fffe3, 0x3fffe4, 0x7ffff0, 0x3fffe5, 0x3fffe6, 0x7ffff1, 0x3ffffe0, 0x3ffffe1, 0xfffeb, 0x7fff1, 0x3fffe7, 0x7ffff2, 0x3fffe8, 0x1ffffec, 0x3ffffe2, 0x3ffffe3, 0x3ffffe4, 0x7ffffde, 0x7ffffdf, 0x3ffffe5, 0xfffff1, 0x1ffffed, 0x7fff2, 0x1fffe3, 0x3ffffe6, 0x7ffffe0, 0x7ffffe1, 0x3ffffe7, 0x7ffffe2, 0xfffff2, 0x1fffe4, 0x1fffe5, 0x3ffffe8, 0x3ffffe9, 0xffffffd, 0x7ffffe3, 0x7ffffe4, 0x7ffffe5, 0xfffec, 0xfffff3, 0xfffed, 0x1fffe6, 0x3fffe9, 0x1fffe7, 0x1fffe8, 0x7ffff3, 0x3fffea, 0x3fffeb, 0x1ffffee, 0x1ffffef, 0xfffff4, 0xfffff5, 0x3ffffea, 0x7ffff4, 0x3ffffeb, 0x7ffffe6, 0x3ffffec, 0x3ffffed, 0x7ffffe7, 0x7ffffe8, 0x7ffffe9, 0x7ffffea, 0x7ffffeb, 0xffffffe, 0x7ffffec, 0x7ffffed, 0x7ffffee, 0x7ffffef, 0x7fffff0, 0x3ffffee };
+				static const uint8_t lengths[256] = { 13, 23, 28, 28, 28, 28, 28, 28, 28, 24, 30, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 28, 6, 10, 10, 12, 13, 6, 8, 11, 10, 10, 8, 11, 8, 6, 6, 6, 5, 5, 5, 6, 6, 6, 6, 6, 6, 6, 7, 8, 15, 6, 12, 10, 13, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 8, 7, 8, 13, 19, 13, 14, 6, 15, 5, 6, 5, 6, 5, 6, 6, 6, 5, 7, 7, 6, 6, 6, 5, 6, 7, 6, 5, 5, 6, 7, 7, 7, 7, 7, 15, 11, 14, 13, 28, 20, 22, 20, 20, 22, 22, 22, 23, 22, 23, 23, 23, 23, 23, 24, 23, 24, 24, 22, 23, 24, 23, 23, 23, 23, 21, 22, 23, 22, 23, 23, 24, 22, 21, 20, 22, 22, 23, 23, 21, 23, 22, 22, 24, 21, 22, 23, 23, 21, 21, 22, 21, 23, 22, 23, 23, 20, 22, 22, 22, 23, 22, 22, 23, 26, 26, 20, 19, 22, 23, 22, 25, 26, 26, 26, 27, 27, 26, 24, 25, 19, 21, 26, 27, 27, 26, 27, 24, 21, 21, 26, 26, 28, 27, 27, 27, 20, 24, 20, 21, 22, 21, 21, 23, 22, 22, 25, 25, 24, 24, 26, 23, 26, 27, 26, 26, 27, 27, 27, 27, 27, 28, 27, 27, 27, 27, 27, 26 };
+				*code = codes[symbol];
+				return lengths[symbol];
+			}
+			static uint32_t http2_read32(const uint8_t* buffer)
+			{
+				return ((uint32_t)buffer[0] << 24) | ((uint32_t)buffer[1] << 16) | ((uint32_t)buffer[2] << 8) | (uint32_t)buffer[3];
+			}
+			static void http2_write32(uint8_t* buffer, uint32_t value)
+			{
+				buffer[0] = (uint8_t)(value >> 24);
+				buffer[1] = (uint8_t)(value >> 16);
+				buffer[2] = (uint8_t)(value >> 8);
+				buffer[3] = (uint8_t)value;
+			}
 			static std::string_view header_date(char buffer[64], time_t time)
 			{
 				static const char* months[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
@@ -158,6 +259,81 @@ namespace vitex
 					map.clear();
 			}
 
+			struct arena_scope
+			{
+				core::local_allocator* previous;
+				bool active;
+
+				arena_scope(core::local_allocator* arena) noexcept : previous(core::memory::get_local_allocator()), active(arena != nullptr)
+				{
+					if (active)
+						core::memory::set_local_allocator(arena);
+				}
+				~arena_scope() noexcept
+				{
+					if (active)
+						core::memory::set_local_allocator(previous);
+				}
+			};
+
+			struct arena_reclaimer final : core::local_allocator
+			{
+				connection* base;
+				core::local_allocator* previous;
+
+				arena_reclaimer(connection* new_base) noexcept : base(new_base->arena ? new_base : nullptr), previous(core::memory::get_local_allocator())
+				{
+					if (!base)
+						return;
+
+					base->add_ref();
+					core::memory::set_local_allocator(this);
+				}
+				~arena_reclaimer() noexcept override
+				{
+					if (!base)
+						return;
+
+					core::memory::set_local_allocator(previous);
+					base->release();
+				}
+				void* allocate(size_t size) noexcept override
+				{
+					core::memory::set_local_allocator(previous);
+					void* address = core::memory::default_allocate(size);
+					core::memory::set_local_allocator(this);
+					return address;
+				}
+				void free(void* address) noexcept override
+				{
+					if (base->arena->is_valid(address))
+						base->arena->free(address);
+					else
+						previous->free(address);
+				}
+				void reset() noexcept override
+				{
+				}
+				bool is_valid(void* address) noexcept override
+				{
+					return base->arena->is_valid(address) || (previous != nullptr && previous->is_valid(address));
+				}
+			};
+
+			static void release_hash_map(kimv_unordered_map& map, core::local_allocator* arena)
+			{
+				std::optional<kimv_unordered_map> garbage(std::in_place);
+				garbage->swap(map);
+
+				arena_scope scope(arena);
+				garbage.reset();
+			}
+			static bool has_route_callbacks(router_entry* route)
+			{
+				auto& callbacks = route->callbacks;
+				return callbacks.get || callbacks.post || callbacks.put || callbacks.patch || callbacks.deinit || callbacks.options || callbacks.access || callbacks.headers || callbacks.authorize || callbacks.web_socket.initiate || callbacks.web_socket.connect || callbacks.web_socket.disconnect || callbacks.web_socket.receive;
+			}
+
 			mime_static::mime_static(const std::string_view& ext, const std::string_view& t) : extension(ext), type(t)
 			{
 			}
@@ -530,7 +706,7 @@ namespace vitex
 				return true;
 			}
 
-			router_group::router_group(const std::string_view& new_match, route_mode new_mode) noexcept : match(new_match), mode(new_mode)
+			router_group::router_group(const std::string_view& new_match, route_mode new_mode) noexcept : indexed(0), match(new_match), mode(new_mode)
 			{
 			}
 			router_group::~router_group() noexcept
@@ -539,7 +715,137 @@ namespace vitex
 					core::memory::release(entry);
 				routes.clear();
 			}
+			void router_group::compile()
+			{
+				invalidate();
+				prefixes.emplace_back();
+				fragments.emplace_back();
+
+				core::string literal;
+				for (size_t i = 0; i < routes.size(); i++)
+				{
+					VI_ASSERT(routes[i] != nullptr, "route should be set");
+					switch (route_literal(routes[i]->location, literal))
+					{
+						case 1:
+							insert(prefixes, literal, i);
+							break;
+						case 0:
+							insert(fragments, literal, i);
+							break;
+						default:
+							wildcards.push_back(i);
+							break;
+					}
+				}
+				indexed = routes.size();
+			}
+			void router_group::invalidate()
+			{
+				prefixes.clear();
+				fragments.clear();
+				wildcards.clear();
+				indexed = 0;
+			}
+			router_entry* router_group::find(compute::regex_result& result, const std::string_view& location)
+			{
+				if (!indexed || indexed != routes.size())
+				{
+					for (auto* next : routes)
+					{
+						VI_ASSERT(next != nullptr, "route should be set");
+						if (compute::regex::match(&next->location, result, location))
+							return next;
+					}
+
+					return nullptr;
+				}
+
+				thread_local core::vector<size_t> candidates;
+				candidates.clear();
+				candidates.insert(candidates.end(), wildcards.begin(), wildcards.end());
+				collect(prefixes, location, candidates);
+				for (size_t i = 0; i < location.size(); i++)
+					collect(fragments, location.substr(i), candidates);
+
+				std::sort(candidates.begin(), candidates.end());
+				candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+				for (size_t index : candidates)
+				{
+					auto* next = routes[index];
+					if (compute::regex::match(&next->location, result, location))
+						return next;
+				}
+
+				return nullptr;
+			}
+			void router_group::insert(core::vector<trie_node>& nodes, const std::string_view& key, size_t index)
+			{
+				size_t node = 0, offset = 0;
+				while (offset < key.size())
+				{
+					auto& children = nodes[node].children;
+					auto it = std::find_if(children.begin(), children.end(), [&nodes, &key, offset](size_t child) { return nodes[child].segment.front() == key[offset]; });
+					if (it == children.end())
+					{
+						size_t leaf = nodes.size();
+						children.push_back(leaf);
+						nodes.emplace_back();
+						nodes[leaf].segment = key.substr(offset);
+						nodes[leaf].routes.push_back(index);
+						return;
+					}
+
+					size_t child = *it, common = 0;
+					auto& segment = nodes[child].segment;
+					while (common < segment.size() && offset + common < key.size() && segment[common] == key[offset + common])
+						++common;
+
+					if (common < segment.size())
+					{
+						size_t split = nodes.size();
+						*it = split;
+						trie_node middle;
+						middle.segment = segment.substr(0, common);
+						middle.children.push_back(child);
+						segment.erase(0, common);
+						nodes.emplace_back(std::move(middle));
+						child = split;
+					}
+
+					node = child;
+					offset += common;
+				}
+				nodes[node].routes.push_back(index);
+			}
+			void router_group::collect(const core::vector<trie_node>& nodes, const std::string_view& text, core::vector<size_t>& output)
+			{
+				size_t node = 0, offset = 0;
+				while (true)
+				{
+					auto& current = nodes[node];
+					output.insert(output.end(), current.routes.begin(), current.routes.end());
+					if (offset >= text.size())
+						break;
+
+					auto it = std::find_if(current.children.begin(), current.children.end(), [&nodes, &text, offset](size_t child) { return nodes[child].segment.front() == text[offset]; });
+					if (it == current.children.end())
+						break;
+
+					auto& segment = nodes[*it].segment;
+					if (text.substr(offset, segment.size()) != segment)
+						break;
+
+					node = *it;
+					offset += segment.size();
+				}
+			}
 
+			router_entry::~router_entry() noexcept
+			{
+				if (file_cache::has_instance())
+					file_cache::get()->clear(this);
+			}
 			router_entry* router_entry::from(const router_entry& other, const compute::regex_source& source)
 			{
 				router_entry* route = new router_entry(other);
@@ -594,6 +900,7 @@ namespace vitex
 						return a->location.get_regex().size() > b->location.get_regex().size();
 					};
 					VI_SORT(group->routes.begin(), group->routes.end(), comparator);
+					group->compile();
 				}
 			}
 			router_group* map_router::group(const std::string_view& match, route_mode mode)
@@ -670,6 +977,7 @@ namespace vitex
 				{
 					http::router_entry* result = http::router_entry::from(*from, compute::regex_source(pattern));
 					group->routes.push_back(result);
+					group->invalidate();
 					return result;
 				}
 
@@ -677,6 +985,7 @@ namespace vitex
 				result->location = compute::regex_source(pattern);
 				result->router = this;
 				group->routes.push_back(result);
+				group->invalidate();
 				return result;
 			}
 			bool map_router::remove(router_entry* source)
@@ -689,6 +998,7 @@ namespace vitex
 					{
 						core::memory::release(*it);
 						group->routes.erase(it);
+						group->invalidate();
 						return true;
 					}
 				}
@@ -938,13 +1248,38 @@ namespace vitex
 				return path;
 			}
 
-			request_frame::request_frame()
+			request_frame::request_frame() : arena(nullptr)
 			{
 				memset(method, 0, sizeof(method));
 				memset(version, 0, sizeof(version));
 				strcpy(method, "GET");
 				strcpy(version, "HTTP/1.1");
 			}
+			request_frame::request_frame(const request_frame& other) : content(other.content), cookies(other.cookies), headers(other.headers), match(other.match), user(other.user), query(other.query), path(other.path), location(other.location), referrer(other.referrer), arena(nullptr)
+			{
+				memcpy(method, other.method, sizeof(method));
+				memcpy(version, other.version, sizeof(version));
+			}
+			request_frame& request_frame::operator= (const request_frame& other)
+			{
+				if (this == &other)
+					return *this;
+
+				content = other.content;
+				match = other.match;
+				user = other.user;
+				query = other.query;
+				path = other.path;
+				location = other.location;
+				referrer = other.referrer;
+				memcpy(method, other.method, sizeof(method));
+				memcpy(version, other.version, sizeof(version));
+
+				arena_scope scope(arena);
+				cookies = other.cookies;
+				headers = other.headers;
+				return *this;
+			}
 			void request_frame::set_method(const std::string_view& value)
 			{
 				memset(method, 0, sizeof(method));
@@ -960,8 +1295,16 @@ namespace vitex
 			{
 				memset(method, 0, sizeof(method));
 				memset(version, 0, sizeof(version));
-				cleanup_hash_map(headers);
-				cleanup_hash_map(cookies);
+				if (arena != nullptr)
+				{
+					release_hash_map(headers, arena);
+					release_hash_map(cookies, arena);
+				}
+				else
+				{
+					cleanup_hash_map(headers);
+					cleanup_hash_map(cookies);
+				}
 				user.type = auth::unverified;
 				user.token.clear();
 				content.cleanup();
@@ -973,6 +1316,7 @@ namespace vitex
 			core::string& request_frame::put_header(const std::string_view& label, const std::string_view& value)
 			{
 				VI_ASSERT(!label.empty(), "label should not be empty");
+				arena_scope scope(arena);
 				core::vector<core::string>* range;
 				auto it = headers.find(core::key_lookup_cast(label));
 				if (it != headers.end())
@@ -986,6 +1330,7 @@ namespace vitex
 			core::string& request_frame::set_header(const std::string_view& label, const std::string_view& value)
 			{
 				VI_ASSERT(!label.empty(), "label should not be empty");
+				arena_scope scope(arena);
 				core::vector<core::string>* range;
 				auto it = headers.find(core::key_lookup_cast(label));
 				if (it != headers.end())
@@ -1016,6 +1361,7 @@ namespace vitex
 			core::vector<core::string>* request_frame::get_header_ranges(const std::string_view& label)
 			{
 				VI_ASSERT(!label.empty(), "label should not be empty");
+				arena_scope scope(arena);
 				auto it = headers.find(core::key_lookup_cast(label));
 				return it != headers.end() ? &it->second : &headers[core::string(label)];
 			}
@@ -1041,6 +1387,7 @@ namespace vitex
 			core::vector<core::string>* request_frame::get_cookie_ranges(const std::string_view& key)
 			{
 				VI_ASSERT(!key.empty(), "key should not be empty");
+				arena_scope scope(arena);
 				auto it = cookies.find(core::key_lookup_cast(key));
 				return it != cookies.end() ? &it->second : &cookies[core::string(key)];
 			}
@@ -1553,8 +1900,14 @@ namespace vitex
 			}
 			connection::~connection() noexcept
 			{
+				if (arena != nullptr)
+				{
+					request.cleanup();
+					request.arena = nullptr;
+				}
 				core::memory::release(resolver);
 				core::memory::release(web_socket);
+				core::memory::deinit(arena);
 			}
 			void connection::reset(bool fully)
 			{
@@ -1565,6 +1918,11 @@ namespace vitex
 					route = route->router->base;
 				request.cleanup();
 				response.cleanup();
+				if (arena != nullptr)
+				{
+					request.arena = arena;
+					arena->reset();
+				}
 				socket_connection::reset(fully);
 			}
 			bool connection::compose_response(bool apply_error_response, bool apply_body_inlining, headers_callback&& callback)
@@ -1743,14 +2101,28 @@ namespace vitex
 					route->callbacks.headers(this, *content);
 
 				content->append("\r\n", 2);
-				if (apply_body_inlining)
-					content->append(response.content.data.begin(), response.content.data.end());
+				socket_buffer buffers[2];
+				buffers[0].data = (uint8_t*)content->c_str();
+				buffers[0].size = content->size();
+				buffers[1].data = (uint8_t*)response.content.data.data();
+				buffers[1].size = apply_body_inlining ? response.content.data.size() : 0;
+				if (pipelining_requested(buffers[0].size + buffers[1].size))
+				{
+					auto status = stream->write_staged(buffers, buffers[1].size > 0 ? 2 : 1);
+					hrm_cache::get()->push(content);
+					if (!status)
+						return false;
+
+					callback(this, socket_poll::finish_sync);
+					return true;
+				}
 
-				auto status = stream->write_queued((uint8_t*)content->c_str(), content->size(), [this, content, callback = std::move(callback)](socket_poll event) mutable
+				bool more = !apply_body_inlining && body_inlining_requested() && !response.content.data.empty();
+				auto status = write_vectored_queued(buffers, buffers[1].size > 0 ? 2 : 1, [this, content, callback = std::move(callback)](socket_poll event) mutable
 				{
 					hrm_cache::get()->push(content);
 					callback(this, event);
-				}, false);
+				}, more);
 				return status || status.error() == std::errc::operation_would_block;
 			}
 			bool connection::error_response_requested()
@@ -1759,7 +2131,22 @@ namespace vitex
 			}
 			bool connection::body_inlining_requested()
 			{
-				return !response.content.data.empty() && response.content.data.size() <= INLINING_SIZE;
+				return memcmp(request.method, "HEAD", 4) != 0;
+			}
+			bool connection::pipelining_requested(size_t size)
+			{
+				auto* router = root->router;
+				if (http2 != nullptr || info.abort || router->keep_alive_max_count < 0 || (router->keep_alive_max_count > 0 && info.reuses <= 1))
+					return false;
+
+				if (!request.content.limited || request.content.offset < request.content.length || stream->get_staged_size() + size > HTTP_PIPELINE_COALESCE_SIZE)
+					return false;
+
+				auto connection = request.get_header("Connection");
+				if ((!connection.empty() && !core::stringify::case_equals(connection, "keep-alive")) || (connection.empty() && strcmp(request.version, "HTTP/1.1") != 0))
+					return false;
+
+				return stream->get_pending().find("\r\n\r\n") != std::string::npos;
 			}
 			bool connection::waiting_for_web_socket()
 			{
@@ -1798,17 +2185,17 @@ namespace vitex
 						core::string content = core::stringify::text("%x\r\n", (uint32_t)chunk.size());
 						content.append(chunk);
 						content.append("\r\n");
-						stream->write_queued((uint8_t*)content.c_str(), content.size(), std::bind(callback, this, std::placeholders::_1));
+						write_queued((uint8_t*)content.c_str(), content.size(), std::bind(callback, this, std::placeholders::_1));
 					}
 					else
-						stream->write_queued((uint8_t*)"0\r\n\r\n", 5, std::bind(callback, this, std::placeholders::_1), false);
+						write_queued((uint8_t*)"0\r\n\r\n", 5, std::bind(callback, this, std::placeholders::_1), false);
 				}
 				else
 				{
 					if (chunk.empty())
 						return false;
 
-					stream->write_queued((uint8_t*)chunk.data(), chunk.size(), std::bind(callback, this, std::placeholders::_1));
+					write_queued((uint8_t*)chunk.data(), chunk.size(), std::bind(callback, this, std::placeholders::_1));
 				}
 
 				return true;
@@ -1836,7 +2223,7 @@ namespace vitex
 						callback(this, socket_poll::finish_sync, "");
 					return false;
 				}
-				else if (!stream->is_valid())
+				else if (!http2 && !stream->is_valid())
 				{
 					if (callback)
 						callback(this, socket_poll::reset, "");
@@ -1883,7 +2270,7 @@ namespace vitex
 
 				if (is_transfer_encoding_chunked)
 				{
-					return !!stream->read_queued(root->router->max_net_buffer, [this, eat, callback = std::move(callback)](socket_poll event, const uint8_t* buffer, size_t recv)
+					return !!read_queued(root->router->max_net_buffer, [this, eat, callback = std::move(callback)](socket_poll event, const uint8_t* buffer, size_t recv)
 					{
 						if (packet::is_data(event))
 						{
@@ -1926,7 +2313,7 @@ namespace vitex
 					return true;
 				}
 
-				return !!stream->read_queued(request.content.limited ? content_length : root->router->max_heap_buffer, [this, eat, callback = std::move(callback)](socket_poll event, const uint8_t* buffer, size_t recv)
+				return !!read_queued(request.content.limited ? content_length : root->router->max_heap_buffer, [this, eat, callback = std::move(callback)](socket_poll event, const uint8_t* buffer, size_t recv)
 				{
 					if (packet::is_data(event))
 					{
@@ -2006,7 +2393,7 @@ namespace vitex
 						}
 					}
 
-					return !!stream->read_queued(content_length, [this, boundary](socket_poll event, const uint8_t* buffer, size_t recv)
+					return !!read_queued(content_length, [this, boundary](socket_poll event, const uint8_t* buffer, size_t recv)
 					{
 						if (packet::is_data(event))
 						{
@@ -2038,7 +2425,7 @@ namespace vitex
 
 				if (eat)
 				{
-					return !!stream->read_queued(content_length, [this, callback = std::move(callback)](socket_poll event, const uint8_t* buffer, size_t recv)
+					return !!read_queued(content_length, [this, callback = std::move(callback)](socket_poll event, const uint8_t* buffer, size_t recv)
 					{
 						if (packet::is_done(event) || packet::is_error_or_skip(event))
 						{
@@ -2069,7 +2456,7 @@ namespace vitex
 				}
 
 				request.content.prefetch = 0;
-				return !!stream->read_queued(content_length, [this, file, subresource = std::move(subresource), callback = std::move(callback)](socket_poll event, const uint8_t* buffer, size_t recv)
+				return !!read_queued(content_length, [this, file, subresource = std::move(subresource), callback = std::move(callback)](socket_poll event, const uint8_t* buffer, size_t recv)
 				{
 					if (packet::is_data(event))
 					{
@@ -2125,6 +2512,37 @@ namespace vitex
 				}, true);
 				return false;
 			}
+			core::expects_io<size_t> connection::write_queued(const uint8_t* buffer, size_t size, socket_written_callback&& callback, bool copy_buffer_when_async)
+			{
+				if (!http2)
+					return stream->write_queued(buffer, size, std::move(callback), copy_buffer_when_async);
+
+				socket_buffer next;
+				next.data = buffer;
+				next.size = size;
+				return http2->write(this, &next, 1, std::move(callback));
+			}
+			core::expects_io<size_t> connection::write_vectored_queued(const socket_buffer* buffers, size_t count, socket_written_callback&& callback, bool more)
+			{
+				if (!http2)
+					return stream->write_vectored_queued(buffers, count, std::move(callback), more);
+
+				return http2->write(this, buffers, count, std::move(callback));
+			}
+			core::expects_io<size_t> connection::write_file_queued(FILE* stream, size_t offset, size_t size, socket_written_callback&& callback)
+			{
+				if (!http2)
+					return this->stream->write_file_queued(stream, offset, size, std::move(callback));
+
+				return std::make_error_condition(std::errc::not_supported);
+			}
+			core::expects_io<size_t> connection::read_queued(size_t size, socket_read_callback&& callback)
+			{
+				if (!http2)
+					return stream->read_queued(size, std::move(callback));
+
+				return http2->read(this, size, std::move(callback), false);
+			}
 			bool connection::next()
 			{
 				VI_ASSERT(connection_valid(this), "connection should be valid");
@@ -2154,7 +2572,7 @@ namespace vitex
 				{
 					auto& content = base->response.content.data;
 					if (packet::is_done(event) && !response_body_inlined && !content.empty() && memcmp(base->request.method, "HEAD", 4) != 0)
-						base->stream->write_queued((uint8_t*)content.data(), content.size(), [base](socket_poll) { base->root->next(base); }, false);
+						base->write_queued((uint8_t*)content.data(), content.size(), [base](socket_poll) { base->root->next(base); }, false);
 					else
 						base->root->next(base);
 				});
@@ -2164,6 +2582,14 @@ namespace vitex
 				response.status_code = status_code;
 				return next();
 			}
+			size_t connection::get_arena_allocations() const
+			{
+				return arena ? arena->get_allocations() : 0;
+			}
+			size_t connection::get_arena_reservations() const
+			{
+				return arena ? arena->get_reservations() : 0;
+			}
 			bool connection::is_skip_required() const
 			{
 				if (!request.content.resources.empty() || request.content.is_finalized() || request.content.exceeds || !stream->is_valid())
@@ -2180,11 +2606,7 @@ namespace vitex
 						return core::string(proxy_address);
 				}
 
-				auto address = stream->get_peer_address();
-				if (!address)
-					return address.error();
-
-				return address->get_ip_address();
+				return address.get_ip_address();
 			}
 
 			query::query() : object(core::var::set::object())
@@ -2614,6 +3036,7 @@ namespace vitex
 				message.cookies = &request->cookies;
 				message.headers = &request->headers;
 				message.content = &request->content;
+				message.arena = request->arena;
 			}
 			void parser::prepare_for_response_parsing(response_frame* response)
 			{
@@ -2626,6 +3049,7 @@ namespace vitex
 				message.cookies = nullptr;
 				message.headers = &response->headers;
 				message.content = &response->content;
+				message.arena = nullptr;
 			}
 			void parser::prepare_for_chunked_parsing()
 			{
@@ -3247,10 +3671,14 @@ namespace vitex
 					"\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0"
 					"\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0";
 
-				if (message.headers != nullptr)
-					message.headers->clear();
-				if (message.cookies != nullptr)
-					message.cookies->clear();
+				if (message.headers != nullptr || message.cookies != nullptr)
+				{
+					arena_scope scope(message.arena);
+					if (message.headers != nullptr)
+						message.headers->clear();
+					if (message.cookies != nullptr)
+						message.cookies->clear();
+				}
 
 				while (true)
 				{
@@ -3862,68 +4290,1838 @@ namespace vitex
 				return true;
 			}
 
-			hrm_cache::hrm_cache() noexcept : hrm_cache(HTTP_HRM_SIZE)
-			{
-			}
-			hrm_cache::hrm_cache(size_t max_bytes_storage) noexcept : capacity(max_bytes_storage), size(0)
+			hpack_codec::hpack_codec() : resized(false)
 			{
 			}
-			hrm_cache::~hrm_cache() noexcept
+			bool hpack_codec::decode(const uint8_t* buffer, size_t size, size_t max_size, header_list& headers)
 			{
-				size = capacity = 0;
-				while (!queue.empty())
+				VI_ASSERT(buffer != nullptr || !size, "buffer should be set");
+				const uint8_t* end = buffer + size;
+				size_t total_size = 0;
+				while (buffer < end)
 				{
-					auto* item = queue.front();
-					core::memory::deinit(item);
-					queue.pop();
+					uint8_t type = *buffer;
+					if ((type & 0xe0) == 0x20)
+					{
+						size_t capacity;
+						if (!headers.empty() || !decode_integer(buffer, end, 5, &capacity) || capacity > decoder.limit)
+							return false;
+
+						decoder.capacity = capacity;
+						evict_entries(decoder);
+						continue;
+					}
+
+					size_t index;
+					std::string_view name, value;
+					if (type & 0x80)
+					{
+						if (!decode_integer(buffer, end, 7, &index) || !find_entry(index, &name, &value))
+							return false;
+
+						total_size += name.size() + value.size() + 32;
+						if (total_size > max_size)
+							return false;
+
+						headers.emplace_back(core::string(name), core::string(value));
+						continue;
+					}
+
+					bool indexing = (type & 0x40) != 0;
+					if (!decode_integer(buffer, end, indexing ? 6 : 4, &index))
+						return false;
+
+					std::pair<core::string, core::string> field;
+					if (index > 0)
+					{
+						if (!find_entry(index, &name, nullptr))
+							return false;
+
+						field.first = name;
+					}
+					else if (!decode_string(buffer, end, field.first))
+						return false;
+
+					if (!decode_string(buffer, end, field.second))
+						return false;
+
+					total_size += field.first.size() + field.second.size() + 32;
+					if (total_size > max_size)
+						return false;
+
+					if (indexing)
+						insert_entry(decoder, field.first, field.second);
+					headers.emplace_back(std::move(field));
 				}
+
+				return true;
 			}
-			void hrm_cache::shrink_to_fit() noexcept
+			void hpack_codec::encode(const header_list& headers, core::string& block)
 			{
-				size_t freed = 0;
-				while (!queue.empty() && size > capacity)
+				if (resized)
 				{
-					auto* item = queue.front();
-					size_t bytes = item->capacity();
-					size -= std::min<size_t>(size, bytes);
-					freed += bytes;
-					core::memory::deinit(item);
-					queue.pop();
+					encode_integer(block, 0x20, 5, encoder.capacity);
+					resized = false;
+				}
+
+				for (auto& item : headers)
+				{
+					auto& name = item.first;
+					auto& value = item.second;
+					bool exact = false;
+					size_t index = find_index(name, value, &exact);
+					if (exact)
+					{
+						encode_integer(block, 0x80, 7, index);
+						continue;
+					}
+
+					bool sensitive = name == "authorization" || name == "proxy-authorization" || name == "set-cookie";
+					bool transient = name == "date" || name == "content-length" || name == "content-range" || name == "etag" || name == "last-modified" || name == "age" || name == "expires";
+					bool indexing = !sensitive && !transient && name.size() + value.size() + 32 <= encoder.capacity;
+					if (sensitive)
+						encode_integer(block, 0x10, 4, index);
+					else if (indexing)
+						encode_integer(block, 0x40, 6, index);
+					else
+						encode_integer(block, 0x00, 4, index);
+
+					if (!index)
+						encode_string(block, name);
+					encode_string(block, value);
+					if (indexing)
+						insert_entry(encoder, name, value);
 				}
-				if (freed > 0)
-					VI_DEBUG("[http] freed up %" PRIu64 " bytes from hrm cache", (uint64_t)freed);
 			}
-			void hrm_cache::shrink() noexcept
+			void hpack_codec::set_decoder_capacity(size_t capacity)
 			{
-				core::umutex<std::mutex> unique(mutex);
-				shrink_to_fit();
+				decoder.limit = capacity;
+				if (decoder.capacity > capacity)
+				{
+					decoder.capacity = capacity;
+					evict_entries(decoder);
+				}
 			}
-			void hrm_cache::rescale(size_t max_bytes_storage) noexcept
+			void hpack_codec::set_encoder_capacity(size_t capacity)
 			{
-				core::umutex<std::mutex> unique(mutex);
-				capacity = max_bytes_storage;
-				shrink_to_fit();
+				capacity = std::min(capacity, encoder.limit);
+				if (capacity == encoder.capacity)
+					return;
+
+				encoder.capacity = capacity;
+				evict_entries(encoder);
+				resized = true;
 			}
-			void hrm_cache::push(core::string* entry)
+			bool hpack_codec::find_entry(size_t index, std::string_view* name, std::string_view* value) const
 			{
-				entry->clear();
-				core::umutex<std::mutex> unique(mutex);
-				size += entry->capacity();
-				queue.push(entry);
-				shrink_to_fit();
+				if (index <= HTTP2_STATIC_TABLE_SIZE)
+				{
+					auto* entry = hpack_static_entry(index);
+					if (!entry)
+						return false;
+
+					*name = entry->first;
+					if (value != nullptr)
+						*value = entry->second;
+					return true;
+				}
+
+				index -= HTTP2_STATIC_TABLE_SIZE + 1;
+				if (index >= decoder.entries.size())
+					return false;
+
+				auto& entry = decoder.entries[decoder.entries.size() - index - 1];
+				*name = entry.first;
+				if (value != nullptr)
+					*value = entry.second;
+				return true;
 			}
-			core::string* hrm_cache::pop() noexcept
+			size_t hpack_codec::find_index(const std::string_view& name, const std::string_view& value, bool* exact) const
 			{
-				core::umutex<std::mutex> unique(mutex);
-				if (queue.empty())
-					return core::memory::init<core::string>();
+				size_t result = 0;
+				for (size_t i = 1; i <= HTTP2_STATIC_TABLE_SIZE; i++)
+				{
+					auto* entry = hpack_static_entry(i);
+					if (entry->first != name)
+						continue;
 
-				auto* item = queue.front();
+					if (entry->second == value)
+					{
+						*exact = true;
+						return i;
+					}
+					else if (!result)
+						result = i;
+				}
+
+				for (size_t i = encoder.entries.size(); i-- > 0;)
+				{
+					auto& entry = encoder.entries[i];
+					if (entry.first != name)
+						continue;
+
+					size_t index = HTTP2_STATIC_TABLE_SIZE + encoder.entries.size() - i;
+					if (entry.second == value)
+					{
+						*exact = true;
+						return index;
+					}
+					else if (!result)
+						result = index;
+				}
+
+				return result;
+			}
+			void hpack_codec::insert_entry(table& target, const std::string_view& name, const std::string_view& value)
+			{
+				size_t size = name.size() + value.size() + 32;
+				if (size > target.capacity)
+				{
+					target.entries.clear();
+					target.size = 0;
+					return;
+				}
+
+				target.entries.emplace_back(core::string(name), core::string(value));
+				target.size += size;
+				evict_entries(target);
+			}
+			void hpack_codec::evict_entries(table& target)
+			{
+				size_t count = 0;
+				while (target.size > target.capacity && count < target.entries.size())
+				{
+					auto& entry = target.entries[count++];
+					target.size -= entry.first.size() + entry.second.size() + 32;
+				}
+
+				if (count > 0)
+					target.entries.erase(target.entries.begin(), target.entries.begin() + count);
+			}
+			bool hpack_codec::decode_integer(const uint8_t*& buffer, const uint8_t* end, uint8_t prefix, size_t* value)
+			{
+				if (buffer >= end)
+					return false;
+
+				size_t limit = ((size_t)1 << prefix) - 1;
+				size_t result = *buffer++ & limit;
+				if (result < limit)
+				{
+					*value = result;
+					return true;
+				}
+
+				for (size_t shift = 0; buffer < end && shift <= 28; shift += 7)
+				{
+					uint8_t next = *buffer++;
+					result += (size_t)(next & 0x7f) << shift;
+					if (!(next & 0x80))
+					{
+						*value = result;
+						return true;
+					}
+				}
+
+				return false;
+			}
+			bool hpack_codec::decode_string(const uint8_t*& buffer, const uint8_t* end, core::string& value)
+			{
+				if (buffer >= end)
+					return false;
+
+				size_t size;
+				bool huffman = (*buffer & 0x80) != 0;
+				if (!decode_integer(buffer, end, 7, &size) || size > (size_t)(end - buffer))
+					return false;
+
+				if (huffman)
+				{
+					if (!decode_huffman(buffer, size, value))
+						return false;
+				}
+				else
+					value.assign((char*)buffer, size);
+
+				buffer += size;
+				return true;
+			}
+			bool hpack_codec::decode_huffman(const uint8_t* buffer, size_t size, core::string& value)
+			{
+				struct canonical_table
+				{
+					uint32_t first[32] = { };
+					uint16_t offset[32] = { };
+					uint16_t count[32] = { };
+					uint8_t symbols[256] = { };
+
+					canonical_table()
+					{
+						uint32_t code;
+						for (size_t i = 0; i < 256; i++)
+							++count[hpack_huffman_code((uint8_t)i, &code)];
+
+						uint32_t next = 0;
+						uint16_t index = 0;
+						for (size_t length = 1; length < 32; length++)
+						{
+							first[length] = next;
+							offset[length] = index;
+							for (size_t i = 0; i < 256; i++)
+							{
+								if (hpack_huffman_code((uint8_t)i, &code) == length)
+									symbols[index++] = (uint8_t)i;
+							}
+							next = (next + count[length]) << 1;
+						}
+					}
+				};
+				static canonical_table table;
+
+				uint32_t code = 0;
+				size_t length = 0;
+				value.clear();
+				value.reserve(size * 8 / 5);
+				for (size_t i = 0; i < size; i++)
+				{
+					for (int bit = 7; bit >= 0; bit--)
+					{
+						code = (code << 1) | ((buffer[i] >> bit) & 1);
+						if (++length > 30)
+							return false;
+
+						uint32_t symbol = code - table.first[length];
+						if (symbol >= table.count[length])
+							continue;
+
+						value.push_back((char)table.symbols[table.offset[length] + symbol]);
+						code = 0;
+						length = 0;
+					}
+				}
+
+				return length <= 7 && code == ((uint32_t)1 << length) - 1;
+			}
+			void hpack_codec::encode_integer(core::string& block, uint8_t flags, uint8_t prefix, size_t value)
+			{
+				size_t limit = ((size_t)1 << prefix) - 1;
+				if (value < limit)
+				{
+					block.push_back((char)(flags | value));
+					return;
+				}
+
+				block.push_back((char)(flags | limit));
+				value -= limit;
+				while (value >= 0x80)
+				{
+					block.push_back((char)((value & 0x7f) | 0x80));
+					value >>= 7;
+				}
+				block.push_back((char)value);
+			}
+			void hpack_codec::encode_string(core::string& block, const std::string_view& value)
+			{
+				size_t bits = 0;
+				uint32_t code;
+				for (char symbol : value)
+					bits += hpack_huffman_code((uint8_t)symbol, &code);
+
+				size_t size = (bits + 7) / 8;
+				if (size < value.size())
+				{
+					encode_integer(block, 0x80, 7, size);
+					encode_huffman(block, value);
+				}
+				else
+				{
+					encode_integer(block, 0x00, 7, value.size());
+					block.append(value);
+				}
+			}
+			void hpack_codec::encode_huffman(core::string& block, const std::string_view& value)
+			{
+				uint64_t bits = 0;
+				size_t count = 0;
+				for (char symbol : value)
+				{
+					uint32_t code;
+					uint8_t length = hpack_huffman_code((uint8_t)symbol, &code);
+					bits = (bits << length) | code;
+					count += length;
+					while (count >= 8)
+					{
+						count -= 8;
+						block.push_back((char)(bits >> count));
+					}
+				}
+
+				if (count > 0)
+					block.push_back((char)((bits << (8 - count)) | (0xff >> count)));
+			}
+			http2_session::channel::channel(uint32_t new_id) : resolver(nullptr), base(nullptr), send_window(0), receive_window(0), content_length(-1), received(0), credit(0), remaining(0), read_size(0), id(new_id), chunked(false), headless(false), bounded(false), streaming(false), reading(false), writing(false), remote_closed(false), local_closed(false), headers_sent(false), response_done(false), closed(false)
+			{
+			}
+			http2_session::channel::~channel() noexcept
+			{
+				core::memory::release(resolver);
+			}
+
+			http2_session::http2_session(connection* new_base) : codec(new hpack_codec()), base(new_base), router((map_router*)new_base->root->router), send_window(HTTP2_DEFAULT_WINDOW_SIZE), receive_window(HTTP2_DEFAULT_WINDOW_SIZE), initial_window_size(HTTP2_DEFAULT_WINDOW_SIZE), max_frame_size(HTTP2_MIN_FRAME_SIZE), last_stream_id(0), block_stream_id(0), block_flags(0), preface(false), receiving(false), transmitting(false), paused(false), draining(false), closed(false)
+			{
+				VI_ASSERT(connection_valid(new_base), "connection should be valid");
+				codec->set_decoder_capacity(router->http2.header_table_size);
+			}
+			http2_session::~http2_session() noexcept
+			{
+				for (auto& item : channels)
+					core::memory::release(item.second);
+				for (auto* item : streams)
+					core::memory::release(item);
+				core::memory::release(codec);
+			}
+			void http2_session::start()
+			{
+				core::umutex<std::recursive_mutex> unique(section);
+				VI_DEBUG("[http] fd %i switch to http/2 session", (int)base->stream->get_fd());
+				base->stream->set_no_delay(true);
+				add_ref();
+
+				uint8_t settings[24];
+				uint16_t keys[] = { 1, 3, 4, 5 };
+				size_t values[] = { router->http2.header_table_size, router->http2.max_concurrent_streams, router->http2.initial_window_size, router->http2.max_frame_size };
+				for (size_t i = 0; i < 4; i++)
+				{
+					settings[i * 6 + 0] = (uint8_t)(keys[i] >> 8);
+					settings[i * 6 + 1] = (uint8_t)keys[i];
+					http2_write32(settings + i * 6 + 2, (uint32_t)values[i]);
+				}
+
+				push_frame(frame_type::settings, 0, 0, std::string_view((char*)settings, sizeof(settings)));
+				if (router->http2.initial_window_size > HTTP2_DEFAULT_WINDOW_SIZE)
+				{
+					receive_window = (int64_t)router->http2.initial_window_size;
+					push_window_update(0, router->http2.initial_window_size - HTTP2_DEFAULT_WINDOW_SIZE);
+				}
+
+				transmit();
+				receive();
+			}
+			void http2_session::receive()
+			{
+				uint8_t buffer[core::BLOB_SIZE];
+				while (!closed && !receiving)
+				{
+					if (outgoing.size() >= HTTP2_SESSION_BUFFER_SIZE)
+					{
+						transmit();
+						if (transmitting)
+						{
+							paused = true;
+							return;
+						}
+					}
+
+					auto status = base->stream->read(buffer, sizeof(buffer));
+					if (!status)
+					{
+						if (status.error() != std::errc::operation_would_block)
+							return teardown();
+
+						receiving = true;
+						add_ref();
+						multiplexer::get()->when_readable(base->stream, [this](socket_poll event)
+						{
+							{
+								core::umutex<std::recursive_mutex> unique(section);
+								receiving = false;
+								if (!closed)
+								{
+									if (base->info.abort)
+										teardown();
+									else if (packet::is_done(event) || event == socket_poll::reset || (packet::is_timeout(event) && !channels.empty()))
+										receive();
+									else if (packet::is_timeout(event))
+										terminate(error_code::no_error);
+									else
+										teardown();
+								}
+							}
+							release();
+						});
+						return;
+					}
+
+					incoming.append((char*)buffer, *status);
+					if (!process_frames())
+						return;
+
+					transmit();
+				}
+			}
+			void http2_session::transmit()
+			{
+				while (!closed && !transmitting && !outgoing.empty())
+				{
+					auto status = base->stream->write((uint8_t*)outgoing.data(), outgoing.size());
+					if (!status)
+					{
+						if (status.error() != std::errc::operation_would_block)
+							return teardown();
+
+						transmitting = true;
+						add_ref();
+						multiplexer::get()->when_writeable(base->stream, [this](socket_poll event)
+						{
+							{
+								core::umutex<std::recursive_mutex> unique(section);
+								transmitting = false;
+								if (!closed)
+								{
+									if (packet::is_done(event))
+										resume();
+									else
+										teardown();
+								}
+							}
+							release();
+						});
+						return;
+					}
+
+					outgoing.erase(0, *status);
+				}
+			}
+			void http2_session::resume()
+			{
+				transmit();
+				if (closed || transmitting)
+					return;
+
+				core::vector<channel*> targets;
+				targets.reserve(channels.size());
+				for (auto& item : channels)
+				{
+					item.second->add_ref();
+					targets.push_back(item.second);
+				}
+
+				for (auto* target : targets)
+				{
+					pump(target);
+					target->release();
+				}
+
+				if (paused && !closed && !transmitting)
+				{
+					paused = false;
+					receive();
+				}
+			}
+			void http2_session::pump(channel* target)
+			{
+				while (!closed && !target->closed)
+				{
+					bool progress = send_data(target);
+					if (target->writing && target->body.size() < HTTP2_CHANNEL_BUFFER_SIZE)
+						resume_write(target);
+
+					if (target->local_closed)
+						return complete_channel(target);
+
+					if (outgoing.size() >= HTTP2_SESSION_BUFFER_SIZE)
+					{
+						transmit();
+						if (transmitting)
+							break;
+					}
+
+					if (!progress)
+						break;
+				}
+				transmit();
+			}
+			void http2_session::resume_read(channel* target)
+			{
+				if (!target->reading)
+					return;
+
+				auto* source = target->base;
+				auto callback = std::move(target->read_callback);
+				size_t size = target->read_size;
+				target->read_callback = nullptr;
+				target->reading = false;
+				core::codefer([source, size, callback = std::move(callback)]() mutable
+				{
+					source->http2->read(source, size, std::move(callback), true);
+				});
+			}
+			void http2_session::resume_write(channel* target)
+			{
+				if (!target->writing)
+					return;
+
+				auto callback = std::move(target->write_callback);
+				auto event = target->closed && !target->local_closed ? socket_poll::reset : socket_poll::finish;
+				target->write_callback = nullptr;
+				target->writing = false;
+				core::codefer([event, callback = std::move(callback)]()
+				{
+					callback(event);
+				});
+			}
+			void http2_session::complete_channel(channel* target)
+			{
+				if (!target->remote_closed)
+					push_reset(target->id, error_code::no_error);
+
+				close_channel(target);
+				transmit();
+			}
+			void http2_session::reset_channel(channel* target, error_code code)
+			{
+				push_reset(target->id, code);
+				close_channel(target);
+				transmit();
+			}
+			void http2_session::close_channel(channel* target)
+			{
+				if (target->closed)
+					return;
+
+				target->closed = true;
+				if (target->credit > 0 && !closed)
+				{
+					receive_window += (int64_t)target->credit;
+					push_window_update(0, target->credit);
+					target->credit = 0;
+				}
+
+				resume_read(target);
+				resume_write(target);
+				channels.erase(target->id);
+				core::memory::release(target);
+			}
+			void http2_session::push_frame(frame_type type, uint8_t flags, uint32_t id, const std::string_view& payload)
+			{
+				uint8_t header[HTTP2_FRAME_HEADER_SIZE];
+				header[0] = (uint8_t)(payload.size() >> 16);
+				header[1] = (uint8_t)(payload.size() >> 8);
+				header[2] = (uint8_t)payload.size();
+				header[3] = (uint8_t)type;
+				header[4] = flags;
+				http2_write32(header + 5, id & 0x7fffffff);
+				outgoing.append((char*)header, sizeof(header));
+				outgoing.append(payload);
+			}
+			void http2_session::push_headers(channel* target, const hpack_codec::header_list& headers, bool end_stream)
+			{
+				core::string block;
+				codec->encode(headers, block);
+
+				size_t offset = 0;
+				do
+				{
+					size_t size = std::min(block.size() - offset, max_frame_size);
+					uint8_t flags = (offset + size == block.size() ? HTTP2_FLAG_END_HEADERS : 0);
+					if (!offset && end_stream)
+						flags |= HTTP2_FLAG_END_STREAM;
+
+					push_frame(offset > 0 ? frame_type::continuation : frame_type::headers, flags, target->id, std::string_view(block.data() + offset, size));
+					offset += size;
+				} while (offset < block.size());
+			}
+			void http2_session::push_reset(uint32_t id, error_code code)
+			{
+				uint8_t payload[4];
+				http2_write32(payload, (uint32_t)code);
+				push_frame(frame_type::rst_stream, 0, id, std::string_view((char*)payload, sizeof(payload)));
+			}
+			void http2_session::push_window_update(uint32_t id, size_t increment)
+			{
+				uint8_t payload[4];
+				http2_write32(payload, (uint32_t)increment & 0x7fffffff);
+				push_frame(frame_type::window_update, 0, id, std::string_view((char*)payload, sizeof(payload)));
+			}
+			void http2_session::teardown()
+			{
+				if (closed)
+					return;
+
+				closed = true;
+				auto targets = std::move(channels);
+				channels.clear();
+				for (auto& item : targets)
+					close_channel(item.second);
+
+				if (!outgoing.empty())
+				{
+					base->stream->write((uint8_t*)outgoing.data(), outgoing.size());
+					outgoing.clear();
+				}
+
+				VI_DEBUG("[http] fd %i close http/2 session", (int)base->stream->get_fd());
+				auto* target = base;
+				base = nullptr;
+				target->stream->clear_events(true);
+				target->abort();
+				release();
+			}
+			bool http2_session::terminate(error_code code)
+			{
+				if (closed)
+					return false;
+
+				uint8_t payload[8];
+				http2_write32(payload, last_stream_id);
+				http2_write32(payload + 4, (uint32_t)code);
+				push_frame(frame_type::goaway, 0, 0, std::string_view((char*)payload, sizeof(payload)));
+				teardown();
+				return false;
+			}
+			bool http2_session::process_frames()
+			{
+				size_t offset = 0;
+				if (!preface)
+				{
+					if (incoming.size() < 6)
+						return true;
+
+					if (memcmp(incoming.data(), "SM\r\n\r\n", 6) != 0)
+						return terminate(error_code::protocol_error);
+
+					preface = true;
+					offset = 6;
+				}
+
+				while (incoming.size() - offset >= HTTP2_FRAME_HEADER_SIZE)
+				{
+					const uint8_t* header = (uint8_t*)incoming.data() + offset;
+					size_t size = ((size_t)header[0] << 16) | ((size_t)header[1] << 8) | (size_t)header[2];
+					if (size > router->http2.max_frame_size)
+						return terminate(error_code::frame_size_error);
+
+					if (incoming.size() - offset - HTTP2_FRAME_HEADER_SIZE < size)
+						break;
+
+					if (!process_frame((frame_type)header[3], header[4], http2_read32(header + 5) & 0x7fffffff, header + HTTP2_FRAME_HEADER_SIZE, size))
+						return false;
+
+					offset += HTTP2_FRAME_HEADER_SIZE + size;
+				}
+
+				incoming.erase(0, offset);
+				return true;
+			}
+			bool http2_session::process_frame(frame_type type, uint8_t flags, uint32_t id, const uint8_t* payload, size_t size)
+			{
+				if (block_stream_id > 0 && (type != frame_type::continuation || id != block_stream_id))
+					return terminate(error_code::protocol_error);
+
+				switch (type)
+				{
+					case frame_type::data:
+					{
+						if (!id)
+							return terminate(error_code::protocol_error);
+
+						size_t length = size;
+						if (flags & HTTP2_FLAG_PADDED)
+						{
+							if (!size || payload[0] >= size)
+								return terminate(error_code::protocol_error);
+
+							length = size - payload[0] - 1;
+							++payload;
+						}
+
+						if ((int64_t)size > receive_window)
+							return terminate(error_code::flow_control_error);
+
+						receive_window -= (int64_t)size;
+						auto* target = find_channel(id);
+						if (!target || target->remote_closed)
+						{
+							if (id > last_stream_id)
+								return terminate(error_code::protocol_error);
+
+							receive_window += (int64_t)size;
+							push_window_update(0, size);
+							if (target != nullptr)
+								reset_channel(target, error_code::stream_closed);
+							return true;
+						}
+
+						if ((int64_t)size > target->receive_window)
+						{
+							receive_window += (int64_t)size;
+							push_window_update(0, size);
+							reset_channel(target, error_code::flow_control_error);
+							return true;
+						}
+
+						target->received += length;
+						if (target->content_length >= 0 && (target->received > (size_t)target->content_length || ((flags & HTTP2_FLAG_END_STREAM) && target->received != (size_t)target->content_length)))
+						{
+							receive_window += (int64_t)size;
+							push_window_update(0, size);
+							reset_channel(target, error_code::protocol_error);
+							return true;
+						}
+
+						target->receive_window -= (int64_t)size;
+						target->credit += size;
+						if (length > 0)
+						{
+							if (target->chunked)
+							{
+								target->request.append(core::stringify::text("%x\r\n", (uint32_t)length));
+								target->request.append((char*)payload, length);
+								target->request.append("\r\n");
+							}
+							else
+								target->request.append((char*)payload, length);
+						}
+
+						if (flags & HTTP2_FLAG_END_STREAM)
+						{
+							target->remote_closed = true;
+							if (target->chunked)
+								target->request.append("0\r\n\r\n");
+						}
+
+						resume_read(target);
+						return true;
+					}
+					case frame_type::headers:
+					{
+						if (!id)
+							return terminate(error_code::protocol_error);
+
+						size_t length = size;
+						if (flags & HTTP2_FLAG_PADDED)
+						{
+							if (!size || payload[0] >= size)
+								return terminate(error_code::protocol_error);
+
+							length = size - payload[0] - 1;
+							++payload;
+						}
+
+						if (flags & HTTP2_FLAG_PRIORITY)
+						{
+							if (length < 5)
+								return terminate(error_code::protocol_error);
+
+							payload += 5;
+							length -= 5;
+						}
+
+						if (flags & HTTP2_FLAG_END_HEADERS)
+							return process_headers(id, flags, payload, length);
+
+						block.assign((char*)payload, length);
+						block_stream_id = id;
+						block_flags = flags;
+						return true;
+					}
+					case frame_type::continuation:
+					{
+						if (!block_stream_id)
+							return terminate(error_code::protocol_error);
+
+						block.append((char*)payload, size);
+						if (block.size() > router->max_heap_buffer)
+							return terminate(error_code::protocol_error);
+
+						if (!(flags & HTTP2_FLAG_END_HEADERS))
+							return true;
+
+						core::string data = std::move(block);
+						block_stream_id = 0;
+						block.clear();
+						return process_headers(id, block_flags, (uint8_t*)data.data(), data.size());
+					}
+					case frame_type::settings:
+						return process_settings(flags, id, payload, size);
+					case frame_type::ping:
+					{
+						if (id > 0)
+							return terminate(error_code::protocol_error);
+						else if (size != 8)
+							return terminate(error_code::frame_size_error);
+
+						if (!(flags & HTTP2_FLAG_ACK))
+							push_frame(frame_type::ping, HTTP2_FLAG_ACK, 0, std::string_view((char*)payload, size));
+						return true;
+					}
+					case frame_type::goaway:
+					{
+						if (id > 0)
+							return terminate(error_code::protocol_error);
+
+						draining = true;
+						return true;
+					}
+					case frame_type::window_update:
+					{
+						if (size != 4)
+							return terminate(error_code::frame_size_error);
+
+						uint32_t increment = http2_read32(payload) & 0x7fffffff;
+						if (!id)
+						{
+							if (!increment)
+								return terminate(error_code::protocol_error);
+
+							send_window += increment;
+							if (send_window > HTTP2_MAX_WINDOW_SIZE)
+								return terminate(error_code::flow_control_error);
+
+							resume();
+							return !closed;
+						}
+
+						auto* target = find_channel(id);
+						if (!target)
+							return id <= last_stream_id || terminate(error_code::protocol_error);
+
+						target->send_window += increment;
+						if (!increment || target->send_window > HTTP2_MAX_WINDOW_SIZE)
+						{
+							reset_channel(target, increment ? error_code::flow_control_error : error_code::protocol_error);
+							return true;
+						}
+
+						target->add_ref();
+						pump(target);
+						target->release();
+						return !closed;
+					}
+					case frame_type::rst_stream:
+					{
+						if (!id || id > last_stream_id)
+							return terminate(error_code::protocol_error);
+						else if (size != 4)
+							return terminate(error_code::frame_size_error);
+
+						auto* target = find_channel(id);
+						if (target != nullptr)
+							close_channel(target);
+						return true;
+					}
+					case frame_type::priority:
+					{
+						if (!id)
+							return terminate(error_code::protocol_error);
+						else if (size != 5)
+							return terminate(error_code::frame_size_error);
+						return true;
+					}
+					case frame_type::push_promise:
+						return terminate(error_code::protocol_error);
+					default:
+						return true;
+				}
+			}
+			bool http2_session::process_headers(uint32_t id, uint8_t flags, const uint8_t* payload, size_t size)
+			{
+				hpack_codec::header_list headers;
+				if (!codec->decode(payload, size, router->max_heap_buffer, headers))
+					return terminate(error_code::compression_error);
+
+				auto* target = find_channel(id);
+				if (target != nullptr)
+				{
+					if (target->remote_closed || !(flags & HTTP2_FLAG_END_STREAM) || (target->content_length >= 0 && target->received != (size_t)target->content_length))
+					{
+						reset_channel(target, target->remote_closed ? error_code::stream_closed : error_code::protocol_error);
+						return true;
+					}
+
+					target->remote_closed = true;
+					if (target->chunked)
+						target->request.append("0\r\n\r\n");
+
+					resume_read(target);
+					return true;
+				}
+
+				if (id <= last_stream_id || !(id & 1))
+					return terminate(error_code::protocol_error);
+
+				last_stream_id = id;
+				if (draining || channels.size() >= router->http2.max_concurrent_streams)
+				{
+					push_reset(id, error_code::refused_stream);
+					return true;
+				}
+
+				return open_channel(id, flags, headers);
+			}
+			bool http2_session::process_settings(uint8_t flags, uint32_t id, const uint8_t* payload, size_t size)
+			{
+				if (id > 0)
+					return terminate(error_code::protocol_error);
+
+				if (flags & HTTP2_FLAG_ACK)
+					return !size || terminate(error_code::frame_size_error);
+
+				if (size % 6 != 0)
+					return terminate(error_code::frame_size_error);
+
+				for (size_t offset = 0; offset < size; offset += 6)
+				{
+					uint16_t key = (uint16_t)(((uint16_t)payload[offset] << 8) | (uint16_t)payload[offset + 1]);
+					uint32_t value = http2_read32(payload + offset + 2);
+					switch (key)
+					{
+						case 1:
+							codec->set_encoder_capacity(value);
+							break;
+						case 2:
+							if (value > 1)
+								return terminate(error_code::protocol_error);
+							break;
+						case 4:
+						{
+							if (value > HTTP2_MAX_WINDOW_SIZE)
+								return terminate(error_code::flow_control_error);
+
+							int64_t delta = (int64_t)value - initial_window_size;
+							for (auto& item : channels)
+							{
+								item.second->send_window += delta;
+								if (item.second->send_window > HTTP2_MAX_WINDOW_SIZE)
+									return terminate(error_code::flow_control_error);
+							}
+
+							initial_window_size = (int64_t)value;
+							break;
+						}
+						case 5:
+							if (value < HTTP2_MIN_FRAME_SIZE || value > HTTP2_MAX_FRAME_SIZE)
+								return terminate(error_code::protocol_error);
+
+							max_frame_size = value;
+							break;
+						default:
+							break;
+					}
+				}
+
+				push_frame(frame_type::settings, HTTP2_FLAG_ACK, 0, std::string_view());
+				resume();
+				return !closed;
+			}
+			bool http2_session::process_response(channel* target, const uint8_t* buffer, size_t size)
+			{
+				if (target->headers_sent)
+					return target->response_done || process_response_body(target, buffer, size);
+
+				core::string merge;
+				std::string_view data((char*)buffer, size);
+				if (!target->head.empty())
+				{
+					merge = std::move(target->head);
+					merge.append(data);
+					target->head.clear();
+					data = merge;
+				}
+
+				while (!target->headers_sent)
+				{
+					size_t offset = data.find("\r\n\r\n");
+					if (offset == std::string::npos)
+					{
+						target->head.assign(data);
+						return target->head.size() <= router->max_heap_buffer;
+					}
+
+					if (!process_response_head(target, data.substr(0, offset + 4)))
+						return false;
+
+					data.remove_prefix(offset + 4);
+				}
+
+				return target->response_done || data.empty() || process_response_body(target, (uint8_t*)data.data(), data.size());
+			}
+			bool http2_session::process_response_head(channel* target, const std::string_view& head)
+			{
+				hpack_codec::header_list headers;
+				int64_t content_length = -1;
+				bool chunked = false;
+				int status_code = translate_response(head, headers, &content_length, &chunked);
+				if (status_code < 100 || status_code == 101)
+					return false;
+
+				if (status_code < 200)
+				{
+					push_headers(target, headers, false);
+					return true;
+				}
+
+				if (target->headless || status_code == 204 || status_code == 304)
+					target->response_done = true;
+				else if (chunked)
+				{
+					if (!target->resolver)
+						target->resolver = new parser();
+					target->streaming = true;
+					target->resolver->prepare_for_chunked_parsing();
+				}
+				else if (content_length >= 0)
+				{
+					target->remaining = (size_t)content_length;
+					target->bounded = target->remaining > 0;
+					target->response_done = !target->bounded;
+				}
+
+				target->headers_sent = true;
+				target->local_closed = target->response_done;
+				push_headers(target, headers, target->response_done);
+				return true;
+			}
+			bool http2_session::process_response_body(channel* target, const uint8_t* buffer, size_t size)
+			{
+				if (target->streaming)
+				{
+					size_t offset = target->body.size(), length = size;
+					target->body.append((char*)buffer, size);
+
+					int64_t result = target->resolver->parse_decode_chunked((uint8_t*)target->body.data() + offset, &length);
+					if (result == -1)
+						return false;
+
+					target->body.resize(offset + length);
+					if (result >= 0)
+					{
+						target->streaming = false;
+						target->response_done = true;
+					}
+					return true;
+				}
+
+				if (target->bounded)
+				{
+					size = std::min(size, target->remaining);
+					target->remaining -= size;
+					if (!target->remaining)
+					{
+						target->bounded = false;
+						target->response_done = true;
+					}
+				}
+
+				target->body.append((char*)buffer, size);
+				return true;
+			}
+			bool http2_session::open_channel(uint32_t id, uint8_t flags, const hpack_codec::header_list& headers)
+			{
+				connection* source = nullptr;
+				if (streams.empty())
+				{
+					source = (connection*)base->root->on_allocate(base->host);
+					source->stream = new socket();
+				}
+				else
+				{
+					source = streams.back();
+					streams.pop_back();
+				}
+
+				bool end_stream = (flags & HTTP2_FLAG_END_STREAM) != 0;
+				bool chunked = false;
+				int64_t content_length = -1;
+				if (!translate_request(headers, end_stream, &source->request, source->resolver, &content_length, &chunked) || (end_stream && content_length > 0))
+				{
+					source->reset(true);
+					streams.push_back(source);
+					push_reset(id, error_code::protocol_error);
+					return true;
+				}
+
+				auto* target = new channel(id);
+				target->base = source;
+				target->content_length = content_length;
+				target->send_window = initial_window_size;
+				target->receive_window = (int64_t)router->http2.initial_window_size;
+				target->chunked = chunked;
+				target->headless = !strcmp(source->request.method, "HEAD");
+				target->remote_closed = end_stream;
+				channels[id] = target;
+
+				if (source->host != base->host)
+				{
+					core::memory::release(source->host);
+					source->host = base->host;
+					source->host->add_ref();
+				}
+
+				source->address = base->address;
+				source->info.start = network::utils::clock();
+				source->request.content.prepare(source->request.headers, nullptr, 0);
+				source->http2 = this;
+				source->http2_id = id;
+				add_ref();
+
+				core::codefer([source]()
+				{
+					arena_reclaimer reclaimer(source);
+					source->root->dispatch(source);
+				});
+				return true;
+			}
+			bool http2_session::finish_response(channel* target)
+			{
+				if (!target->headers_sent || target->bounded || target->streaming)
+					return false;
+
+				target->response_done = true;
+				return true;
+			}
+			bool http2_session::send_data(channel* target)
+			{
+				bool sent = false;
+				while (target->headers_sent && !target->local_closed && outgoing.size() < HTTP2_SESSION_BUFFER_SIZE)
+				{
+					int64_t window = std::min(target->send_window, send_window);
+					size_t size = std::min(std::min(target->body.size(), max_frame_size), (size_t)std::max<int64_t>(0, window));
+					bool last = target->response_done && size == target->body.size();
+					if (!size && !last)
+						break;
+
+					push_frame(frame_type::data, last ? HTTP2_FLAG_END_STREAM : 0, target->id, std::string_view(target->body.data(), size));
+					target->body.erase(0, size);
+					target->send_window -= (int64_t)size;
+					target->local_closed = last;
+					send_window -= (int64_t)size;
+					sent = true;
+				}
+				return sent;
+			}
+			core::expects_io<size_t> http2_session::write(connection* source, const socket_buffer* buffers, size_t count, socket_written_callback&& callback)
+			{
+				core::umutex<std::recursive_mutex> unique(section);
+				auto* target = find_channel(source->http2_id);
+				if (!target || target->writing)
+				{
+					unique.unlock();
+					callback(socket_poll::reset);
+					return std::make_error_condition(std::errc::connection_reset);
+				}
+
+				size_t size = 0;
+				for (size_t i = 0; i < count; i++)
+				{
+					if (!process_response(target, buffers[i].data, buffers[i].size))
+					{
+						reset_channel(target, error_code::internal_error);
+						unique.unlock();
+						callback(socket_poll::reset);
+						return std::make_error_condition(std::errc::protocol_error);
+					}
+					size += buffers[i].size;
+				}
+
+				source->stream->outcome += size;
+				target->add_ref();
+				pump(target);
+				if (!target->closed && target->body.size() >= HTTP2_CHANNEL_BUFFER_SIZE)
+				{
+					target->write_callback = std::move(callback);
+					target->writing = true;
+					target->release();
+					return std::make_error_condition(std::errc::operation_would_block);
+				}
+
+				target->release();
+				unique.unlock();
+				callback(socket_poll::finish_sync);
+				return size;
+			}
+			core::expects_io<size_t> http2_session::read(connection* source, size_t size, socket_read_callback&& callback, bool queued)
+			{
+				size_t offset = 0;
+				while (size > 0)
+				{
+					core::string data;
+					core::umutex<std::recursive_mutex> unique(section);
+					auto* target = find_channel(source->http2_id);
+					if (!target || target->reading || (target->request.empty() && target->remote_closed))
+					{
+						unique.unlock();
+						callback(socket_poll::reset, nullptr, 0);
+						return std::make_error_condition(std::errc::connection_reset);
+					}
+					else if (target->request.empty())
+					{
+						target->read_callback = std::move(callback);
+						target->read_size = size;
+						target->reading = true;
+						return std::make_error_condition(std::errc::operation_would_block);
+					}
+
+					if (size >= target->request.size())
+					{
+						data = std::move(target->request);
+						target->request.clear();
+					}
+					else
+					{
+						data.assign(target->request.data(), size);
+						target->request.erase(0, size);
+					}
+
+					if (target->request.empty() && target->credit > 0)
+					{
+						receive_window += (int64_t)target->credit;
+						push_window_update(0, target->credit);
+						if (!target->remote_closed)
+						{
+							target->receive_window += (int64_t)target->credit;
+							push_window_update(target->id, target->credit);
+						}
+
+						target->credit = 0;
+						transmit();
+					}
+
+					unique.unlock();
+					size -= data.size();
+					offset += data.size();
+					if (!callback(socket_poll::next, (uint8_t*)data.data(), data.size()))
+						break;
+				}
+
+				callback(queued ? socket_poll::finish : socket_poll::finish_sync, nullptr, 0);
+				return offset;
+			}
+			void http2_session::finish(connection* source)
+			{
+				core::umutex<std::recursive_mutex> unique(section);
+				auto* target = find_channel(source->http2_id);
+				if (target != nullptr)
+				{
+					target->base = nullptr;
+					target->read_callback = nullptr;
+					target->write_callback = nullptr;
+					target->reading = false;
+					target->writing = false;
+					if (finish_response(target))
+					{
+						target->add_ref();
+						pump(target);
+						target->release();
+					}
+					else
+						reset_channel(target, error_code::internal_error);
+				}
+
+				unique.unlock();
+				source->info.finish = network::utils::clock();
+				source->root->on_request_close(source);
+				source->http2 = nullptr;
+				source->http2_id = 0;
+
+				unique.lock();
+				if (!closed)
+				{
+					source->reset(true);
+					streams.push_back(source);
+				}
+				else
+					core::memory::release(source);
+				unique.unlock();
+				release();
+			}
+			http2_session::channel* http2_session::find_channel(uint32_t id)
+			{
+				auto it = channels.find(id);
+				return it != channels.end() ? it->second : nullptr;
+			}
+			bool http2_session::translate_request(const hpack_codec::header_list& headers, bool end_stream, request_frame* request, parser* resolver, int64_t* content_length, bool* chunked)
+			{
+				std::string_view method, scheme, authority, path;
+				bool regular = false, host = false;
+				*content_length = -1;
+				resolver->prepare_for_request_parsing(request);
+				for (auto& item : headers)
+				{
+					auto& name = item.first;
+					auto& value = item.second;
+					if (name.empty() || name.find_first_of(std::string_view("\r\n\0 :ABCDEFGHIJKLMNOPQRSTUVWXYZ", 31), name.front() == ':' ? 1 : 0) != core::string::npos || value.find_first_of(std::string_view("\r\n\0", 3)) != core::string::npos)
+						return false;
+
+					if (name.front() == ':')
+					{
+						if (regular)
+							return false;
+						else if (name == ":method")
+							method = value;
+						else if (name == ":scheme")
+							scheme = value;
+						else if (name == ":authority")
+							authority = value;
+						else if (name == ":path")
+							path = value;
+						else
+							return false;
+						continue;
+					}
+
+					regular = true;
+					if (name == "connection" || name == "keep-alive" || name == "proxy-connection" || name == "transfer-encoding" || name == "upgrade")
+						return false;
+
+					if (name == "te")
+					{
+						if (value != "trailers")
+							return false;
+						continue;
+					}
+
+					if (name == "content-length")
+					{
+						if (value.empty() || value.size() > 18 || value.find_first_not_of("0123456789") != core::string::npos)
+							return false;
+
+						int64_t size = (int64_t)strtoull(value.c_str(), nullptr, 10);
+						if (*content_length >= 0 && *content_length != size)
+							return false;
+						else if (*content_length >= 0)
+							continue;
+
+						*content_length = size;
+					}
+
+					host = host || name == "host";
+					parsing::parse_header_field(resolver, (uint8_t*)name.data(), name.size());
+					parsing::parse_header_value(resolver, (uint8_t*)value.data(), value.size());
+				}
+
+				if (method.empty() || scheme.empty() || path.empty() || method.find(' ') != std::string::npos || path.find(' ') != std::string::npos || (path.front() != '/' && path != "*"))
+					return false;
+
+				size_t query = std::min(path.find('?'), path.size());
+				parsing::parse_method_value(resolver, (uint8_t*)method.data(), method.size());
+				parsing::parse_path_value(resolver, (uint8_t*)path.data(), query);
+				if (query + 1 < path.size())
+					parsing::parse_query_value(resolver, (uint8_t*)path.data() + query + 1, path.size() - query - 1);
+
+				request->set_version(2, 0);
+				if (!host && !authority.empty())
+				{
+					parsing::parse_header_field(resolver, (uint8_t*)"Host", 4);
+					parsing::parse_header_value(resolver, (uint8_t*)authority.data(), authority.size());
+				}
+
+				*chunked = !end_stream && *content_length < 0;
+				if (*chunked)
+				{
+					parsing::parse_header_field(resolver, (uint8_t*)"Transfer-Encoding", 17);
+					parsing::parse_header_value(resolver, (uint8_t*)"chunked", 7);
+				}
+
+				return true;
+			}
+			int http2_session::translate_response(const std::string_view& head, hpack_codec::header_list& headers, int64_t* content_length, bool* chunked)
+			{
+				size_t offset = head.find("\r\n");
+				size_t status = head.find(' ');
+				if (offset == std::string::npos || status == std::string::npos || status > offset)
+					return -1;
+
+				int status_code = (int)strtol(head.data() + status + 1, nullptr, 10);
+				headers.emplace_back(":status", core::to_string(status_code));
+				*content_length = -1;
+				*chunked = false;
+
+				for (offset += 2; offset < head.size();)
+				{
+					size_t end = std::min(head.find("\r\n", offset), head.size());
+					if (end == offset)
+						break;
+
+					size_t split = head.find(':', offset);
+					if (split == std::string::npos || split == offset || split > end)
+						return -1;
+
+					core::string name = core::string(head.substr(offset, split - offset));
+					std::string_view value = head.substr(split + 1, end - split - 1);
+					while (!value.empty() && (value.front() == ' ' || value.front() == '\t'))
+						value.remove_prefix(1);
+					while (!value.empty() && (value.back() == ' ' || value.back() == '\t'))
+						value.remove_suffix(1);
+
+					offset = end + 2;
+					core::stringify::to_lower(name);
+					if (name == "transfer-encoding")
+						*chunked = *chunked || core::stringify::case_equals(value, "chunked");
+					else if (name == "connection" || name == "keep-alive" || name == "proxy-connection" || name == "upgrade")
+						continue;
+					else if (name == "content-length")
+						*content_length = (int64_t)strtoull(core::string(value).c_str(), nullptr, 10);
+					else
+						headers.emplace_back(std::move(name), core::string(value));
+				}
+
+				if (!*chunked && *content_length >= 0)
+					headers.emplace_back("content-length", core::to_string(*content_length));
+				else
+					*content_length = -1;
+
+				return status_code;
+			}
+
+			hrm_cache::hrm_cache() noexcept : hrm_cache(HTTP_HRM_SIZE)
+			{
+			}
+			hrm_cache::hrm_cache(size_t max_bytes_storage) noexcept : capacity(max_bytes_storage), size(0)
+			{
+			}
+			hrm_cache::~hrm_cache() noexcept
+			{
+				size = capacity = 0;
+				while (!queue.empty())
+				{
+					auto* item = queue.front();
+					core::memory::deinit(item);
+					queue.pop();
+				}
+			}
+			void hrm_cache::shrink_to_fit() noexcept
+			{
+				size_t freed = 0;
+				while (!queue.empty() && size > capacity)
+				{
+					auto* item = queue.front();
+					size_t bytes = item->capacity();
+					size -= std::min<size_t>(size, bytes);
+					freed += bytes;
+					core::memory::deinit(item);
+					queue.pop();
+				}
+				if (freed > 0)
+					VI_DEBUG("[http] freed up %" PRIu64 " bytes from hrm cache", (uint64_t)freed);
+			}
+			void hrm_cache::shrink() noexcept
+			{
+				core::umutex<std::mutex> unique(mutex);
+				shrink_to_fit();
+			}
+			void hrm_cache::rescale(size_t max_bytes_storage) noexcept
+			{
+				core::umutex<std::mutex> unique(mutex);
+				capacity = max_bytes_storage;
+				shrink_to_fit();
+			}
+			void hrm_cache::push(core::string* entry)
+			{
+				entry->clear();
+				core::umutex<std::mutex> unique(mutex);
+				size += entry->capacity();
+				queue.push(entry);
+				shrink_to_fit();
+			}
+			core::string* hrm_cache::pop() noexcept
+			{
+				core::umutex<std::mutex> unique(mutex);
+				if (queue.empty())
+					return core::memory::init<core::string>();
+
+				auto* item = queue.front();
 				size -= std::min<size_t>(size, item->capacity());
 				queue.pop();
 				return item;
 			}
 
+			compression_cache::blob::~blob() noexcept
+			{
+				if (temporary && !path.empty())
+					core::os::file::remove(path);
+			}
+
+			compression_cache::compression_cache() noexcept : compression_cache(HTTP_COMPRESSION_CACHE_SIZE, HTTP_COMPRESSION_MEMORY_SIZE)
+			{
+			}
+			compression_cache::compression_cache(size_t max_bytes_storage, size_t max_bytes_in_memory) noexcept : capacity(max_bytes_storage), threshold(max_bytes_in_memory), size(0)
+			{
+			}
+			compression_cache::~compression_cache() noexcept
+			{
+				clear();
+			}
+			void compression_cache::shrink_to_fit() noexcept
+			{
+				size_t freed = 0;
+				while (!order.empty() && size > capacity)
+				{
+					auto& item = order.back();
+					size -= std::min<size_t>(size, item.content->size);
+					freed += item.content->size;
+					entries.erase(item.key);
+					core::memory::release(item.content);
+					order.pop_back();
+				}
+				if (freed > 0)
+					VI_DEBUG("[http] freed up %" PRIu64 " bytes from compression cache", (uint64_t)freed);
+			}
+			void compression_cache::rescale(size_t max_bytes_storage, size_t max_bytes_in_memory) noexcept
+			{
+				core::umutex<std::mutex> unique(mutex);
+				capacity = max_bytes_storage;
+				threshold = max_bytes_in_memory;
+				shrink_to_fit();
+			}
+			void compression_cache::clear() noexcept
+			{
+				core::umutex<std::mutex> unique(mutex);
+				for (auto& item : order)
+					core::memory::release(item.content);
+				order.clear();
+				entries.clear();
+				routes.clear();
+				pending.clear();
+				size = 0;
+			}
+			compression_cache::blob* compression_cache::fetch(router_entry* route, const std::string_view& key)
+			{
+				core::umutex<std::mutex> unique(mutex);
+				auto& stats = routes[route];
+				auto it = entries.find(core::key_lookup_cast(key));
+				if (it == entries.end())
+				{
+					++stats.misses;
+					return nullptr;
+				}
+
+				++stats.hits;
+				order.splice(order.begin(), order, it->second);
+				auto* content = it->second->content;
+				content->add_ref();
+				return content;
+			}
+			compression_cache::blob* compression_cache::store(const std::string_view& key, const std::string_view& temporary_directory, core::string&& data)
+			{
+				size_t max_bytes_in_memory;
+				{
+					core::umutex<std::mutex> unique(mutex);
+					max_bytes_in_memory = threshold;
+				}
+
+				auto* content = new blob();
+				content->size = data.size();
+
+				bool cacheable = is_cacheable(content->size);
+				if (cacheable && content->size > max_bytes_in_memory && !temporary_directory.empty())
+				{
+					core::string path = core::string(temporary_directory);
+					if (path.back() != '/' && path.back() != '\\')
+						path.append(1, VI_SPLITTER);
+
+					auto random = compute::crypto::random_bytes(16);
+					if (random)
+					{
+						auto hash = compute::crypto::hash_hex(compute::digests::MD5(), *random);
+						if (hash)
+							path.append(*hash).append(".z");
+					}
+
+					auto file = core::os::file::open(path.c_str(), "wb");
+					if (file)
+					{
+						bool written = fwrite(data.data(), 1, data.size(), *file) == data.size();
+						core::os::file::close(*file);
+						if (written)
+						{
+							content->path = std::move(path);
+							content->temporary = true;
+						}
+						else
+							core::os::file::remove(path);
+					}
+				}
+
+				if (content->path.empty())
+					content->data = std::move(data);
+
+				core::umutex<std::mutex> unique(mutex);
+				auto reservation = pending.find(core::key_lookup_cast(key));
+				if (reservation != pending.end())
+					pending.erase(reservation);
+
+				if (!cacheable)
+					return content;
+
+				auto it = entries.find(core::key_lookup_cast(key));
+				if (it != entries.end())
+				{
+					size -= std::min<size_t>(size, it->second->content->size);
+					core::memory::release(it->second->content);
+					order.erase(it->second);
+					entries.erase(it);
+				}
+
+				content->add_ref();
+				order.push_front({ core::string(key), content });
+				entries[order.front().key] = order.begin();
+				size += content->size;
+				shrink_to_fit();
+				return content;
+			}
+			bool compression_cache::reserve(const std::string_view& key)
+			{
+				core::umutex<std::mutex> unique(mutex);
+				return pending.emplace(core::string(key)).second;
+			}
+			void compression_cache::unreserve(const std::string_view& key)
+			{
+				core::umutex<std::mutex> unique(mutex);
+				auto it = pending.find(core::key_lookup_cast(key));
+				if (it != pending.end())
+					pending.erase(it);
+			}
+			compression_cache::statistics compression_cache::get_statistics(router_entry* route)
+			{
+				core::umutex<std::mutex> unique(mutex);
+				auto it = routes.find(route);
+				return it != routes.end() ? it->second : statistics();
+			}
+			size_t compression_cache::get_size()
+			{
+				core::umutex<std::mutex> unique(mutex);
+				return size;
+			}
+			bool compression_cache::is_cacheable(size_t content_length)
+			{
+				core::umutex<std::mutex> unique(mutex);
+				return content_length > 0 && content_length <= capacity / 4;
+			}
+
+			file_cache::handle::~handle() noexcept
+			{
+				if (stream != nullptr)
+					core::os::file::close(stream);
+			}
+
+			file_cache::~file_cache() noexcept
+			{
+				clear();
+			}
+			void file_cache::erase(storage& target, core::linked_list<entry>::iterator it) noexcept
+			{
+				target.entries.erase(it->key);
+				core::memory::release(it->content);
+				target.order.erase(it);
+			}
+			void file_cache::clear() noexcept
+			{
+				core::umutex<std::mutex> unique(mutex);
+				for (auto& target : routes)
+				{
+					for (auto& item : target.second.order)
+						core::memory::release(item.content);
+				}
+				routes.clear();
+			}
+			void file_cache::clear(router_entry* route) noexcept
+			{
+				core::umutex<std::mutex> unique(mutex);
+				auto target = routes.find(route);
+				if (target == routes.end())
+					return;
+
+				for (auto& item : target->second.order)
+					core::memory::release(item.content);
+				routes.erase(target);
+			}
+			file_cache::handle* file_cache::fetch(router_entry* route, const std::string_view& key)
+			{
+				VI_ASSERT(route != nullptr, "route should be set");
+				if (!route->file_cache_size)
+					return nullptr;
+
+				auto time = core::schedule::get_clock();
+				handle* content = nullptr;
+				{
+					core::umutex<std::mutex> unique(mutex);
+					auto target = routes.find(route);
+					if (target == routes.end())
+						return nullptr;
+
+					auto it = target->second.entries.find(core::key_lookup_cast(key));
+					if (it == target->second.entries.end())
+						return nullptr;
+
+					target->second.order.splice(target->second.order.begin(), target->second.order, it->second);
+					content = it->second->content;
+					content->add_ref();
+					if (time - content->validated < std::chrono::milliseconds(route->file_cache_ttl))
+						return content;
+				}
+
+				core::file_entry state;
+				bool valid = core::os::file::get_state(content->path, &state) && state.is_exists && !state.is_directory && state.size == content->resource.size && state.last_modified == content->resource.last_modified;
+				core::umutex<std::mutex> unique(mutex);
+				if (valid)
+				{
+					content->validated = time;
+					return content;
+				}
+
+				auto target = routes.find(route);
+				if (target != routes.end())
+				{
+					auto it = target->second.entries.find(core::key_lookup_cast(key));
+					if (it != target->second.entries.end() && it->second->content == content)
+						erase(target->second, it->second);
+				}
+
+				core::memory::release(content);
+				return nullptr;
+			}
+			file_cache::handle* file_cache::store(router_entry* route, const std::string_view& key, connection* base)
+			{
+				VI_ASSERT(route != nullptr, "route should be set");
+				VI_ASSERT(base != nullptr, "connection should be set");
+				if (!route->file_cache_size || !base->resource.is_exists || base->resource.is_directory || base->resource.is_referenced)
+					return nullptr;
+
+				auto file = core::os::file::open(base->request.path.c_str(), "rb");
+				if (!file)
+					return nullptr;
+
+				char etag[64];
+				auto* content = new handle();
+				content->stream = *file;
+				content->resource = base->resource;
+				content->path = base->request.path;
+				content->content_type = utils::content_type(content->path, &route->mime_types);
+				content->validated = core::schedule::get_clock();
+				core::os::net::get_etag(etag, sizeof(etag), &content->resource);
+				content->etag.assign(etag, strnlen(etag, sizeof(etag)));
+
+				core::umutex<std::mutex> unique(mutex);
+				auto& target = routes[route];
+				auto it = target.entries.find(core::key_lookup_cast(key));
+				if (it != target.entries.end())
+					erase(target, it->second);
+
+				content->add_ref();
+				target.order.push_front({ core::string(key), content });
+				target.entries[target.order.front().key] = target.order.begin();
+				while (target.order.size() > route->file_cache_size)
+					erase(target, std::prev(target.order.end()));
+
+				return content;
+			}
+			size_t file_cache::get_size(router_entry* route)
+			{
+				core::umutex<std::mutex> unique(mutex);
+				auto target = routes.find(route);
+				return target != routes.end() ? target->second.order.size() : 0;
+			}
+
 			void utils::update_keep_alive_headers(connection* base, core::string& content)
 			{
 				VI_ASSERT(connection_valid(base), "connection should be valid");
@@ -3935,9 +6133,9 @@ namespace vitex
 				}
 
 				auto connection = base->request.get_header("Connection");
-				if ((!connection.empty() && !core::stringify::case_equals(connection, "keep-alive")) || (connection.empty() && strcmp(base->request.version, "1.1") != 0))
+				if ((!connection.empty() && !core::stringify::case_equals(connection, "keep-alive")) || (connection.empty() && strcmp(base->request.version, "HTTP/1.1") != 0))
 				{
-					base->info.reuses = 1;
+					base->info.reuses = 0;
 					content.append("Connection: close\r\n");
 					return;
 				}
@@ -4399,29 +6597,17 @@ namespace vitex
 						else if (location.front() != '/')
 							location.insert(location.begin(), '/');
 
-						for (auto* next : group->routes)
-						{
-							VI_ASSERT(next != nullptr, "route should be set");
-							if (compute::regex::match(&next->location, base->request.match, location))
-							{
-								base->route = next;
-								return true;
-							}
-						}
+						base->route = group->find(base->request.match, location);
+						if (base->route != nullptr)
+							return true;
 
 						location.assign(base->request.referrer);
 					}
 					else
 					{
-						for (auto* next : group->routes)
-						{
-							VI_ASSERT(next != nullptr, "route should be set");
-							if (compute::regex::match(&next->location, base->request.match, location))
-							{
-								base->route = next;
-								return true;
-							}
-						}
+						base->route = group->find(base->request.match, location);
+						if (base->route != nullptr)
+							return true;
 					}
 				}
 
@@ -4608,6 +6794,7 @@ namespace vitex
 				if (!length || parser->message.header.empty())
 					return true;
 
+				arena_scope scope(parser->message.arena);
 				if (core::stringify::case_equals(parser->message.header.c_str(), "cookie"))
 				{
 					if (!parser->message.cookies)
@@ -4906,7 +7093,7 @@ namespace vitex
 
 				auto if_modified_since = base->request.get_header("If-Modified-Since");
 				if (if_modified_since.empty())
-					return false;
+					return true;
 
 				return resource->last_modified > core::date_time::seconds_from_serialized(if_modified_since, core::date_time::format_web_time());
 
@@ -4934,6 +7121,78 @@ namespace vitex
 				return false;
 #endif
 			}
+			compression_cache::blob* resources::resource_precompressed(connection* base, bool gzip, const std::string_view& etag)
+			{
+#ifdef VI_ZLIB
+				VI_ASSERT(connection_valid(base), "connection should be valid");
+				VI_MEASURE(core::timings::file_system);
+				auto* route = base->route;
+				if (base->resource.is_referenced)
+					return nullptr;
+
+				if (gzip && route->compression.precompressed)
+				{
+					core::string path = base->request.path + ".gz";
+					auto sidecar = core::os::file::get_state(path);
+					if (sidecar && sidecar->is_exists && !sidecar->is_directory && sidecar->last_modified >= base->resource.last_modified)
+					{
+						auto* content = new compression_cache::blob();
+						content->path = std::move(path);
+						content->size = sidecar->size;
+						return content;
+					}
+				}
+
+				auto* cache = compression_cache::get();
+				if (!route->compression.cache || !cache->is_cacheable(base->resource.size))
+					return nullptr;
+
+				core::string key = base->request.path;
+				key.append(1, '\0').append(etag);
+				key.append(1, '\0').append(gzip ? "gzip" : "deflate");
+				key.append(1, '\0').append(core::to_string(route->compression.quality_level));
+
+				auto* content = cache->fetch(route, key);
+				if (content != nullptr || !cache->reserve(key))
+					return content;
+
+				core::string path = base->request.path;
+				core::string directory = route->router ? route->router->temporary_directory : core::string();
+				int quality_level = route->compression.quality_level;
+				int memory_level = route->compression.memory_level;
+				int tune = (int)route->compression.tune;
+				core::cospawn([cache, key = std::move(key), path = std::move(path), directory = std::move(directory), quality_level, memory_level, tune, gzip]() mutable
+				{
+					VI_MEASURE(core::timings::file_system);
+					auto data = core::os::file::read_as_string(path);
+					if (!data || data->empty())
+						return cache->unreserve(key);
+
+					z_stream zstream;
+					zstream.zalloc = Z_NULL;
+					zstream.zfree = Z_NULL;
+					zstream.opaque = Z_NULL;
+					if (deflateInit2(&zstream, quality_level, Z_DEFLATED, (gzip ? MAX_WBITS + 16 : MAX_WBITS), memory_level, tune) != Z_OK)
+						return cache->unreserve(key);
+
+					core::string buffer((size_t)deflateBound(&zstream, (uLong)data->size()), '\0');
+					zstream.avail_in = (uInt)data->size();
+					zstream.next_in = (Bytef*)data->data();
+					zstream.avail_out = (uInt)buffer.size();
+					zstream.next_out = (Bytef*)buffer.data();
+					bool compress = (deflate(&zstream, Z_FINISH) == Z_STREAM_END);
+					bool flush = (deflateEnd(&zstream) == Z_OK);
+					if (!compress || !flush)
+						return cache->unreserve(key);
+
+					buffer.resize((size_t)zstream.total_out);
+					core::memory::release(cache->store(key, directory, std::move(buffer)));
+				});
+				return nullptr;
+#else
+				return nullptr;
+#endif
+			}
 
 			bool routing::route_web_socket(connection* base)
 			{
@@ -4971,6 +7230,25 @@ namespace vitex
 			bool routing::route_get(connection* base)
 			{
 				VI_ASSERT(connection_valid(base), "connection should be valid");
+				core::string key;
+				if (base->route->file_cache_size > 0 && !base->route->files_directory.empty() && !permissions::web_socket_upgrade_allowed(base) && !resources::resource_hidden(base, nullptr))
+				{
+					auto* cached = file_cache::get()->fetch(base->route, base->request.path);
+					if (cached != nullptr)
+					{
+						base->request.path.assign(cached->path);
+						base->resource = cached->resource;
+						if (base->route->static_file_max_age > 0 && !resources::resource_modified(base, &base->resource))
+						{
+							core::memory::release(cached);
+							return logical::process_resource_cache(base);
+						}
+
+						return logical::process_resource(base, cached);
+					}
+					key = base->request.path;
+				}
+
 				if (base->route->files_directory.empty() || !core::os::file::get_state(base->request.path, &base->resource))
 				{
 					if (permissions::web_socket_upgrade_allowed(base))
@@ -5000,6 +7278,9 @@ namespace vitex
 				if (base->route->static_file_max_age > 0 && !resources::resource_modified(base, &base->resource))
 					return logical::process_resource_cache(base);
 
+				if (!key.empty())
+					return logical::process_resource(base, file_cache::get()->store(base->route, key, base));
+
 				return logical::process_resource(base);
 			}
 			bool routing::route_post(connection* base)
@@ -5073,7 +7354,7 @@ namespace vitex
 							base->route->callbacks.headers(base, *content);
 
 						content->append("\r\n", 2);
-						return !base->stream->write_queued((uint8_t*)content->c_str(), content->size(), [content, base](socket_poll event)
+						return !base->write_queued((uint8_t*)content->c_str(), content->size(), [content, base](socket_poll event)
 						{
 							hrm_cache::get()->push(content);
 							if (packet::is_done(event))
@@ -5118,7 +7399,7 @@ namespace vitex
 					base->route->callbacks.headers(base, *content);
 
 				content->append("\r\n", 2);
-				return !!base->stream->write_queued((uint8_t*)content->c_str(), content->size(), [content, base](socket_poll event)
+				return !!base->write_queued((uint8_t*)content->c_str(), content->size(), [content, base](socket_poll event)
 				{
 					hrm_cache::get()->push(content);
 					if (packet::is_done(event))
@@ -5156,7 +7437,7 @@ namespace vitex
 					base->route->callbacks.headers(base, *content);
 
 				content->append("\r\n", 2);
-				return !!base->stream->write_queued((uint8_t*)content->c_str(), content->size(), [content, base](socket_poll event)
+				return !!base->write_queued((uint8_t*)content->c_str(), content->size(), [content, base](socket_poll event)
 				{
 					hrm_cache::get()->push(content);
 					if (packet::is_done(event))
@@ -5181,7 +7462,7 @@ namespace vitex
 					base->route->callbacks.headers(base, *content);
 
 				content->append("\r\n", 2);
-				return !!base->stream->write_queued((uint8_t*)content->c_str(), content->size(), [content, base](socket_poll event)
+				return !!base->write_queued((uint8_t*)content->c_str(), content->size(), [content, base](socket_poll event)
 				{
 					hrm_cache::get()->push(content);
 					if (packet::is_done(event))
@@ -5326,30 +7607,24 @@ namespace vitex
 				}
 #endif
 				content->append("Content-Length: ").append(core::to_string(base->response.content.data.size())).append("\r\n\r\n");
-				return !!base->stream->write_queued((uint8_t*)content->c_str(), content->size(), [content, base](socket_poll event)
+				socket_buffer buffers[2];
+				buffers[0].data = (uint8_t*)content->c_str();
+				buffers[0].size = content->size();
+				buffers[1].data = (uint8_t*)base->response.content.data.data();
+				buffers[1].size = memcmp(base->request.method, "HEAD", 4) != 0 ? base->response.content.data.size() : 0;
+				return !!base->write_vectored_queued(buffers, buffers[1].size > 0 ? 2 : 1, [content, base](socket_poll event)
 				{
 					hrm_cache::get()->push(content);
 					if (packet::is_done(event))
-					{
-						if (memcmp(base->request.method, "HEAD", 4) == 0)
-							return (void)base->next(200);
-
-						base->stream->write_queued((uint8_t*)base->response.content.data.data(), base->response.content.data.size(), [base](socket_poll event)
-						{
-							if (packet::is_done(event))
-								base->next(200);
-							else if (packet::is_error(event))
-								base->abort();
-						}, false);
-					}
+						base->next(200);
 					else if (packet::is_error(event))
 						base->abort();
-				}, false);
+				});
 			}
-			bool logical::process_resource(connection* base)
+			bool logical::process_resource(connection* base, file_cache::handle* cached)
 			{
 				VI_ASSERT(connection_valid(base), "connection should be valid");
-				auto content_type = utils::content_type(base->request.path, &base->route->mime_types);
+				auto content_type = (cached != nullptr ? std::string_view(cached->content_type) : utils::content_type(base->request.path, &base->route->mime_types));
 				auto range = base->request.get_header("Range");
 				auto status_message = utils::status_message(base->response.status_code = (base->response.error && base->response.status_code > 0 ? base->response.status_code : 200));
 				int64_t range1 = 0, range2 = 0, count = 0;
@@ -5375,7 +7650,10 @@ namespace vitex
 						bool deflate = accept_encoding.find("deflate") != std::string::npos;
 						bool gzip = accept_encoding.find("gzip") != std::string::npos;
 						if (deflate || gzip)
+						{
+							core::memory::release(cached);
 							return process_resource_compress(base, deflate, gzip, content_range, (size_t)range1);
+						}
 					}
 				}
 #endif
@@ -5405,26 +7683,40 @@ namespace vitex
 				content->append(header_date(date, base->resource.last_modified));
 				content->append("\r\n");
 
-				core::os::net::get_etag(date, sizeof(date), &base->resource);
-				content->append("Etag: ").append(date, strnlen(date, sizeof(date))).append("\r\n");
+				if (cached != nullptr)
+					content->append("Etag: ").append(cached->etag).append("\r\n");
+				else
+				{
+					core::os::net::get_etag(date, sizeof(date), &base->resource);
+					content->append("Etag: ").append(date, strnlen(date, sizeof(date))).append("\r\n");
+				}
 				content->append("Content-Type: ").append(content_type).append("; charset=").append(base->route->char_set).append("\r\n");
 				content->append("Content-Length: ").append(core::to_string(content_length)).append("\r\n");
 				content->append(content_range).append("\r\n");
 
 				if (content_length > 0 && strcmp(base->request.method, "HEAD") != 0)
 				{
-					return !!base->stream->write_queued((uint8_t*)content->c_str(), content->size(), [content, base, content_length, range1](socket_poll event)
+					socket_buffer head;
+					head.data = (uint8_t*)content->c_str();
+					head.size = content->size();
+					return !!base->write_vectored_queued(&head, 1, [content, base, content_length, range1, cached](socket_poll event)
 					{
 						hrm_cache::get()->push(content);
 						if (packet::is_done(event))
-							core::cospawn([base, content_length, range1]() { logical::process_file(base, (size_t)content_length, (size_t)range1); });
+							core::cospawn([base, content_length, range1, cached]() { logical::process_file(base, (size_t)content_length, (size_t)range1, cached); });
 						else if (packet::is_error(event))
+						{
+							core::memory::release(cached);
 							base->abort();
-					}, false);
+						}
+						else if (packet::is_skip(event))
+							core::memory::release(cached);
+					}, true);
 				}
 				else
 				{
-					return !!base->stream->write_queued((uint8_t*)content->c_str(), content->size(), [content, base](socket_poll event)
+					core::memory::release(cached);
+					return !!base->write_queued((uint8_t*)content->c_str(), content->size(), [content, base](socket_poll event)
 					{
 						hrm_cache::get()->push(content);
 						if (packet::is_done(event))
@@ -5472,23 +7764,42 @@ namespace vitex
 				content->append("Etag: ").append(date, strnlen(date, sizeof(date))).append("\r\n");
 				content->append("Content-Type: ").append(content_type).append("; charset=").append(base->route->char_set).append("\r\n");
 				content->append("Content-Encoding: ").append(gzip ? "gzip" : "deflate").append("\r\n");
-				content->append("Transfer-Encoding: chunked\r\n");
+
+				auto* precompressed = (range > 0 || !content_range.empty() ? nullptr : resources::resource_precompressed(base, gzip, std::string_view(date, strnlen(date, sizeof(date)))));
+				if (precompressed != nullptr)
+					content->append("Content-Length: ").append(core::to_string(precompressed->size)).append("\r\n");
+				else
+					content->append("Transfer-Encoding: chunked\r\n");
 				content->append(content_range).append("\r\n");
 
 				if (content_length > 0 && strcmp(base->request.method, "HEAD") != 0)
 				{
-					return !!base->stream->write_queued((uint8_t*)content->c_str(), content->size(), [content, base, range, content_length, gzip](socket_poll event)
+					socket_buffer head;
+					head.data = (uint8_t*)content->c_str();
+					head.size = content->size();
+					return !!base->write_vectored_queued(&head, 1, [content, base, range, content_length, gzip, precompressed](socket_poll event)
 					{
 						hrm_cache::get()->push(content);
 						if (packet::is_done(event))
-							core::cospawn([base, range, content_length, gzip]() { logical::process_file_compress(base, (size_t)content_length, (size_t)range, gzip); });
+						{
+							if (precompressed != nullptr)
+								core::cospawn([base, precompressed]() { logical::process_file_precompressed(base, precompressed); });
+							else
+								core::cospawn([base, range, content_length, gzip]() { logical::process_file_compress(base, (size_t)content_length, (size_t)range, gzip); });
+						}
 						else if (packet::is_error(event))
+						{
+							core::memory::release(precompressed);
 							base->abort();
-					}, false);
+						}
+						else if (packet::is_skip(event))
+							core::memory::release(precompressed);
+					}, true);
 				}
 				else
 				{
-					return !!base->stream->write_queued((uint8_t*)content->c_str(), content->size(), [content, base](socket_poll event)
+					core::memory::release(precompressed);
+					return !!base->write_queued((uint8_t*)content->c_str(), content->size(), [content, base](socket_poll event)
 					{
 						hrm_cache::get()->push(content);
 						if (packet::is_done(event))
@@ -5519,7 +7830,7 @@ namespace vitex
 
 				core::os::net::get_etag(date, sizeof(date), &base->resource);
 				content->append("Etag: ").append(date, strnlen(date, sizeof(date))).append("\r\n\r\n");
-				return !!base->stream->write_queued((uint8_t*)content->c_str(), content->size(), [content, base](socket_poll event)
+				return !!base->write_queued((uint8_t*)content->c_str(), content->size(), [content, base](socket_poll event)
 				{
 					hrm_cache::get()->push(content);
 					if (packet::is_done(event))
@@ -5528,7 +7839,7 @@ namespace vitex
 						base->abort();
 				}, false);
 			}
-			bool logical::process_file(connection* base, size_t content_length, size_t range)
+			bool logical::process_file(connection* base, size_t content_length, size_t range, file_cache::handle* cached)
 			{
 				VI_ASSERT(connection_valid(base), "connection should be valid");
 				VI_MEASURE(core::timings::file_system);
@@ -5541,7 +7852,7 @@ namespace vitex
 
 					if (base->response.content.data.size() >= content_length)
 					{
-						return !!base->stream->write_queued((uint8_t*)base->response.content.data.data() + range, content_length, [base](socket_poll event)
+						return !!base->write_queued((uint8_t*)base->response.content.data.data() + range, content_length, [base](socket_poll event)
 						{
 							if (packet::is_done(event))
 								base->next();
@@ -5551,6 +7862,32 @@ namespace vitex
 					}
 				}
 
+				if (cached != nullptr && base->route->allow_send_file)
+				{
+					auto result = base->write_file_queued(cached->stream, range, content_length, [base, cached, content_length, range](socket_poll event)
+					{
+						if (packet::is_done(event))
+						{
+							core::memory::release(cached);
+							base->next();
+						}
+						else if (packet::is_error(event))
+						{
+							core::memory::release(cached);
+							auto file = core::os::file::open(base->request.path.c_str(), "rb");
+							if (file)
+								process_file_stream(base, *file, content_length, range);
+							else
+								base->abort();
+						}
+						else if (packet::is_skip(event))
+							core::memory::release(cached);
+					});
+					if (result || result.error() != std::errc::not_supported)
+						return true;
+				}
+
+				core::memory::release(cached);
 				auto file = core::os::file::open(base->request.path.c_str(), "rb");
 				if (!file)
 					return base->abort(500, "System denied to open resource stream.");
@@ -5558,7 +7895,7 @@ namespace vitex
 				FILE* stream = *file;
 				if (base->route->allow_send_file)
 				{
-					auto result = base->stream->write_file_queued(stream, range, content_length, [base, stream, content_length, range](socket_poll event)
+					auto result = base->write_file_queued(stream, range, content_length, [base, stream, content_length, range](socket_poll event)
 					{
 						if (packet::is_done(event))
 						{
@@ -5610,7 +7947,7 @@ namespace vitex
 					goto cleanup;
 
 				content_length -= read;
-				auto written = base->stream->write_queued(buffer, read, [base, stream, content_length](socket_poll event)
+				auto written = base->write_queued(buffer, read, [base, stream, content_length](socket_poll event)
 				{
 					if (packet::is_done_async(event))
 					{
@@ -5662,7 +7999,7 @@ namespace vitex
 								base->response.content.assign(std::string_view(buffer.c_str(), (size_t)zstream.total_out));
 						}
 #endif
-						return !!base->stream->write_queued((uint8_t*)base->response.content.data.data(), content_length, [base](socket_poll event)
+						return !!base->write_queued((uint8_t*)base->response.content.data.data(), content_length, [base](socket_poll event)
 						{
 							if (packet::is_done(event))
 								base->next();
@@ -5719,7 +8056,7 @@ namespace vitex
 					if (base->root->state != server_state::working)
 						return base->abort();
 
-					return !!base->stream->write_queued((uint8_t*)"0\r\n\r\n", 5, [base](socket_poll event)
+					return !!base->write_queued((uint8_t*)"0\r\n\r\n", 5, [base](socket_poll event)
 					{
 						if (packet::is_done(event))
 							base->next();
@@ -5755,7 +8092,7 @@ namespace vitex
 					read += sizeof(char) * 2;
 				}
 
-				auto written = base->stream->write_queued(buffer, read, [base, stream, zstream, content_length](socket_poll event)
+				auto written = base->write_queued(buffer, read, [base, stream, zstream, content_length](socket_poll event)
 				{
 					if (packet::is_done_async(event))
 					{
@@ -5789,6 +8126,67 @@ namespace vitex
 				return base->next();
 #endif
 			}
+			bool logical::process_file_precompressed(connection* base, compression_cache::blob* content)
+			{
+				VI_ASSERT(connection_valid(base), "connection should be valid");
+				VI_ASSERT(content != nullptr, "content should be set");
+				VI_MEASURE(core::timings::file_system);
+				if (content->path.empty())
+				{
+					return !!base->write_queued((uint8_t*)content->data.data(), content->data.size(), [base, content](socket_poll event)
+					{
+						if (packet::is_done(event))
+						{
+							core::memory::release(content);
+							base->next();
+						}
+						else if (packet::is_error(event))
+						{
+							core::memory::release(content);
+							base->abort();
+						}
+						else if (packet::is_skip(event))
+							core::memory::release(content);
+					}, false);
+				}
+
+				auto file = core::os::file::open(content->path.c_str(), "rb");
+				if (!file)
+				{
+					core::memory::release(content);
+					return base->abort(500, "System denied to open resource stream.");
+				}
+
+				FILE* stream = *file;
+				size_t content_length = content->size;
+				if (base->route->allow_send_file)
+				{
+					auto result = base->write_file_queued(stream, 0, content_length, [base, stream, content, content_length](socket_poll event)
+					{
+						if (packet::is_done(event))
+						{
+							core::os::file::close(stream);
+							core::memory::release(content);
+							base->next();
+						}
+						else if (packet::is_error(event))
+						{
+							core::memory::release(content);
+							process_file_stream(base, stream, content_length, 0);
+						}
+						else if (packet::is_skip(event))
+						{
+							core::os::file::close(stream);
+							core::memory::release(content);
+						}
+					});
+					if (result || result.error() != std::errc::not_supported)
+						return true;
+				}
+
+				core::memory::release(content);
+				return process_file_stream(base, stream, content_length, 0);
+			}
 			bool logical::process_web_socket(connection* base, const uint8_t* key, size_t key_size)
 			{
 				VI_ASSERT(connection_valid(base), "connection should be valid");
@@ -5865,6 +8263,7 @@ namespace vitex
 			server::server() : socket_server()
 			{
 				hrm_cache::link_instance();
+				compression_cache::link_instance();
 			}
 			server::~server()
 			{
@@ -5931,9 +8330,31 @@ namespace vitex
 
 				return core::expectation::met;
 			}
+			core::expects_io<void> server::next(socket_connection* target)
+			{
+				VI_ASSERT(target != nullptr, "connection should be set");
+				auto* base = (connection*)target;
+				if (!base->http2)
+					return socket_server::next(base);
+
+				base->http2->finish(base);
+				return core::expectation::met;
+			}
 			core::expects_system<void> server::on_configure(socket_router* new_router)
 			{
 				VI_ASSERT(new_router != nullptr, "router should be set");
+				auto* target = (map_router*)new_router;
+				target->http2.max_frame_size = std::min<size_t>(std::max<size_t>(target->http2.max_frame_size, HTTP2_MIN_FRAME_SIZE), HTTP2_MAX_FRAME_SIZE);
+				target->http2.initial_window_size = std::min<size_t>(target->http2.initial_window_size, HTTP2_MAX_WINDOW_SIZE);
+				target->http2.max_concurrent_streams = std::max<size_t>(target->http2.max_concurrent_streams, 1);
+				if (target->http2.enabled)
+				{
+					if (std::find(target->protocols.begin(), target->protocols.end(), "h2") == target->protocols.end())
+						target->protocols.insert(target->protocols.begin(), "h2");
+					if (std::find(target->protocols.begin(), target->protocols.end(), "http/1.1") == target->protocols.end())
+						target->protocols.push_back("http/1.1");
+				}
+
 				return update();
 			}
 			core::expects_system<void> server::on_unlisten()
@@ -5963,7 +8384,7 @@ namespace vitex
 				auto* base = (connection*)source;
 
 				base->resolver->prepare_for_request_parsing(&base->request);
-				base->stream->read_until_chunked_queued("\r\n\r\n", [base, conf](socket_poll event, const uint8_t* buffer, size_t size)
+				base->stream->read_until_chunked_queued("\r\n\r\n", [this, base, conf](socket_poll event, const uint8_t* buffer, size_t size)
 				{
 					if (packet::is_data(event))
 					{
@@ -5975,6 +8396,9 @@ namespace vitex
 							return false;
 						}
 
+						if (conf->http2.enabled && !memcmp(base->request.content.data.data(), "PRI", std::min<size_t>(3, base->request.content.data.size())))
+							return true;
+
 						int64_t offset = base->resolver->parse_request((uint8_t*)base->request.content.data.data(), base->request.content.data.size(), last_length);
 						if (offset >= 0 || offset == -2)
 							return true;
@@ -5984,89 +8408,29 @@ namespace vitex
 					}
 					else if (packet::is_done(event))
 					{
-						uint32_t redirects = 0;
-						base->info.start = network::utils::clock();
-						base->request.content.prepare(base->request.headers, buffer, size);
-					redirect:
-						if (!paths::construct_route(conf, base))
-							return base->abort(400, "Request cannot be resolved");
-
-						auto* route = base->route;
-						if (!route->redirect.empty())
-						{
-							if (redirects++ > HTTP_MAX_REDIRECTS)
-								return base->abort(500, "Infinite redirects loop detected");
-
-							base->request.location = route->redirect;
-							goto redirect;
-						}
-
-						paths::construct_path(base);
-						if (!permissions::method_allowed(base))
-							return base->abort(405, "Requested method \"%s\" is not allowed on this server", base->request.method);
-
-						if (!memcmp(base->request.method, "GET", 3) || !memcmp(base->request.method, "HEAD", 4))
-						{
-							if (!permissions::authorize(base))
-								return false;
-
-							if (route->callbacks.get && route->callbacks.get(base))
-								return true;
-
-							return routing::route_get(base);
-						}
-						else if (!memcmp(base->request.method, "POST", 4))
-						{
-							if (!permissions::authorize(base))
-								return false;
-
-							if (route->callbacks.post && route->callbacks.post(base))
-								return true;
-
-							return routing::route_post(base);
-						}
-						else if (!memcmp(base->request.method, "PUT", 3))
-						{
-							if (!permissions::authorize(base))
-								return false;
-
-							if (route->callbacks.put && route->callbacks.put(base))
-								return true;
-
-							return routing::route_put(base);
-						}
-						else if (!memcmp(base->request.method, "PATCH", 5))
+						if (conf->http2.enabled && base->request.content.data.size() >= 3 && !memcmp(base->request.content.data.data(), "PRI", 3))
 						{
-							if (!permissions::authorize(base))
-								return false;
+							if (std::string_view(base->request.content.data.data(), base->request.content.data.size()) != HTTP2_PREFACE || !base->stream->unread(buffer, size))
+								return base->abort(400, "Invalid connection preface was provided by client");
 
-							if (route->callbacks.patch && route->callbacks.patch(base))
-								return true;
-
-							return routing::route_patch(base);
+							auto* session = new http2_session(base);
+							session->start();
+							core::memory::release(session);
+							return true;
 						}
-						else if (!memcmp(base->request.method, "DELETE", 6))
-						{
-							if (!permissions::authorize(base))
-								return false;
 
-							if (route->callbacks.deinit && route->callbacks.deinit(base))
-								return true;
+						arena_reclaimer reclaimer(base);
+						base->info.start = network::utils::clock();
+						base->request.content.prepare(base->request.headers, buffer, size);
 
-							return routing::route_delete(base);
-						}
-						else if (!memcmp(base->request.method, "OPTIONS", 7))
+						auto& content = base->request.content;
+						if (content.limited && content.prefetch > content.length && base->stream->unread(buffer + content.length, content.prefetch - content.length))
 						{
-							if (route->callbacks.options && route->callbacks.options(base))
-								return true;
-
-							return routing::route_options(base);
+							content.data.resize(content.length);
+							content.offset = content.prefetch = content.length;
 						}
 
-						if (!permissions::authorize(base))
-							return false;
-
-						return base->abort(405, "Request method \"%s\" is not allowed", base->request.method);
+						return dispatch(base);
 					}
 					else if (packet::is_error(event))
 						base->abort();
@@ -6103,6 +8467,95 @@ namespace vitex
 					base->route->callbacks.access(base);
 				base->reset(false);
 			}
+			bool server::dispatch(connection* base)
+			{
+				VI_ASSERT(base != nullptr, "connection should be set");
+				auto* conf = (map_router*)router;
+				uint32_t redirects = 0;
+			redirect:
+				if (!paths::construct_route(conf, base))
+					return base->abort(400, "Request cannot be resolved");
+
+				auto* route = base->route;
+				if (!route->redirect.empty())
+				{
+					if (redirects++ > HTTP_MAX_REDIRECTS)
+						return base->abort(500, "Infinite redirects loop detected");
+
+					base->request.location = route->redirect;
+					goto redirect;
+				}
+
+				paths::construct_path(base);
+				if (has_route_callbacks(route))
+					base->stream->flush_staged_queued();
+
+				if (!permissions::method_allowed(base))
+					return base->abort(405, "Requested method \"%s\" is not allowed on this server", base->request.method);
+
+				if (!memcmp(base->request.method, "GET", 3) || !memcmp(base->request.method, "HEAD", 4))
+				{
+					if (!permissions::authorize(base))
+						return false;
+
+					if (route->callbacks.get && route->callbacks.get(base))
+						return true;
+
+					return routing::route_get(base);
+				}
+				else if (!memcmp(base->request.method, "POST", 4))
+				{
+					if (!permissions::authorize(base))
+						return false;
+
+					if (route->callbacks.post && route->callbacks.post(base))
+						return true;
+
+					return routing::route_post(base);
+				}
+				else if (!memcmp(base->request.method, "PUT", 3))
+				{
+					if (!permissions::authorize(base))
+						return false;
+
+					if (route->callbacks.put && route->callbacks.put(base))
+						return true;
+
+					return routing::route_put(base);
+				}
+				else if (!memcmp(base->request.method, "PATCH", 5))
+				{
+					if (!permissions::authorize(base))
+						return false;
+
+					if (route->callbacks.patch && route->callbacks.patch(base))
+						return true;
+
+					return routing::route_patch(base);
+				}
+				else if (!memcmp(base->request.method, "DELETE", 6))
+				{
+					if (!permissions::authorize(base))
+						return false;
+
+					if (route->callbacks.deinit && route->callbacks.deinit(base))
+						return true;
+
+					return routing::route_delete(base);
+				}
+				else if (!memcmp(base->request.method, "OPTIONS", 7))
+				{
+					if (route->callbacks.options && route->callbacks.options(base))
+						return true;
+
+					return routing::route_options(base);
+				}
+
+				if (!permissions::authorize(base))
+					return false;
+
+				return base->abort(405, "Request method \"%s\" is not allowed", base->request.method);
+			}
 			socket_connection* server::on_allocate(socket_listener* host)
 			{
 				VI_ASSERT(host != nullptr, "host should be set");
@@ -6110,6 +8563,11 @@ namespace vitex
 				auto* target = (map_router*)router;
 				base->route = target->base;
 				base->root = this;
+				if (target->request_arena_size > 0)
+				{
+					base->arena = core::memory::init<core::allocators::linear_allocator>(target->request_arena_size);
+					base->request.arena = base->arena;
+				}
 				return base;
 			}
 			socket_router* server::on_allocate_router()
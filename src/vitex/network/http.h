@@ -163,6 +163,10 @@ namespace vitex
 
 			class web_codec;
 
+			class hpack_codec;
+
+			class http2_session;
+
 			struct error_file
 			{
 				core::string pattern;
@@ -260,13 +264,14 @@ namespace vitex
 				core::string path;
 				core::string location;
 				core::string referrer;
+				core::local_allocator* arena;
 				char method[LABEL_SIZE];
 				char version[LABEL_SIZE];
 
 				request_frame();
-				request_frame(const request_frame&) = default;
+				request_frame(const request_frame& other);
 				request_frame(request_frame&&) noexcept = default;
-				request_frame& operator= (const request_frame&) = default;
+				request_frame& operator= (const request_frame& other);
 				request_frame& operator= (request_frame&&) noexcept = default;
 				void set_method(const std::string_view& value);
 				void set_version(uint32_t major, uint32_t minor);
@@ -410,6 +415,20 @@ namespace vitex
 
 			class router_group final : public core::reference<router_group>
 			{
+			private:
+				struct trie_node
+				{
+					core::string segment;
+					core::vector<size_t> children;
+					core::vector<size_t> routes;
+				};
+
+			private:
+				core::vector<trie_node> prefixes;
+				core::vector<trie_node> fragments;
+				core::vector<size_t> wildcards;
+				size_t indexed;
+
 			public:
 				core::string match;
 				core::vector<router_entry*> routes;
@@ -418,6 +437,13 @@ namespace vitex
 			public:
 				router_group(const std::string_view& new_match, route_mode new_mode) noexcept;
 				~router_group() noexcept;
+				void compile();
+				void invalidate();
+				router_entry* find(compute::regex_result& result, const std::string_view& location);
+
+			private:
+				static void insert(core::vector<trie_node>& nodes, const std::string_view& key, size_t index);
+				static void collect(const core::vector<trie_node>& nodes, const std::string_view& text, core::vector<size_t>& output);
 			};
 
 			class router_entry final : public core::reference<router_entry>
@@ -460,6 +486,8 @@ namespace vitex
 					size_t min_length = 16384;
 					int quality_level = 8;
 					int memory_level = 8;
+					bool precompressed = true;
+					bool cache = true;
 					bool enabled = false;
 				} compression;
 
@@ -480,11 +508,18 @@ namespace vitex
 				map_router* router = nullptr;
 				size_t web_socket_timeout = 30000;
 				size_t static_file_max_age = 604800;
+				size_t file_cache_size = 0;
+				size_t file_cache_ttl = 1000;
 				size_t level = 0;
 				bool allow_directory_listing = false;
 				bool allow_web_socket = false;
 				bool allow_send_file = true;
 
+			public:
+				router_entry() = default;
+				router_entry(const router_entry&) = default;
+				~router_entry() noexcept;
+
 			private:
 				static router_entry* from(const router_entry& other, const compute::regex_source& source);
 			};
@@ -509,6 +544,15 @@ namespace vitex
 					uint64_t expires = 604800;
 				} session;
 
+				struct router_http2
+				{
+					size_t max_concurrent_streams = 128;
+					size_t initial_window_size = 1024 * 1024;
+					size_t max_frame_size = 16384;
+					size_t header_table_size = 4096;
+					bool enabled = false;
+				} http2;
+
 				struct router_callbacks
 				{
 					std::function<void(map_router*)> on_destroy;
@@ -519,6 +563,7 @@ namespace vitex
 				core::string temporary_directory = "./temp";
 				core::vector<router_group*> groups;
 				size_t max_uploadable_resources = 10;
+				size_t request_arena_size = 0;
 				router_entry* base = nullptr;
 
 			public:
@@ -563,10 +608,13 @@ namespace vitex
 				request_frame request;
 				response_frame response;
 				core::file_entry resource;
+				core::allocators::linear_allocator* arena = nullptr;
 				parser* resolver = nullptr;
 				web_socket_frame* web_socket = nullptr;
+				http2_session* http2 = nullptr;
 				router_entry* route = nullptr;
 				server* root = nullptr;
+				uint32_t http2_id = 0;
 
 			public:
 				connection(server* source) noexcept;
@@ -579,13 +627,20 @@ namespace vitex
 				bool fetch(content_callback&& callback = nullptr, bool eat = false);
 				bool store(resource_callback&& callback = nullptr, bool eat = false);
 				bool skip(success_callback&& callback);
+				core::expects_io<size_t> write_queued(const uint8_t* buffer, size_t size, socket_written_callback&& callback, bool copy_buffer_when_async = true);
+				core::expects_io<size_t> write_vectored_queued(const socket_buffer* buffers, size_t count, socket_written_callback&& callback, bool more = false);
+				core::expects_io<size_t> write_file_queued(FILE* stream, size_t offset, size_t size, socket_written_callback&& callback);
+				core::expects_io<size_t> read_queued(size_t size, socket_read_callback&& callback);
 				core::expects_io<core::string> get_peer_ip_address() const;
+				size_t get_arena_allocations() const;
+				size_t get_arena_reservations() const;
 				bool is_skip_required() const;
 
 			private:
 				bool compose_response(bool apply_error_response, bool apply_body_inline, headers_callback&& callback);
 				bool error_response_requested();
 				bool body_inlining_requested();
+				bool pipelining_requested(size_t size);
 				bool waiting_for_web_socket();
 			};
 
@@ -694,6 +749,7 @@ namespace vitex
 					kimv_unordered_map* cookies = nullptr;
 					kimv_unordered_map* headers = nullptr;
 					content_frame* content = nullptr;
+					core::local_allocator* arena = nullptr;
 				} message;
 
 				struct chunked_state
@@ -790,6 +846,181 @@ namespace vitex
 				bool get_frame(web_socket_op* op, core::vector<char>* message);
 			};
 
+			class hpack_codec final : public core::reference<hpack_codec>
+			{
+			public:
+				typedef core::vector<std::pair<core::string, core::string>> header_list;
+
+			private:
+				struct table
+				{
+					core::vector<std::pair<core::string, core::string>> entries;
+					size_t size = 0;
+					size_t capacity = 4096;
+					size_t limit = 4096;
+				};
+
+			private:
+				table decoder;
+				table encoder;
+				bool resized;
+
+			public:
+				hpack_codec();
+				bool decode(const uint8_t* buffer, size_t size, size_t max_size, header_list& headers);
+				void encode(const header_list& headers, core::string& block);
+				void set_decoder_capacity(size_t capacity);
+				void set_encoder_capacity(size_t capacity);
+
+			private:
+				bool find_entry(size_t index, std::string_view* name, std::string_view* value) const;
+				size_t find_index(const std::string_view& name, const std::string_view& value, bool* exact) const;
+
+			private:
+				static void insert_entry(table& target, const std::string_view& name, const std::string_view& value);
+				static void evict_entries(table& target);
+				static bool decode_integer(const uint8_t*& buffer, const uint8_t* end, uint8_t prefix, size_t* value);
+				static bool decode_string(const uint8_t*& buffer, const uint8_t* end, core::string& value);
+				static bool decode_huffman(const uint8_t* buffer, size_t size, core::string& value);
+				static void encode_integer(core::string& block, uint8_t flags, uint8_t prefix, size_t value);
+				static void encode_string(core::string& block, const std::string_view& value);
+				static void encode_huffman(core::string& block, const std::string_view& value);
+			};
+
+			class http2_session final : public core::reference<http2_session>
+			{
+				friend connection;
+				friend server;
+
+			public:
+				enum class frame_type : uint8_t
+				{
+					data = 0,
+					headers = 1,
+					priority = 2,
+					rst_stream = 3,
+					settings = 4,
+					push_promise = 5,
+					ping = 6,
+					goaway = 7,
+					window_update = 8,
+					continuation = 9
+				};
+
+				enum class error_code : uint32_t
+				{
+					no_error = 0,
+					protocol_error = 1,
+					internal_error = 2,
+					flow_control_error = 3,
+					stream_closed = 5,
+					frame_size_error = 6,
+					refused_stream = 7,
+					cancel = 8,
+					compression_error = 9
+				};
+
+			private:
+				class channel final : public core::reference<channel>
+				{
+				public:
+					socket_read_callback read_callback;
+					socket_written_callback write_callback;
+					core::string request;
+					core::string head;
+					core::string body;
+					parser* resolver;
+					connection* base;
+					int64_t send_window;
+					int64_t receive_window;
+					int64_t content_length;
+					size_t received;
+					size_t credit;
+					size_t remaining;
+					size_t read_size;
+					uint32_t id;
+					bool chunked;
+					bool headless;
+					bool bounded;
+					bool streaming;
+					bool reading;
+					bool writing;
+					bool remote_closed;
+					bool local_closed;
+					bool headers_sent;
+					bool response_done;
+					bool closed;
+
+				public:
+					channel(uint32_t new_id);
+					~channel() noexcept;
+				};
+
+			private:
+				std::recursive_mutex section;
+				core::unordered_map<uint32_t, channel*> channels;
+				core::vector<connection*> streams;
+				core::string incoming;
+				core::string outgoing;
+				core::string block;
+				hpack_codec* codec;
+				connection* base;
+				map_router* router;
+				int64_t send_window;
+				int64_t receive_window;
+				int64_t initial_window_size;
+				size_t max_frame_size;
+				uint32_t last_stream_id;
+				uint32_t block_stream_id;
+				uint8_t block_flags;
+				bool preface;
+				bool receiving;
+				bool transmitting;
+				bool paused;
+				bool draining;
+				bool closed;
+
+			public:
+				http2_session(connection* new_base);
+				~http2_session() noexcept;
+				void start();
+
+			private:
+				void receive();
+				void transmit();
+				void resume();
+				void pump(channel* target);
+				void resume_read(channel* target);
+				void resume_write(channel* target);
+				void complete_channel(channel* target);
+				void reset_channel(channel* target, error_code code);
+				void close_channel(channel* target);
+				void push_frame(frame_type type, uint8_t flags, uint32_t id, const std::string_view& payload);
+				void push_headers(channel* target, const hpack_codec::header_list& headers, bool end_stream);
+				void push_reset(uint32_t id, error_code code);
+				void push_window_update(uint32_t id, size_t increment);
+				void teardown();
+				bool terminate(error_code code);
+				bool process_frames();
+				bool process_frame(frame_type type, uint8_t flags, uint32_t id, const uint8_t* payload, size_t size);
+				bool process_headers(uint32_t id, uint8_t flags, const uint8_t* payload, size_t size);
+				bool process_settings(uint8_t flags, uint32_t id, const uint8_t* payload, size_t size);
+				bool process_response(channel* target, const uint8_t* buffer, size_t size);
+				bool process_response_head(channel* target, const std::string_view& head);
+				bool process_response_body(channel* target, const uint8_t* buffer, size_t size);
+				bool open_channel(uint32_t id, uint8_t flags, const hpack_codec::header_list& headers);
+				bool finish_response(channel* target);
+				bool send_data(channel* target);
+				core::expects_io<size_t> write(connection* source, const socket_buffer* buffers, size_t count, socket_written_callback&& callback);
+				core::expects_io<size_t> read(connection* source, size_t size, socket_read_callback&& callback, bool queued);
+				void finish(connection* source);
+				channel* find_channel(uint32_t id);
+
+			public:
+				static bool translate_request(const hpack_codec::header_list& headers, bool end_stream, request_frame* request, parser* resolver, int64_t* content_length, bool* chunked);
+				static int translate_response(const std::string_view& head, hpack_codec::header_list& headers, int64_t* content_length, bool* chunked);
+			};
+
 			class hrm_cache final : public core::singleton<hrm_cache>
 			{
 			private:
@@ -811,6 +1042,111 @@ namespace vitex
 				void shrink_to_fit() noexcept;
 			};
 
+			class compression_cache final : public core::singleton<compression_cache>
+			{
+			public:
+				struct statistics
+				{
+					size_t hits = 0;
+					size_t misses = 0;
+				};
+
+				class blob final : public core::reference<blob>
+				{
+				public:
+					core::string data;
+					core::string path;
+					size_t size = 0;
+					bool temporary = false;
+
+				public:
+					blob() = default;
+					~blob() noexcept;
+				};
+
+			private:
+				struct entry
+				{
+					core::string key;
+					blob* content;
+				};
+
+			private:
+				std::mutex mutex;
+				core::linked_list<entry> order;
+				core::unordered_map<core::string, core::linked_list<entry>::iterator> entries;
+				core::unordered_map<router_entry*, statistics> routes;
+				core::unordered_set<core::string> pending;
+				size_t capacity;
+				size_t threshold;
+				size_t size;
+
+			public:
+				compression_cache() noexcept;
+				compression_cache(size_t max_bytes_storage, size_t max_bytes_in_memory) noexcept;
+				virtual ~compression_cache() noexcept override;
+				void rescale(size_t max_bytes_storage, size_t max_bytes_in_memory) noexcept;
+				void clear() noexcept;
+				blob* fetch(router_entry* route, const std::string_view& key);
+				blob* store(const std::string_view& key, const std::string_view& temporary_directory, core::string&& data);
+				bool reserve(const std::string_view& key);
+				void unreserve(const std::string_view& key);
+				statistics get_statistics(router_entry* route);
+				size_t get_size();
+				bool is_cacheable(size_t content_length);
+
+			private:
+				void shrink_to_fit() noexcept;
+			};
+
+			class file_cache final : public core::singleton<file_cache>
+			{
+			public:
+				class handle final : public core::reference<handle>
+				{
+				public:
+					core::file_entry resource;
+					core::string path;
+					core::string etag;
+					core::string content_type;
+					std::chrono::microseconds validated = std::chrono::microseconds(0);
+					FILE* stream = nullptr;
+
+				public:
+					handle() = default;
+					~handle() noexcept;
+				};
+
+			private:
+				struct entry
+				{
+					core::string key;
+					handle* content;
+				};
+
+				struct storage
+				{
+					core::linked_list<entry> order;
+					core::unordered_map<core::string, core::linked_list<entry>::iterator> entries;
+				};
+
+			private:
+				std::mutex mutex;
+				core::unordered_map<router_entry*, storage> routes;
+
+			public:
+				file_cache() noexcept = default;
+				virtual ~file_cache() noexcept override;
+				void clear() noexcept;
+				void clear(router_entry* route) noexcept;
+				handle* fetch(router_entry* route, const std::string_view& key);
+				handle* store(router_entry* route, const std::string_view& key, connection* base);
+				size_t get_size(router_entry* route);
+
+			private:
+				void erase(storage& target, core::linked_list<entry>::iterator it) noexcept;
+			};
+
 			class utils
 			{
 			public:
@@ -869,6 +1205,7 @@ namespace vitex
 				static bool resource_indexed(connection* base, core::file_entry* resource);
 				static bool resource_modified(connection* base, core::file_entry* resource);
 				static bool resource_compressed(connection* base, size_t size);
+				static compression_cache::blob* resource_precompressed(connection* base, bool gzip, const std::string_view& etag);
 			};
 
 			class routing
@@ -887,14 +1224,15 @@ namespace vitex
 			{
 			public:
 				static bool process_directory(connection* base);
-				static bool process_resource(connection* base);
+				static bool process_resource(connection* base, file_cache::handle* cached = nullptr);
 				static bool process_resource_compress(connection* base, bool deflate, bool gzip, const std::string_view& content_range, size_t range);
 				static bool process_resource_cache(connection* base);
-				static bool process_file(connection* base, size_t content_length, size_t range);
+				static bool process_file(connection* base, size_t content_length, size_t range, file_cache::handle* cached = nullptr);
 				static bool process_file_stream(connection* base, FILE* stream, size_t content_length, size_t range);
 				static bool process_file_chunk(connection* base, FILE* stream, size_t content_length);
 				static bool process_file_compress(connection* base, size_t content_length, size_t range, bool gzip);
 				static bool process_file_compress_chunk(connection* base, FILE* stream, void* cstream, size_t content_length);
+				static bool process_file_precompressed(connection* base, compression_cache::blob* content);
 				static bool process_web_socket(connection* base, const uint8_t* key, size_t key_size);
 			};
 
@@ -903,6 +1241,7 @@ namespace vitex
 				friend connection;
 				friend logical;
 				friend utils;
+				friend http2_session;
 
 			public:
 				server();
@@ -911,6 +1250,7 @@ namespace vitex
 
 			private:
 				core::expects_system<void> update_route(router_entry* route);
+				core::expects_io<void> next(socket_connection* base) override;
 				core::expects_system<void> on_configure(socket_router* init) override;
 				core::expects_system<void> on_unlisten() override;
 				void on_request_open(socket_connection* base) override;
@@ -919,6 +1259,7 @@ namespace vitex
 				void on_request_close(socket_connection* base) override;
 				socket_connection* on_allocate(socket_listener* host) override;
 				socket_router* on_allocate_router() override;
+				bool dispatch(connection* base);
 			};
 
 			class client final : public socket_client
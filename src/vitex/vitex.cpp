@@ -246,6 +246,7 @@ namespace vitex
 		VI_TRACE("[lib] free singleton instances");
 		layer::application::cleanup_instance();
 		network::http::hrm_cache::cleanup_instance();
+		network::http::compression_cache::cleanup_instance();
 		network::sqlite::driver::cleanup_instance();
 		network::pq::driver::cleanup_instance();
 		network::mongo::driver::cleanup_instance();